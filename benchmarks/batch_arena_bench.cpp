@@ -0,0 +1,198 @@
+#include "../include/pipeline/pipeline_manager.h"
+#include "../include/utils/csv_reader.h"
+#include "../include/utils/memory_usage.h"
+#include <atomic>
+#include <cstdlib>
+#include <stdlib.h>
+#include <iostream>
+#include <iomanip>
+#include <new>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+/**
+ * @file batch_arena_bench.cpp
+ * @brief Alocações e memória dos modos em lote com e sem a arena por lote
+ *
+ * Substitui o operator new global por uma versão que conta chamadas e bytes,
+ * e executa runParallelPartitioned e runStreaming sobre a coluna de texto do
+ * CSV (replicada) com PipelineConfig::use_batch_arena desligado e ligado.
+ * Para cada combinação reporta alocações do heap, bytes pedidos, tempo e o
+ * acréscimo de pico de memória residente.
+ *
+ * Uso: batch_arena_bench [arquivo.csv] [coluna] [réplicas] [workers]
+ */
+
+namespace {
+
+    std::atomic<uint64_t> heap_allocations{0};   ///< Chamadas ao operator new
+    std::atomic<uint64_t> heap_bytes{0};         ///< Bytes pedidos ao operator new
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    heap_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+// std::pmr::new_delete_resource (recurso padrão dos documentos) usa as versões alinhadas
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    heap_bytes.fetch_add(size, std::memory_order_relaxed);
+    std::size_t align = std::max(static_cast<std::size_t>(alignment), sizeof(void*));
+    void* pointer = nullptr;
+    if (posix_memalign(&pointer, align, size == 0 ? 1 : size) == 0) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+using namespace legal_doc_pipeline;
+
+namespace {
+
+    /**
+     * @brief Resultado de uma execução
+     */
+    struct RunStats {
+        bool success = false;
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+        double milliseconds = 0.0;
+        size_t peak_extra = 0;
+    };
+
+    RunStats measure(const std::vector<std::string>& corpus, int workers, bool use_arena, bool streaming) {
+        PipelineConfig config;
+        config.num_workers = workers;
+        config.use_batch_arena = use_arena;
+        pipeline::PipelineManager manager(config);
+
+        // Primeira execução aquece tokenizador, vocabulário e pool de threads
+        std::streambuf* original_buffer = std::cout.rdbuf(nullptr);
+        if (streaming) {
+            manager.runStreaming(corpus);
+        } else {
+            manager.runParallelPartitioned(corpus);
+        }
+
+        size_t before = utils::MemoryUsage::currentResidentBytes();
+        utils::MemoryUsage::resetPeak();
+        uint64_t allocations = heap_allocations.load();
+        uint64_t bytes = heap_bytes.load();
+        PipelineResult result = streaming ? manager.runStreaming(corpus) : manager.runParallelPartitioned(corpus);
+        RunStats stats;
+        stats.allocations = heap_allocations.load() - allocations;
+        stats.bytes = heap_bytes.load() - bytes;
+        size_t peak = utils::MemoryUsage::peakResidentBytes();
+        std::cout.rdbuf(original_buffer);
+        std::cout.clear();
+
+        stats.success = result.success;
+        stats.milliseconds = result.execution_time * 1000.0;
+        stats.peak_extra = peak > before ? peak - before : 0;
+        return stats;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string csv_file = argc > 1 ? argv[1] : "docs.csv";
+    std::string column = argc > 2 ? argv[2] : "Texto";
+    int replicas = argc > 3 ? std::max(1, std::atoi(argv[3])) : 5;
+    int workers = argc > 4 ? std::max(1, std::atoi(argv[4])) : 4;
+
+    utils::CsvReader csv_reader;
+    std::streambuf* original_buffer = std::cout.rdbuf(nullptr);
+    std::vector<std::string> documents = csv_reader.readColumn(csv_file, column);
+    std::cout.rdbuf(original_buffer);
+    std::cout.clear();
+
+    if (documents.empty()) {
+        std::cerr << "Erro: nenhum documento lido de '" << csv_file << "'" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> corpus;
+    corpus.reserve(documents.size() * replicas);
+    size_t corpus_bytes = 0;
+    for (int r = 0; r < replicas; ++r) {
+        for (const auto& text : documents) {
+            corpus.push_back(text);
+            corpus_bytes += text.size();
+        }
+    }
+
+    const double megabytes = 1024.0 * 1024.0;
+    std::cout << "=== Arena por Lote: Alocações e Memória ===" << std::endl;
+    std::cout << "Corpus: " << corpus.size() << " documentos, " << std::fixed << std::setprecision(1)
+              << corpus_bytes / megabytes << " MB (" << replicas << "x " << csv_file << "), "
+              << workers << " workers" << std::endl;
+    std::cout << std::left << std::setw(14) << "modo" << std::setw(8) << "arena"
+              << std::setw(14) << "alocações" << std::setw(12) << "aloc/doc"
+              << std::setw(14) << "MB pedidos" << std::setw(12) << "tempo (ms)" << "pico extra (MB)" << std::endl;
+
+    for (bool streaming : {false, true}) {
+        for (bool use_arena : {false, true}) {
+            RunStats stats = measure(corpus, workers, use_arena, streaming);
+            if (!stats.success) {
+                std::cerr << "Erro: execução falhou" << std::endl;
+                return 1;
+            }
+            std::cout << std::left << std::fixed << std::setprecision(1)
+                      << std::setw(14) << (streaming ? "streaming" : "particionado")
+                      << std::setw(8) << (use_arena ? "sim" : "não")
+                      << std::setw(14) << stats.allocations
+                      << std::setw(12) << static_cast<double>(stats.allocations) / corpus.size()
+                      << std::setw(14) << stats.bytes / megabytes
+                      << std::setw(12) << stats.milliseconds
+                      << stats.peak_extra / megabytes << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include "../include/pipeline/pipeline_manager.h"
+#include "../include/utils/csv_reader.h"
+#include "../include/utils/memory_usage.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+
+/**
+ * @file partition_memory_bench.cpp
+ * @brief Pico de memória do modo paralelo particionado
+ *
+ * Lê a coluna de texto do CSV (replicada para obter um corpus maior), reinicia
+ * o pico de memória residente e executa runParallelPartitioned. O acréscimo
+ * de pico sobre a memória antes da execução é reportado em múltiplos do
+ * tamanho do corpus.
+ *
+ * Uso: partition_memory_bench [arquivo.csv] [coluna] [réplicas] [workers]
+ */
+
+using namespace legal_doc_pipeline;
+
+int main(int argc, char** argv) {
+    std::string csv_file = argc > 1 ? argv[1] : "docs.csv";
+    std::string column = argc > 2 ? argv[2] : "Texto";
+    int replicas = argc > 3 ? std::max(1, std::atoi(argv[3])) : 20;
+    int workers = argc > 4 ? std::max(1, std::atoi(argv[4])) : 4;
+
+    utils::CsvReader csv_reader;
+    std::streambuf* original_buffer = std::cout.rdbuf(nullptr);
+    std::vector<std::string> documents = csv_reader.readColumn(csv_file, column);
+    std::cout.rdbuf(original_buffer);
+    std::cout.clear();
+
+    if (documents.empty()) {
+        std::cerr << "Erro: nenhum documento lido de '" << csv_file << "'" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> corpus;
+    corpus.reserve(documents.size() * replicas);
+    size_t corpus_bytes = 0;
+    for (int r = 0; r < replicas; ++r) {
+        for (const auto& text : documents) {
+            corpus.push_back(text);
+            corpus_bytes += text.size();
+        }
+    }
+    documents.clear();
+    documents.shrink_to_fit();
+
+    PipelineConfig config;
+    config.num_workers = workers;
+    pipeline::PipelineManager manager(config);
+
+    size_t before = utils::MemoryUsage::currentResidentBytes();
+    bool peak_reset = utils::MemoryUsage::resetPeak();
+
+    original_buffer = std::cout.rdbuf(nullptr);
+    PipelineResult result = manager.runParallelPartitioned(corpus);
+    std::cout.rdbuf(original_buffer);
+    std::cout.clear();
+
+    size_t peak = utils::MemoryUsage::peakResidentBytes();
+    if (!result.success || before == 0 || peak == 0) {
+        std::cerr << "Erro: execução falhou ou memória residente indisponível" << std::endl;
+        return 1;
+    }
+
+    double megabytes = 1024.0 * 1024.0;
+    double extra = peak > before ? static_cast<double>(peak - before) : 0.0;
+    std::cout << "=== Pico de Memória do Modo Particionado ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Corpus: " << corpus.size() << " documentos, " << corpus_bytes / megabytes << " MB ("
+              << replicas << "x " << csv_file << ")" << std::endl;
+    std::cout << "Workers: " << workers << ", tempo: " << result.execution_time * 1000.0 << " ms" << std::endl;
+    std::cout << "RSS antes: " << before / megabytes << " MB, pico"
+              << (peak_reset ? "" : " (desde o início do processo)") << ": " << peak / megabytes << " MB" << std::endl;
+    std::cout << std::setprecision(2) << "Acréscimo de pico: " << extra / megabytes << " MB = "
+              << extra / static_cast<double>(corpus_bytes) << "x o corpus" << std::endl;
+    return 0;
+}
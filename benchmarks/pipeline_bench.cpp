@@ -0,0 +1,410 @@
+#include "../include/pipeline/pipeline_manager.h"
+#include "../include/pipeline/text_processor.h"
+#include "../include/pipeline/tokenized_document.h"
+#include "../include/scheduler/workflow_scheduler.h"
+#include "../include/utils/csv_reader.h"
+#include "../include/utils/mapped_csv_reader.h"
+#include "../include/utils/thread_pool.h"
+#include "../include/types.h"
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @file pipeline_bench.cpp
+ * @brief Microbenchmarks (Google Benchmark) das etapas, do CSV e do scheduler
+ *
+ * - Etapas do TextProcessor sobre lotes de 32 documentos, variando o tamanho
+ *   do documento; a entrada de cada etapa é a saída real das anteriores.
+ * - Leitura de CSV (CsvReader e MappedCsvReader) variando registros e threads.
+ * - Overhead do scheduler em DAGs sintéticos de tarefas vazias, variando
+ *   largura, profundidade e workers, nos dois modos de escalonamento.
+ * - Pipeline completo (runParallel e runParallelPartitioned) variando workers.
+ *
+ * Os textos vêm da coluna Texto de docs.csv (ou de um parágrafo sintético se
+ * o arquivo não existir). Sem --benchmark_out, os resultados também são
+ * gravados em pipeline_bench.json para acompanhar regressões.
+ *
+ * Uso: pipeline_bench [opções do Google Benchmark]
+ */
+
+using namespace legal_doc_pipeline;
+
+namespace {
+
+    const size_t BATCH_DOCUMENTS = 32;   ///< Documentos por iteração nas etapas
+
+    /**
+     * @brief Texto de origem dos documentos sintéticos (lido uma vez)
+     */
+    const std::string& sourceText() {
+        static const std::string text = []() {
+            std::string joined;
+            utils::CsvReader reader;
+            for (const std::string& value : reader.readColumn("docs.csv", "Texto")) {
+                joined += value;
+                joined += ' ';
+                if (joined.size() > (4u << 20)) break;
+            }
+            if (joined.size() < 4096) {
+                joined.clear();
+                while (joined.size() < (1u << 20)) {
+                    joined += "O Tribunal de Contas do Estado, no uso de suas atribuições, CONHECE do recurso "
+                              "interposto pela Secretaria Municipal em 12/03/2024 e, no mérito, NEGA-LHE provimento. ";
+                }
+            }
+            return joined;
+        }();
+        return text;
+    }
+
+    /**
+     * @brief Lote de documentos de ~document_bytes bytes cortados em fronteiras de palavra
+     */
+    std::vector<std::string> makeDocuments(size_t count, size_t document_bytes) {
+        const std::string& text = sourceText();
+        std::vector<std::string> documents;
+        size_t position = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (position + document_bytes >= text.size()) {
+                position = 0;
+            }
+            size_t end = text.find(' ', position + document_bytes);
+            if (end == std::string::npos) end = text.size();
+            documents.push_back(text.substr(position, end - position));
+            position = end + 1;
+        }
+        return documents;
+    }
+
+    /**
+     * @brief Estado do lote depois de cada etapa, para servir de entrada à seguinte
+     */
+    struct StageInputs {
+        std::vector<std::string> raw;              ///< Entrada de CleanText
+        std::vector<std::string> cleaned;          ///< Entrada de NormalizeText
+        std::vector<std::string> normalized;       ///< Entrada de WordTokenization
+        std::vector<pipeline::TokenizedDocument> words;      ///< Entrada de BpeTokenization
+        std::vector<pipeline::TokenizedDocument> subwords;   ///< Entrada de PartitionTokens
+        std::vector<pipeline::TokenizedDocument> truncated;  ///< Entrada de AddSpecialTokens
+        std::vector<pipeline::TokenizedDocument> special;    ///< Entrada de TokensToIndices
+        std::vector<std::string> indexed;          ///< Entrada de GenerateEmbeddings
+    };
+
+    StageInputs makeStageInputs(size_t document_bytes) {
+        StageInputs inputs;
+        inputs.raw = makeDocuments(BATCH_DOCUMENTS, document_bytes);
+        const size_t n = inputs.raw.size();
+
+        inputs.cleaned = inputs.raw;
+        pipeline::TextProcessor::cleanTextRange(inputs.cleaned, 0, n);
+        inputs.normalized = inputs.cleaned;
+        pipeline::TextProcessor::normalizeTextRange(inputs.normalized, 0, n);
+        inputs.words.resize(n);
+        pipeline::TextProcessor::wordTokenizationRange(inputs.normalized, inputs.words, 0, n);
+        inputs.subwords = inputs.words;
+        pipeline::TextProcessor::bpeTokenizationRange(inputs.subwords, 0, n);
+        inputs.truncated = inputs.subwords;
+        pipeline::TextProcessor::partitionTokensRange(inputs.truncated, 0, n);
+        inputs.special = inputs.truncated;
+        pipeline::TextProcessor::addSpecialTokensRange(inputs.special, 0, n);
+
+        // GenerateEmbeddings consome a forma textual dos índices
+        inputs.indexed = inputs.normalized;
+        pipeline::TextProcessor::wordTokenizationRange(inputs.indexed, 0, n);
+        pipeline::TextProcessor::bpeTokenizationRange(inputs.indexed, 0, n);
+        pipeline::TextProcessor::partitionTokensRange(inputs.indexed, 0, n);
+        pipeline::TextProcessor::addSpecialTokensRange(inputs.indexed, 0, n);
+        pipeline::TextProcessor::tokensToIndicesRange(inputs.indexed, 0, n);
+        return inputs;
+    }
+
+    size_t totalBytes(const std::vector<std::string>& documents) {
+        size_t bytes = 0;
+        for (const auto& document : documents) bytes += document.size();
+        return bytes;
+    }
+
+    /**
+     * @brief Executa uma etapa sobre uma cópia da entrada a cada iteração (a cópia não é medida)
+     */
+    template <typename Input, typename Stage>
+    void runStage(benchmark::State& state, const Input& input, size_t input_bytes, Stage stage) {
+        Input working;
+        for (auto _ : state) {
+            state.PauseTiming();
+            working = input;
+            state.ResumeTiming();
+            stage(working);
+            benchmark::DoNotOptimize(working.data());
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+        state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input_bytes));
+    }
+
+    void BM_CleanText(benchmark::State& state) {
+        StageInputs inputs = makeStageInputs(static_cast<size_t>(state.range(0)));
+        runStage(state, inputs.raw, totalBytes(inputs.raw), [](std::vector<std::string>& texts) {
+            pipeline::TextProcessor::cleanTextRange(texts, 0, texts.size());
+        });
+    }
+
+    void BM_NormalizeText(benchmark::State& state) {
+        StageInputs inputs = makeStageInputs(static_cast<size_t>(state.range(0)));
+        runStage(state, inputs.cleaned, totalBytes(inputs.raw), [](std::vector<std::string>& texts) {
+            pipeline::TextProcessor::normalizeTextRange(texts, 0, texts.size());
+        });
+    }
+
+    void BM_WordTokenization(benchmark::State& state) {
+        StageInputs inputs = makeStageInputs(static_cast<size_t>(state.range(0)));
+        const std::vector<std::string>& texts = inputs.normalized;
+        std::vector<pipeline::TokenizedDocument> empty(texts.size());
+        runStage(state, empty, totalBytes(inputs.raw), [&texts](std::vector<pipeline::TokenizedDocument>& documents) {
+            pipeline::TextProcessor::wordTokenizationRange(texts, documents, 0, documents.size());
+        });
+    }
+
+    void BM_BpeTokenization(benchmark::State& state) {
+        StageInputs inputs = makeStageInputs(static_cast<size_t>(state.range(0)));
+        runStage(state, inputs.words, totalBytes(inputs.raw), [](std::vector<pipeline::TokenizedDocument>& documents) {
+            pipeline::TextProcessor::bpeTokenizationRange(documents, 0, documents.size());
+        });
+    }
+
+    void BM_PartitionTokens(benchmark::State& state) {
+        StageInputs inputs = makeStageInputs(static_cast<size_t>(state.range(0)));
+        runStage(state, inputs.subwords, totalBytes(inputs.raw), [](std::vector<pipeline::TokenizedDocument>& documents) {
+            pipeline::TextProcessor::partitionTokensRange(documents, 0, documents.size());
+        });
+    }
+
+    void BM_AddSpecialTokens(benchmark::State& state) {
+        StageInputs inputs = makeStageInputs(static_cast<size_t>(state.range(0)));
+        runStage(state, inputs.truncated, totalBytes(inputs.raw), [](std::vector<pipeline::TokenizedDocument>& documents) {
+            pipeline::TextProcessor::addSpecialTokensRange(documents, 0, documents.size());
+        });
+    }
+
+    void BM_TokensToIndices(benchmark::State& state) {
+        StageInputs inputs = makeStageInputs(static_cast<size_t>(state.range(0)));
+        runStage(state, inputs.special, totalBytes(inputs.raw), [](std::vector<pipeline::TokenizedDocument>& documents) {
+            pipeline::TextProcessor::tokensToIndicesRange(documents, 0, documents.size());
+        });
+    }
+
+    void BM_GenerateEmbeddings(benchmark::State& state) {
+        StageInputs inputs = makeStageInputs(static_cast<size_t>(state.range(0)));
+        runStage(state, inputs.indexed, totalBytes(inputs.raw), [](std::vector<std::string>& texts) {
+            pipeline::TextProcessor::generateEmbeddingsRange(texts, 0, texts.size());
+        });
+    }
+
+    /**
+     * @brief Arquivo CSV temporário com registros de várias linhas entre aspas
+     */
+    class TemporaryCsv {
+    private:
+        std::string path;
+        size_t bytes = 0;
+
+    public:
+        explicit TemporaryCsv(size_t records) : path("pipeline_bench_" + std::to_string(records) + ".csv") {
+            std::vector<std::string> documents = makeDocuments(records, 1024);
+            std::ofstream file(path, std::ios::binary);
+            file << "Processo;Texto;Resumo\n";
+            for (size_t i = 0; i < documents.size(); ++i) {
+                std::string quoted;
+                for (char c : documents[i]) {
+                    quoted += c;
+                    if (c == '"') quoted += '"';
+                }
+                file << i << ";\"" << quoted << "\nLinha final do registro\";resumo " << i << "\n";
+            }
+            bytes = static_cast<size_t>(file.tellp());
+        }
+
+        ~TemporaryCsv() { std::remove(path.c_str()); }
+
+        const std::string& filename() const { return path; }
+        size_t size() const { return bytes; }
+    };
+
+    void BM_CsvReader(benchmark::State& state) {
+        TemporaryCsv csv(static_cast<size_t>(state.range(0)));
+        utils::CsvReader reader;
+        for (auto _ : state) {
+            std::vector<std::string> column = reader.readColumn(csv.filename(), "Texto");
+            benchmark::DoNotOptimize(column.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(csv.size()));
+    }
+
+    void BM_MappedCsvReader(benchmark::State& state) {
+        TemporaryCsv csv(static_cast<size_t>(state.range(0)));
+        // Blocos mínimos de 64 KB para que arquivos pequenos também usem as threads pedidas
+        utils::MappedCsvReader reader(static_cast<size_t>(state.range(1)), 64 * 1024);
+        for (auto _ : state) {
+            utils::CsvColumnView column = reader.readColumn(csv.filename(), "Texto");
+            benchmark::DoNotOptimize(column.size());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(csv.size()));
+    }
+
+    /**
+     * @brief DAG em camadas de tarefas vazias: cada nó depende de dois nós da camada anterior
+     */
+    void buildDag(scheduler::WorkflowScheduler& sched, int width, int depth) {
+        auto noop = [](std::vector<std::string>&) {};
+        std::vector<TaskId> previous;
+        std::vector<TaskId> current;
+        for (int layer = 0; layer < depth; ++layer) {
+            current.clear();
+            for (int i = 0; i < width; ++i) {
+                TaskId task = sched.addTask(Task("L" + std::to_string(layer) + "_" + std::to_string(i),
+                                                 TaskType::TEXT_CLEANING, layer, noop));
+                if (layer > 0) {
+                    sched.addDependency(task, previous[i]);
+                    if (width > 1) sched.addDependency(task, previous[(i + 1) % width]);
+                }
+                current.push_back(task);
+            }
+            previous.swap(current);
+        }
+    }
+
+    void runSchedulerDag(benchmark::State& state, SchedulingMode mode) {
+        const int width = static_cast<int>(state.range(0));
+        const int depth = static_cast<int>(state.range(1));
+        const int workers = static_cast<int>(state.range(2));
+
+        utils::ThreadPoolOptions options;
+        options.num_threads = static_cast<size_t>(workers);
+        utils::ThreadPool pool(options);
+        scheduler::WorkflowScheduler sched(mode);
+        buildDag(sched, width, depth);
+        sched.compile();
+        sched.setThreadPool(&pool);
+
+        const std::vector<std::string> no_documents;
+        for (auto _ : state) {
+            if (!sched.run(no_documents, workers)) {
+                state.SkipWithError("falha na execução do DAG");
+                break;
+            }
+        }
+        // Tarefas por segundo: o inverso é o custo do scheduler por tarefa
+        state.SetItemsProcessed(state.iterations() * width * depth);
+    }
+
+    void BM_SchedulerGlobalQueue(benchmark::State& state) {
+        runSchedulerDag(state, SchedulingMode::GLOBAL_QUEUE);
+    }
+
+    void BM_SchedulerWorkStealing(benchmark::State& state) {
+        runSchedulerDag(state, SchedulingMode::WORK_STEALING);
+    }
+
+    /**
+     * @brief Silencia std::cout (banners e relatórios do PipelineManager) enquanto existe
+     */
+    class MuteStdout {
+    private:
+        std::streambuf* previous;
+
+    public:
+        MuteStdout() : previous(std::cout.rdbuf(nullptr)) {}
+        ~MuteStdout() {
+            std::cout.rdbuf(previous);
+            std::cout.clear();
+        }
+    };
+
+    template <typename Run>
+    void runPipeline(benchmark::State& state, Run run) {
+        PipelineConfig config;
+        config.num_workers = static_cast<int>(state.range(0));
+        pipeline::PipelineManager manager(config);
+        const std::vector<std::string> documents = makeDocuments(256, 2048);
+
+        MuteStdout mute;
+        for (auto _ : state) {
+            PipelineResult result = run(manager, documents);
+            if (!result.success) {
+                state.SkipWithError("falha no pipeline");
+                break;
+            }
+            benchmark::DoNotOptimize(result.processed_data.data());
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(documents.size()));
+        state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(totalBytes(documents)));
+    }
+
+    void BM_PipelineParallel(benchmark::State& state) {
+        runPipeline(state, [](pipeline::PipelineManager& manager, const std::vector<std::string>& documents) {
+            return manager.runParallel(documents);
+        });
+    }
+
+    void BM_PipelinePartitioned(benchmark::State& state) {
+        runPipeline(state, [](pipeline::PipelineManager& manager, const std::vector<std::string>& documents) {
+            return manager.runParallelPartitioned(documents);
+        });
+    }
+
+} // namespace
+
+// Etapas: tamanho do documento em bytes
+BENCHMARK(BM_CleanText)->Arg(256)->Arg(2048)->Arg(16384);
+BENCHMARK(BM_NormalizeText)->Arg(256)->Arg(2048)->Arg(16384);
+BENCHMARK(BM_WordTokenization)->Arg(256)->Arg(2048)->Arg(16384);
+BENCHMARK(BM_BpeTokenization)->Arg(256)->Arg(2048)->Arg(16384);
+BENCHMARK(BM_PartitionTokens)->Arg(256)->Arg(2048)->Arg(16384);
+BENCHMARK(BM_AddSpecialTokens)->Arg(256)->Arg(2048)->Arg(16384);
+BENCHMARK(BM_TokensToIndices)->Arg(256)->Arg(2048)->Arg(16384);
+BENCHMARK(BM_GenerateEmbeddings)->Arg(256)->Arg(2048)->Arg(16384);
+
+// CSV: registros (e threads de parse no leitor mapeado)
+BENCHMARK(BM_CsvReader)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MappedCsvReader)->ArgsProduct({{1000, 10000}, {1, 2, 4}})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Scheduler: largura, profundidade, workers
+BENCHMARK(BM_SchedulerGlobalQueue)
+    ->ArgsProduct({{1, 8, 64}, {1, 8, 64}, {1, 2, 4}})->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(BM_SchedulerWorkStealing)
+    ->ArgsProduct({{1, 8, 64}, {1, 8, 64}, {1, 2, 4}})->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+// Pipeline completo: workers
+BENCHMARK(BM_PipelineParallel)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_PipelinePartitioned)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+int main(int argc, char** argv) {
+    // Sem destino explícito, os resultados também vão para pipeline_bench.json
+    std::vector<char*> args(argv, argv + argc);
+    bool has_output = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]).rfind("--benchmark_out=", 0) == 0) {
+            has_output = true;
+        }
+    }
+    std::string out_arg = "--benchmark_out=pipeline_bench.json";
+    std::string format_arg = "--benchmark_out_format=json";
+    if (!has_output) {
+        args.push_back(&out_arg[0]);
+        args.push_back(&format_arg[0]);
+    }
+    int arg_count = static_cast<int>(args.size());
+
+    benchmark::Initialize(&arg_count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(arg_count, args.data())) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include "../include/scheduler/workflow_scheduler.h"
+#include "../include/utils/timer.h"
+#include "../include/types.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <cstdlib>
+
+/**
+ * @file scheduler_contention_bench.cpp
+ * @brief Benchmark de contenção do WorkflowScheduler
+ *
+ * Executa um DAG largo (camadas de tarefas curtas em que cada nó depende de
+ * dois nós da camada anterior) com a fila global e com as deques de roubo de
+ * tarefas, variando o número de workers. Tarefas curtas e numerosas expõem o
+ * custo de sincronização do scheduler em vez do custo das operações.
+ *
+ * Uso: scheduler_contention_bench [largura] [camadas] [max_workers] [trabalho_us]
+ */
+
+using namespace legal_doc_pipeline;
+
+namespace {
+
+    /**
+     * @brief Ocupa a CPU durante o intervalo pedido (simula uma tarefa curta)
+     * @param micros Duração em microssegundos
+     */
+    void spinFor(int micros) {
+        auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(micros);
+        while (std::chrono::steady_clock::now() < until) {
+        }
+    }
+
+    /**
+     * @brief Monta o DAG em camadas no scheduler
+     */
+    void buildLayeredDag(scheduler::WorkflowScheduler& sched, int width, int layers, int work_us) {
+        auto op = [work_us](std::vector<std::string>&) { spinFor(work_us); };
+
+        // As arestas usam os TaskIds devolvidos por addTask (sem buscas por nome)
+        std::vector<TaskId> previous_layer;
+        std::vector<TaskId> current_layer;
+        for (int layer = 0; layer < layers; ++layer) {
+            current_layer.clear();
+            for (int i = 0; i < width; ++i) {
+                std::string id = "L" + std::to_string(layer) + "_" + std::to_string(i);
+                TaskId task = sched.addTask(Task(id, TaskType::TEXT_CLEANING, layer * 10 + (i % 10), op));
+                current_layer.push_back(task);
+                if (layer > 0) {
+                    sched.addDependency(task, previous_layer[i]);
+                    if (width > 1) {
+                        sched.addDependency(task, previous_layer[(i + 1) % width]);
+                    }
+                }
+            }
+            previous_layer.swap(current_layer);
+        }
+    }
+
+    /**
+     * @brief Executa uma configuração e retorna o tempo em segundos
+     */
+    double runOnce(SchedulingMode mode, int width, int layers, int workers, int work_us,
+                   size_t& stolen_tasks) {
+        scheduler::WorkflowScheduler sched(mode);
+        buildLayeredDag(sched, width, layers, work_us);
+
+        std::vector<std::string> data;
+        utils::Timer timer;
+
+        // Silencia o log do scheduler para medir apenas o custo de escalonamento
+        std::streambuf* original_buffer = std::cout.rdbuf(nullptr);
+        timer.start();
+        bool ok = sched.run(data, workers);
+        timer.stop();
+        std::cout.rdbuf(original_buffer);
+        std::cout.clear();
+
+        if (!ok) {
+            std::cerr << "Falha na execução do DAG" << std::endl;
+            std::exit(1);
+        }
+        stolen_tasks = sched.getExecutionStats().at("stolen_tasks");
+        return timer.getElapsedSeconds();
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int width = argc > 1 ? std::atoi(argv[1]) : 64;
+    int layers = argc > 2 ? std::atoi(argv[2]) : 32;
+    int max_workers = argc > 3 ? std::atoi(argv[3])
+                               : static_cast<int>(std::max(2u, std::thread::hardware_concurrency()));
+    int work_us = argc > 4 ? std::atoi(argv[4]) : 5;
+    const int repetitions = 3;
+
+    size_t total_tasks = static_cast<size_t>(width) * static_cast<size_t>(layers);
+    std::cout << "=== Benchmark de Contenção do Scheduler ===" << std::endl;
+    std::cout << "DAG: " << layers << " camadas x " << width << " tarefas (" << total_tasks
+              << " tarefas, " << work_us << " us cada)" << std::endl;
+    std::cout << std::left << std::setw(10) << "workers"
+              << std::setw(16) << "global (ms)"
+              << std::setw(16) << "stealing (ms)"
+              << std::setw(12) << "speedup"
+              << std::setw(14) << "roubos"
+              << "tarefas/s (stealing)" << std::endl;
+
+    for (int workers = 1; workers <= max_workers; workers *= 2) {
+        double best_global = 1e30;
+        double best_stealing = 1e30;
+        size_t stolen = 0;
+
+        for (int rep = 0; rep < repetitions; ++rep) {
+            size_t ignored = 0;
+            best_global = std::min(best_global,
+                runOnce(SchedulingMode::GLOBAL_QUEUE, width, layers, workers, work_us, ignored));
+            best_stealing = std::min(best_stealing,
+                runOnce(SchedulingMode::WORK_STEALING, width, layers, workers, work_us, stolen));
+        }
+
+        std::cout << std::left << std::fixed << std::setprecision(2)
+                  << std::setw(10) << workers
+                  << std::setw(16) << best_global * 1000.0
+                  << std::setw(16) << best_stealing * 1000.0
+                  << std::setw(12) << best_global / best_stealing
+                  << std::setw(14) << stolen
+                  << std::setprecision(0) << total_tasks / best_stealing << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,341 @@
+#include "../include/scheduler/workflow_scheduler.h"
+#include "../include/utils/thread_pool.h"
+#include "../include/types.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file scheduler_overhead_bench.cpp
+ * @brief Custo de despacho do WorkflowScheduler com tarefas vazias
+ *
+ * Monta DAGs sintéticos de tarefas sem operação (cadeia, losangos de
+ * fan-out/fan-in e grafo aleatório em camadas) de 10 a 1M nós e mede, para
+ * cada modo de escalonamento e número de workers, tarefas por segundo,
+ * custo médio por tarefa, espera na fila (p50/p99, latência de despacho após a
+ * última dependência) e speedup sobre 1 worker. Como as tarefas não fazem
+ * nada, o resultado é o teto de tarefas/s do scheduler.
+ *
+ * Portão de regressão: com --baseline ARQ, a primeira execução grava a linha
+ * de base e as seguintes comparam cada configuração com ela; o programa
+ * retorna 1 se alguma ficar mais de --tolerance % abaixo da base.
+ *
+ * Uso: scheduler_overhead_bench [--max-nodes N] [--max-workers N] [--baseline ARQ]
+ *                               [--update-baseline] [--tolerance PCT]
+ */
+
+using namespace legal_doc_pipeline;
+
+namespace {
+
+    /**
+     * @brief Formato do DAG sintético
+     */
+    enum class DagShape {
+        CHAIN,     ///< Cada tarefa depende da anterior (só latência de despacho)
+        DIAMOND,   ///< Fonte -> 16 tarefas paralelas -> sorvedouro, repetido
+        LAYERED    ///< Camadas de ~sqrt(n) tarefas, cada uma com 1 a 3 dependências aleatórias
+    };
+
+    const char* shapeName(DagShape shape) {
+        switch (shape) {
+            case DagShape::CHAIN: return "chain";
+            case DagShape::DIAMOND: return "diamond";
+            case DagShape::LAYERED: return "layered";
+        }
+        return "?";
+    }
+
+    const char* modeName(SchedulingMode mode) {
+        return mode == SchedulingMode::GLOBAL_QUEUE ? "global" : "stealing";
+    }
+
+    /**
+     * @brief Monta o DAG com exatamente nodes tarefas vazias
+     */
+    void buildDag(scheduler::WorkflowScheduler& sched, DagShape shape, size_t nodes) {
+        auto noop = [](std::vector<std::string>&) {};
+        auto add = [&sched, &noop](size_t index) {
+            return sched.addTask(Task("n" + std::to_string(index), TaskType::TEXT_CLEANING, 0, noop));
+        };
+
+        switch (shape) {
+            case DagShape::CHAIN: {
+                TaskId previous = add(0);
+                for (size_t i = 1; i < nodes; ++i) {
+                    TaskId task = add(i);
+                    sched.addDependency(task, previous);
+                    previous = task;
+                }
+                break;
+            }
+            case DagShape::DIAMOND: {
+                const size_t fan = 16;
+                size_t count = 0;
+                TaskId source = add(count++);
+                std::vector<TaskId> middle;
+                while (count < nodes) {
+                    // Reserva um nó para o sorvedouro do losango
+                    middle.clear();
+                    while (middle.size() < fan && count + 1 < nodes) {
+                        TaskId task = add(count++);
+                        sched.addDependency(task, source);
+                        middle.push_back(task);
+                    }
+                    TaskId sink = add(count++);
+                    if (middle.empty()) {
+                        sched.addDependency(sink, source);
+                    }
+                    for (TaskId task : middle) {
+                        sched.addDependency(sink, task);
+                    }
+                    source = sink;
+                }
+                break;
+            }
+            case DagShape::LAYERED: {
+                const size_t width = std::max<size_t>(1, static_cast<size_t>(std::sqrt(static_cast<double>(nodes))));
+                std::mt19937 rng(42);
+                std::vector<TaskId> previous;
+                std::vector<TaskId> current;
+                size_t count = 0;
+                while (count < nodes) {
+                    current.clear();
+                    for (size_t i = 0; i < width && count < nodes; ++i) {
+                        TaskId task = add(count++);
+                        if (!previous.empty()) {
+                            // 1 a 3 dependências distintas na camada anterior
+                            size_t wanted = std::min<size_t>(previous.size(), 1 + rng() % 3);
+                            size_t first = rng() % previous.size();
+                            for (size_t d = 0; d < wanted; ++d) {
+                                sched.addDependency(task, previous[(first + d) % previous.size()]);
+                            }
+                        }
+                        current.push_back(task);
+                    }
+                    previous.swap(current);
+                }
+                break;
+            }
+        }
+    }
+
+    /**
+     * @brief Resultado de uma configuração (melhor repetição)
+     */
+    struct CaseResult {
+        double seconds = 0.0;           ///< Tempo da melhor repetição
+        double tasks_per_second = 0.0;  ///< Tarefas por segundo na melhor repetição
+        uint64_t wait_p50_ns = 0;       ///< Espera na fila (mediana)
+        uint64_t wait_p99_ns = 0;       ///< Espera na fila (p99)
+    };
+
+    /**
+     * @brief Executa o DAG já compilado, repetindo até somar ~0,2 s (mínimo 3 execuções)
+     */
+    bool measure(scheduler::WorkflowScheduler& sched, size_t nodes, int workers, CaseResult& result) {
+        utils::ThreadPoolOptions options;
+        options.num_threads = static_cast<size_t>(workers);
+        utils::ThreadPool pool(options);
+        sched.setThreadPool(&pool);
+
+        const std::vector<std::string> no_documents;
+        double best = 1e30;
+        double total = 0.0;
+        for (int rep = 0; rep < 3 || (total < 0.2 && rep < 1000); ++rep) {
+            auto start = std::chrono::steady_clock::now();
+            bool ok = sched.run(no_documents, workers);
+            auto finish = std::chrono::steady_clock::now();
+            if (!ok) {
+                sched.setThreadPool(nullptr);
+                return false;
+            }
+            double seconds = std::chrono::duration<double>(finish - start).count();
+            total += seconds;
+            if (seconds < best) {
+                best = seconds;
+                auto stats = sched.getTaskLatencyStats();
+                const utils::LatencyHistogram& wait = stats[TaskType::TEXT_CLEANING].queue_wait;
+                result.wait_p50_ns = wait.percentile(50.0);
+                result.wait_p99_ns = wait.percentile(99.0);
+            }
+        }
+        sched.setThreadPool(nullptr);
+
+        result.seconds = best;
+        result.tasks_per_second = static_cast<double>(nodes) / best;
+        return true;
+    }
+
+    /**
+     * @brief Chave de uma configuração no arquivo de linha de base
+     */
+    std::string caseKey(DagShape shape, size_t nodes, SchedulingMode mode, int workers) {
+        std::ostringstream key;
+        key << shapeName(shape) << ' ' << nodes << ' ' << modeName(mode) << ' ' << workers;
+        return key.str();
+    }
+
+    /**
+     * @brief Lê a linha de base (linhas "formato nós modo workers tarefas/s"; # inicia comentário)
+     */
+    std::map<std::string, double> loadBaseline(const std::string& path) {
+        std::map<std::string, double> baseline;
+        std::ifstream file(path);
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.empty() || line[0] == '#') continue;
+            std::istringstream fields(line);
+            std::string shape, mode;
+            size_t nodes = 0;
+            int workers = 0;
+            double tasks_per_second = 0.0;
+            if (fields >> shape >> nodes >> mode >> workers >> tasks_per_second) {
+                std::ostringstream key;
+                key << shape << ' ' << nodes << ' ' << mode << ' ' << workers;
+                baseline[key.str()] = tasks_per_second;
+            }
+        }
+        return baseline;
+    }
+
+    bool saveBaseline(const std::string& path, const std::map<std::string, double>& results) {
+        std::ofstream file(path);
+        if (!file.is_open()) {
+            std::cerr << "Erro: não foi possível gravar a linha de base '" << path << "'" << std::endl;
+            return false;
+        }
+        file << "# formato nós modo workers tarefas/s\n" << std::fixed << std::setprecision(0);
+        for (const auto& entry : results) {
+            file << entry.first << ' ' << entry.second << '\n';
+        }
+        return static_cast<bool>(file);
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t max_nodes = 1000000;
+    int max_workers = static_cast<int>(std::max(2u, std::thread::hardware_concurrency()));
+    std::string baseline_path;
+    bool update_baseline = false;
+    double tolerance = 20.0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--max-nodes" && has_value) {
+            max_nodes = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--max-workers" && has_value) {
+            max_workers = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--baseline" && has_value) {
+            baseline_path = argv[++i];
+        } else if (arg == "--update-baseline") {
+            update_baseline = true;
+        } else if (arg == "--tolerance" && has_value) {
+            tolerance = std::atof(argv[++i]);
+        } else {
+            std::cerr << "Uso: " << argv[0] << " [--max-nodes N] [--max-workers N] [--baseline ARQ]"
+                      << " [--update-baseline] [--tolerance PCT]" << std::endl;
+            return 2;
+        }
+    }
+
+    std::map<std::string, double> baseline;
+    bool compare = false;
+    if (!baseline_path.empty() && !update_baseline) {
+        baseline = loadBaseline(baseline_path);
+        compare = !baseline.empty();
+    }
+
+    std::vector<int> worker_counts;
+    for (int workers = 1; workers <= max_workers; workers *= 2) {
+        worker_counts.push_back(workers);
+    }
+
+    std::cout << "=== Overhead do Scheduler (tarefas vazias) ===" << std::endl;
+    std::cout << std::left << std::setw(9) << "formato" << std::setw(9) << "nós"
+              << std::setw(10) << "modo" << std::setw(9) << "workers"
+              << std::setw(13) << "tarefas/s" << std::setw(11) << "ns/tarefa"
+              << std::setw(17) << "espera p50 (ns)" << std::setw(17) << "espera p99 (ns)"
+              << std::setw(10) << "speedup" << (compare ? "vs base" : "") << std::endl;
+
+    std::map<std::string, double> results;
+    double ceiling = 0.0;
+    std::string ceiling_key;
+    size_t regressions = 0;
+
+    for (DagShape shape : {DagShape::CHAIN, DagShape::DIAMOND, DagShape::LAYERED}) {
+        for (size_t nodes = 10; nodes <= max_nodes; nodes *= 10) {
+            for (SchedulingMode mode : {SchedulingMode::GLOBAL_QUEUE, SchedulingMode::WORK_STEALING}) {
+                scheduler::WorkflowScheduler sched(mode);
+                buildDag(sched, shape, nodes);
+                if (!sched.compile()) {
+                    std::cerr << "Falha ao compilar o DAG " << shapeName(shape) << std::endl;
+                    return 1;
+                }
+
+                double single_worker = 0.0;
+                for (int workers : worker_counts) {
+                    CaseResult result;
+                    if (!measure(sched, nodes, workers, result)) {
+                        std::cerr << "Falha na execução do DAG " << shapeName(shape) << std::endl;
+                        return 1;
+                    }
+                    if (workers == 1) single_worker = result.seconds;
+
+                    std::string key = caseKey(shape, nodes, mode, workers);
+                    results[key] = result.tasks_per_second;
+                    if (result.tasks_per_second > ceiling) {
+                        ceiling = result.tasks_per_second;
+                        ceiling_key = key;
+                    }
+
+                    std::cout << std::left << std::fixed << std::setprecision(0)
+                              << std::setw(9) << shapeName(shape) << std::setw(9) << nodes
+                              << std::setw(10) << modeName(mode) << std::setw(9) << workers
+                              << std::setw(13) << result.tasks_per_second
+                              << std::setw(11) << result.seconds * 1e9 / static_cast<double>(nodes)
+                              << std::setw(17) << result.wait_p50_ns << std::setw(17) << result.wait_p99_ns
+                              << std::setprecision(2) << std::setw(10) << single_worker / result.seconds;
+                    auto base = baseline.find(key);
+                    if (compare && base != baseline.end() && base->second > 0.0) {
+                        double change = (result.tasks_per_second / base->second - 1.0) * 100.0;
+                        std::cout << std::showpos << std::setprecision(1) << change << "%" << std::noshowpos;
+                        if (change < -tolerance) {
+                            std::cout << "  REGRESSÃO";
+                            ++regressions;
+                        }
+                    }
+                    std::cout << std::endl;
+                }
+            }
+        }
+    }
+
+    std::cout << std::fixed << std::setprecision(0)
+              << "Teto: " << ceiling << " tarefas/s (" << ceiling_key << ")" << std::endl;
+
+    if (!baseline_path.empty() && !compare) {
+        if (!saveBaseline(baseline_path, results)) {
+            return 1;
+        }
+        std::cout << "Linha de base gravada em " << baseline_path << std::endl;
+    }
+    if (regressions > 0) {
+        std::cout << regressions << " configuração(ões) abaixo da linha de base (tolerância "
+                  << std::setprecision(1) << tolerance << "%)" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,212 @@
+#include "../include/tokenizer/tokenizer_wrapper.h"
+#include "../include/utils/csv_reader.h"
+#include "../include/utils/simd_text.h"
+#include "../include/utils/timer.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdlib>
+
+/**
+ * @file tokenizer_bench.cpp
+ * @brief Benchmark da busca de maior prefixo do tokenizador: std::map vs double-array trie
+ *
+ * Tokeniza todas as palavras da coluna de texto do CSV com a busca original
+ * (um substr e uma consulta ao std::map por tamanho de prefixo) e com o
+ * Tokenizer compilado em trie, confere que os IDs são idênticos e reporta o
+ * melhor tempo de cada uma.
+ *
+ * O vocabulário vem de um arquivo no formato vocab.txt (um token por linha,
+ * ID = número da linha) ou, se nenhum for dado, é sintetizado a partir do
+ * corpus com os substrings de palavra mais frequentes.
+ *
+ * Uso: tokenizer_bench [arquivo.csv] [coluna] [vocab.txt|tamanho] [repetições]
+ */
+
+using namespace legal_doc_pipeline;
+
+namespace {
+
+    /**
+     * @brief Separa o corpus em palavras (sequências de bytes de palavra)
+     */
+    std::vector<std::string> splitWords(const std::vector<std::string>& corpus) {
+        std::vector<std::string> words;
+        for (const std::string& text : corpus) {
+            size_t pos = 0;
+            while (pos < text.size()) {
+                size_t run = utils::SimdText::wordRunLength(text.data() + pos, text.size() - pos);
+                if (run == 0) {
+                    ++pos;
+                    continue;
+                }
+                words.emplace_back(text, pos, run);
+                pos += run;
+            }
+        }
+        return words;
+    }
+
+    /**
+     * @brief Vocabulário com todos os bytes do corpus e os substrings de 2 a 10 bytes mais frequentes
+     */
+    std::map<std::string, unsigned int> synthesizeVocabulary(const std::vector<std::string>& words, size_t target) {
+        std::unordered_map<std::string, size_t> counts;
+        std::map<std::string, unsigned int> vocab;
+        for (const std::string& word : words) {
+            for (size_t i = 0; i < word.size(); ++i) {
+                vocab.emplace(word.substr(i, 1), 0);
+                for (size_t len = 2; len <= 10 && i + len <= word.size(); ++len) {
+                    ++counts[word.substr(i, len)];
+                }
+            }
+        }
+
+        std::vector<std::pair<std::string, size_t>> ranked(counts.begin(), counts.end());
+        std::sort(ranked.begin(), ranked.end(), [](const auto& a, const auto& b) {
+            return a.second != b.second ? a.second > b.second : a.first < b.first;
+        });
+        for (const auto& entry : ranked) {
+            if (vocab.size() >= target) break;
+            vocab.emplace(entry.first, 0);
+        }
+
+        unsigned int id = 1;
+        for (auto& entry : vocab) {
+            entry.second = id++;
+        }
+        return vocab;
+    }
+
+    std::map<std::string, unsigned int> loadVocabulary(const std::string& path) {
+        std::map<std::string, unsigned int> vocab;
+        std::ifstream file(path);
+        std::string line;
+        unsigned int id = 0;
+        while (std::getline(file, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            vocab.emplace(line, id++);
+        }
+        return vocab;
+    }
+
+    /**
+     * @brief Busca original: tenta cada tamanho de prefixo, do maior para o menor
+     */
+    void mapLongestMatch(const std::map<std::string, unsigned int>& vocab, const std::string& token_str,
+                         hf_tokenizers::Encoding& encoding) {
+        std::string temp_str = token_str;
+        while (!temp_str.empty()) {
+            bool found = false;
+            for (int len = temp_str.length(); len > 0; --len) {
+                std::string sub_token = temp_str.substr(0, len);
+                if (vocab.count(sub_token)) {
+                    encoding.tokens.push_back({sub_token, vocab.at(sub_token), {}});
+                    encoding.ids.push_back(vocab.at(sub_token));
+                    encoding.type_ids.push_back(0);
+                    temp_str = temp_str.substr(len);
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) {
+                encoding.tokens.push_back({temp_str, 0, {}});
+                encoding.ids.push_back(0);
+                encoding.type_ids.push_back(0);
+                temp_str.clear();
+            }
+        }
+    }
+
+    template <typename EncodeFn>
+    double timeEncoding(const std::vector<std::string>& words, std::vector<unsigned int>& ids, EncodeFn encode) {
+        hf_tokenizers::Encoding encoding;
+        ids.clear();
+        utils::Timer timer;
+        timer.start();
+        for (const std::string& word : words) {
+            encoding.tokens.clear();
+            encoding.ids.clear();
+            encoding.type_ids.clear();
+            encode(word, encoding);
+            ids.insert(ids.end(), encoding.ids.begin(), encoding.ids.end());
+        }
+        timer.stop();
+        return timer.getElapsedSeconds();
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string csv_file = argc > 1 ? argv[1] : "docs.csv";
+    std::string column = argc > 2 ? argv[2] : "Texto";
+    std::string vocab_arg = argc > 3 ? argv[3] : "40000";
+    int repetitions = argc > 4 ? std::max(1, std::atoi(argv[4])) : 3;
+
+    utils::CsvReader csv_reader;
+    std::vector<std::string> words = splitWords(csv_reader.readColumn(csv_file, column));
+    if (words.empty()) {
+        std::cerr << "Erro: nenhuma palavra lida de '" << csv_file << "'" << std::endl;
+        return 1;
+    }
+
+    std::map<std::string, unsigned int> vocab;
+    std::string vocab_source;
+    if (std::all_of(vocab_arg.begin(), vocab_arg.end(), ::isdigit)) {
+        vocab = synthesizeVocabulary(words, static_cast<size_t>(std::atol(vocab_arg.c_str())));
+        vocab_source = "sintetizado do corpus";
+    } else {
+        vocab = loadVocabulary(vocab_arg);
+        vocab_source = vocab_arg;
+    }
+    if (vocab.empty()) {
+        std::cerr << "Erro: vocabulário vazio" << std::endl;
+        return 1;
+    }
+
+    utils::Timer build_timer;
+    build_timer.start();
+    hf_tokenizers::Tokenizer tokenizer(vocab);
+    build_timer.stop();
+
+    size_t total_bytes = 0;
+    for (const auto& word : words) {
+        total_bytes += word.size();
+    }
+
+    std::vector<unsigned int> map_ids;
+    std::vector<unsigned int> trie_ids;
+    double best_map = 1e30;
+    double best_trie = 1e30;
+    for (int rep = 0; rep < repetitions; ++rep) {
+        best_map = std::min(best_map, timeEncoding(words, map_ids,
+            [&vocab](const std::string& word, hf_tokenizers::Encoding& encoding) {
+                mapLongestMatch(vocab, word, encoding);
+            }));
+        best_trie = std::min(best_trie, timeEncoding(words, trie_ids,
+            [&tokenizer](const std::string& word, hf_tokenizers::Encoding& encoding) {
+                tokenizer.encode_word(word, encoding);
+            }));
+    }
+
+    double megabytes = total_bytes / (1024.0 * 1024.0);
+    std::cout << "=== Benchmark do Tokenizador (maior prefixo) ===" << std::endl;
+    std::cout << "Vocabulário: " << vocab.size() << " tokens (" << vocab_source << "), trie compilado em "
+              << std::fixed << std::setprecision(2) << build_timer.getElapsedMilliseconds() << " ms ("
+              << tokenizer.trie_memory_bytes() / 1024.0 << " KB)" << std::endl;
+    std::cout << "Corpus: " << words.size() << " palavras, " << megabytes << " MB (" << csv_file << ")" << std::endl;
+    std::cout << std::left << std::setw(13) << "versão" << std::setw(14) << "tempo (ms)" << "palavras/s" << std::endl;
+    std::cout << std::setw(12) << "std::map" << std::setw(14) << best_map * 1000.0
+              << std::setprecision(0) << words.size() / best_map << std::endl;
+    std::cout << std::setprecision(2) << std::setw(12) << "trie" << std::setw(14) << best_trie * 1000.0
+              << std::setprecision(0) << words.size() / best_trie << std::endl;
+    std::cout << std::setprecision(2) << "Speedup: " << best_map / best_trie << "x" << std::endl;
+    std::cout << "IDs idênticos: " << (map_ids == trie_ids ? "sim" : "não") << std::endl;
+
+    return map_ids == trie_ids ? 0 : 1;
+}
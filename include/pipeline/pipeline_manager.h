@@ -2,11 +2,15 @@
 #define PIPELINE_MANAGER_H
 
 #include "../types.h"
+#include "../utils/arena_resource.h"
 #include "../utils/timer.h"
+#include "tokenized_document.h"
+#include <cstdint>
 #include <memory>
 #include <map>
 #include <vector>
 #include <string>
+#include <functional>
 
 /**
  * @file pipeline_manager.h
@@ -20,22 +24,47 @@ namespace legal_doc_pipeline {
 
 // Forward declarations
 namespace scheduler { class WorkflowScheduler; }
+namespace utils { class ThreadPool; class TraceRecorder; }
 
 namespace pipeline {
 
+    /**
+     * @brief Lote de documentos que percorre as etapas no modo streaming
+     */
+    struct DocumentBatch {
+        size_t first_index = 0;               ///< Posição do primeiro documento no corpus
+        std::vector<std::string> documents;   ///< Documentos do lote
+        std::unique_ptr<utils::ArenaResource> arena; ///< Memória dos tokens (nula = recurso padrão); declarada antes de tokens para sobreviver a eles
+        std::vector<TokenizedDocument> tokens; ///< Forma tipada, de WordTokenization a TokensToIndices
+    };
+
+    /**
+     * @brief Etapa do pipeline no modo streaming
+     */
+    struct StreamingStage {
+        std::string name;                                ///< Nome da etapa (igual ao ID da tarefa)
+        std::function<void(DocumentBatch&)> process;     ///< Processa um lote in-place
+    };
+
     /**
      * @brief Classe principal para gerenciamento do pipeline
      */
     class PipelineManager {
     private:
         PipelineConfig config;                                      ///< Configuração do pipeline
+        std::unique_ptr<utils::ThreadPool> thread_pool;             ///< Pool persistente dos modos paralelos (declarado antes do scheduler, que o usa)
+        std::unique_ptr<utils::TraceRecorder> trace_recorder;       ///< Linha do tempo (criada com enable_tracing; declarada antes do scheduler, que a usa)
         std::unique_ptr<scheduler::WorkflowScheduler> scheduler;    ///< Scheduler para execução paralela
         utils::Timer timer;                                         ///< Timer para medição de performance
+        std::vector<TokenizedDocument> token_documents;             ///< Documentos tipados das tarefas do scheduler
+        const PipelineManager* workflow_owner = nullptr;            ///< Instância para a qual o workflow do scheduler foi montado (nulo = montar de novo)
         
         // Estatísticas de execução
         mutable double last_parallel_time = 0.0;                   ///< Tempo da última execução paralela
         mutable double last_sequential_time = 0.0;                 ///< Tempo da última execução sequencial
         mutable double last_partitioned_time = 0.0;                ///< Tempo da última execução paralela particionada
+        mutable double last_partitioned_imbalance = 0.0;           ///< Desbalanceamento (máx/média por worker) da última execução particionada
+        mutable double last_streaming_time = 0.0;                  ///< Tempo da última execução em streaming
 
         /**
          * @brief Configura as tarefas no scheduler
@@ -49,6 +78,39 @@ namespace pipeline {
          */
         void setupDependencies(scheduler::WorkflowScheduler* scheduler_ptr);
 
+        /**
+         * @brief Monta e compila o workflow de 8 etapas no scheduler, se ainda não estiver pronto
+         *
+         * O grafo é montado uma vez e reutilizado por todas as execuções de
+         * runParallel; só é remontado após updateConfig, reset ou movimentação
+         * (as tarefas capturam this).
+         *
+         * @return true se o workflow compilado está pronto para execução
+         */
+        bool ensureWorkflow();
+
+        /**
+         * @brief Obtém o pool de threads compartilhado por runParallel, runSequential e runParallelPartitioned
+         *
+         * Criado na primeira execução com max(1, num_workers) threads e recriado
+         * apenas quando o número de workers, a fixação em CPUs ou o spin mudam.
+         *
+         * @return Pool pronto para uso
+         */
+        utils::ThreadPool& workerPool();
+
+        /**
+         * @brief Gravador a usar na execução atual
+         * @return trace_recorder com enable_tracing ligado, senão nullptr
+         */
+        utils::TraceRecorder* activeTraceRecorder() const;
+
+        /**
+         * @brief Cria as etapas do modo streaming, na ordem do grafo de dependências
+         * @return Etapas do pipeline
+         */
+        std::vector<StreamingStage> createStreamingStages() const;
+
         /**
          * @brief Valida os dados de entrada
          * @param input_data Dados a serem validados
@@ -109,11 +171,32 @@ namespace pipeline {
 
         /**
          * @brief Executa o pipeline em modo paralelo com particionamento de dados
+         *
+         * Roda em exatamente num_workers threads do pool; cada worker reivindica
+         * o próximo intervalo de documentos por um cursor atômico, balanceado
+         * pelo custo em bytes (calculateAdaptiveChunkCost). Os intervalos são
+         * processados sobre uma única cópia do corpus, movendo as strings para
+         * o worker e de volta, sem cópias de partição nem de junção. O desbalanceamento
+         * entre os workers vem em PipelineResult::load_imbalance.
+         *
          * @param input_data Dados de entrada
          * @return Resultado da execução
          */
         PipelineResult runParallelPartitioned(const std::vector<std::string>& input_data);
 
+        /**
+         * @brief Executa o pipeline em modo streaming
+         *
+         * Os documentos são divididos em lotes de config.stream_batch_size que
+         * atravessam as etapas concorrentemente (uma thread por etapa), ligadas
+         * por filas de config.stream_queue_capacity lotes. Filas cheias bloqueiam
+         * a etapa anterior, limitando o número de documentos em processamento.
+         *
+         * @param input_data Dados de entrada
+         * @return Resultado da execução, com estatísticas por etapa em stage_stats
+         */
+        PipelineResult runStreaming(const std::vector<std::string>& input_data);
+
         /**
          * @brief Calcula o tamanho ideal de chunk para particionamento
          * @param total_size Tamanho total dos dados
@@ -123,30 +206,62 @@ namespace pipeline {
         size_t calculateOptimalChunkSize(size_t total_size, size_t num_workers);
 
         /**
-         * @brief Particiona os dados em chunks para processamento paralelo
-         * @param data Dados a serem particionados
-         * @param chunk_size Tamanho de cada chunk
-         * @return Vector de chunks
+         * @brief Calcula o custo acumulado dos documentos
+         *
+         * O custo de um documento é o seu tamanho em bytes mais um custo fixo,
+         * de modo que chunks de mesmo custo levem tempos parecidos mesmo com
+         * documentos de tamanhos muito diferentes.
+         *
+         * @param data Documentos
+         * @return data.size() + 1 somas prefixas (prefix[i] = custo dos documentos [0, i))
+         */
+        std::vector<uint64_t> calculateCostPrefix(const std::vector<std::string>& data);
+
+        /**
+         * @brief Calcula o custo do próximo chunk reivindicado no modo particionado
+         *
+         * Metade do custo restante dividida entre os workers (auto-escalonamento
+         * guiado), elevada para que o chunk dure ao menos ~1 ms segundo o tempo
+         * observado por unidade de custo.
+         *
+         * @param remaining_cost Custo dos documentos ainda não reivindicados
+         * @param num_workers Número de workers
+         * @param seconds_per_cost Tempo médio observado por unidade de custo (0 = ainda desconhecido)
+         * @return Custo alvo, entre 1 e remaining_cost (0 se remaining_cost == 0)
          */
-        std::vector<std::vector<std::string>> partitionData(
-            const std::vector<std::string>& data, size_t chunk_size);
+        uint64_t calculateAdaptiveChunkCost(uint64_t remaining_cost, size_t num_workers, double seconds_per_cost);
+
+        /**
+         * @brief Encontra o fim do chunk que começa em begin
+         * @param cost_prefix Somas prefixas de calculateCostPrefix
+         * @param begin Primeiro documento do chunk
+         * @param target_cost Custo alvo do chunk
+         * @param max_chunk_size Máximo de documentos no chunk
+         * @return Fim exclusivo: o menor end com custo >= alvo, com pelo menos 1 e no máximo max_chunk_size documentos
+         */
+        size_t findChunkEnd(const std::vector<uint64_t>& cost_prefix, size_t begin,
+                            uint64_t target_cost, size_t max_chunk_size);
 
         /**
          * @brief Processa um chunk de dados sequencialmente
          * @param chunk_data Dados do chunk
          * @param chunk_id ID do chunk para debug
+         * @param first_index Posição do primeiro documento do chunk no corpus
          * @return Dados processados
          */
         std::vector<std::string> processChunkSequentially(
-            const std::vector<std::string>& chunk_data, size_t chunk_id);
+            const std::vector<std::string>& chunk_data, size_t chunk_id, size_t first_index = 0);
 
         /**
-         * @brief Reconstrói os dados processados a partir dos chunks
-         * @param processed_chunks Chunks processados
-         * @return Dados reconstruídos na ordem original
+         * @brief Processa um chunk sequencialmente, substituindo cada documento pelo resultado
+         *
+         * Usado pelo modo particionado sobre strings movidas do corpus, sem cópias
+         * dos textos.
+         *
+         * @param chunk Documentos do chunk (modificados in-place)
+         * @param first_index Posição do primeiro documento do chunk no corpus
          */
-        std::vector<std::string> mergeProcessedChunks(
-            const std::vector<std::vector<std::string>>& processed_chunks);
+        void processChunkInPlace(std::vector<std::string>& chunk, size_t first_index = 0);
 
         /**
          * @brief Obtém a configuração atual
@@ -162,10 +277,33 @@ namespace pipeline {
 
         /**
          * @brief Obtém estatísticas da última execução
+         *
+         * Inclui as chaves "latency.<TIPO>.*" do scheduler (itens executados e
+         * percentis 50/95/99 da espera na fila e do tempo de execução, em ns)
+         * referentes à última chamada de runParallel.
+         *
          * @return Mapa com estatísticas detalhadas
          */
         std::map<std::string, double> getExecutionStats() const;
 
+        /**
+         * @brief Obtém a linha do tempo gravada
+         *
+         * Com enable_tracing, runParallel e runSequential gravam um evento por
+         * item do scheduler e runParallelPartitioned um por chunk, com as
+         * etapas aninhadas. Os eventos se acumulam entre execuções.
+         *
+         * @return Gravador, ou nullptr se o tracing nunca foi ligado
+         */
+        utils::TraceRecorder* getTraceRecorder() const;
+
+        /**
+         * @brief Exporta a linha do tempo no formato Chrome trace (abre no Perfetto)
+         * @param path Caminho do arquivo JSON
+         * @return true se o arquivo foi gravado
+         */
+        bool writeTrace(const std::string& path) const;
+
         /**
          * @brief Limpa recursos e reinicia o estado
          */
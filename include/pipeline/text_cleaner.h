@@ -0,0 +1,55 @@
+#ifndef PIPELINE_TEXT_CLEANER_H
+#define PIPELINE_TEXT_CLEANER_H
+
+#include <string>
+
+/**
+ * @file text_cleaner.h
+ * @brief Limpeza de texto em passada única
+ *
+ * Substitui a cadeia de std::regex_replace da etapa CleanText por um scanner
+ * escrito à mão: remove tags, decodifica entidades, filtra caracteres,
+ * colapsa espaços e apara as bordas numa única varredura linear, escrevendo
+ * sobre o próprio buffer do texto. A saída é idêntica, byte a byte, à da
+ * cadeia de regex original (ver cleanWithRegex).
+ */
+
+namespace legal_doc_pipeline {
+namespace pipeline {
+
+    /**
+     * @brief Motor de limpeza de texto da etapa CleanText
+     */
+    class TextCleaner {
+    public:
+        /**
+         * @brief Limpa o texto in-place
+         *
+         * A saída nunca é maior que a entrada, então o texto é reescrito no
+         * próprio buffer sem alocações.
+         *
+         * @param text Texto a ser limpo
+         */
+        static void cleanInPlace(std::string& text);
+
+        /**
+         * @brief Limpa uma cópia do texto
+         * @param text Texto original
+         * @return Texto limpo
+         */
+        static std::string clean(const std::string& text);
+
+        /**
+         * @brief Implementação de referência com a cadeia de regex original
+         *
+         * Mantida para testes diferenciais e para o benchmark de limpeza.
+         *
+         * @param text Texto a ser limpo in-place
+         */
+        static void cleanWithRegex(std::string& text);
+    };
+
+} // namespace pipeline
+} // namespace legal_doc_pipeline
+
+#endif // PIPELINE_TEXT_CLEANER_H
@@ -4,13 +4,29 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <atomic>
+#include <mutex>
+#include <functional>
+#include "tokenized_document.h"
 
 /**
  * @file text_processor.h
  * @brief Módulo de processamento de texto
  * 
  * Contém todas as funções de pré-processamento de texto utilizadas
- * no pipeline de documentos jurídicos.
+ * no pipeline de documentos jurídicos. Cada etapa possui uma variante
+ * por intervalo [begin, end), usada pelas tarefas data-parallel do scheduler;
+ * intervalos disjuntos podem ser processados concorrentemente.
+ *
+ * A partir da tokenização por palavras, as etapas também têm variantes sobre
+ * TokenizedDocument, que os modos do PipelineManager encadeiam sem voltar a
+ * serializar os tokens em strings; as variantes em string continuam
+ * disponíveis para uso isolado das etapas.
+ *
+ * As etapas alteram cada documento no próprio buffer ou montam a saída num
+ * buffer por thread, reaproveitado entre documentos, e a copiam de volta:
+ * quando os textos e documentos já têm capacidade (ex.: reutilizados de um
+ * lote anterior), o processamento não faz alocações no heap.
  */
 
 namespace legal_doc_pipeline {
@@ -21,8 +37,9 @@ namespace pipeline {
      */
     class TextProcessor {
     private:
-        static std::map<std::string, int> vocabulary;           ///< Vocabulário para conversão de tokens
-        static bool vocabulary_initialized;                     ///< Flag de inicialização do vocabulário
+        static std::map<std::string, int, std::less<>> vocabulary; ///< Vocabulário (busca heterogênea por string_view)
+        static std::atomic<bool> vocabulary_initialized;        ///< Flag de inicialização do vocabulário
+        static std::mutex vocabulary_mutex;                     ///< Protege a inicialização concorrente do vocabulário
         static const int UNK_TOKEN_ID = 0;                     ///< ID para tokens desconhecidos
 
         /**
@@ -80,8 +97,12 @@ namespace pipeline {
         /**
          * @brief Realiza tokenização BPE (Byte Pair Encoding)
          * @param texts Vetor de textos a serem tokenizados
+         * @param vocab_file Arquivo de vocabulário do tokenizador
+         * @param merges_file Arquivo de merges BPE
          */
-        static void bpeTokenization(std::vector<std::string>& texts);
+        static void bpeTokenization(std::vector<std::string>& texts,
+                                    const std::string& vocab_file = "vocab.txt",
+                                    const std::string& merges_file = "merges.txt");
 
         /**
          * @brief Particiona tokens em sequências de tamanho limitado
@@ -108,6 +129,131 @@ namespace pipeline {
          */
         static void generateEmbeddings(std::vector<std::string>& texts);
 
+        /**
+         * @brief Limpa os textos do intervalo [begin, end)
+         * @param texts Vetor de textos
+         * @param begin Primeiro índice do intervalo
+         * @param end Fim (exclusivo) do intervalo
+         */
+        static void cleanTextRange(std::vector<std::string>& texts, size_t begin, size_t end);
+
+        /**
+         * @brief Normaliza os textos do intervalo [begin, end)
+         * @param texts Vetor de textos
+         * @param begin Primeiro índice do intervalo
+         * @param end Fim (exclusivo) do intervalo
+         */
+        static void normalizeTextRange(std::vector<std::string>& texts, size_t begin, size_t end);
+
+        /**
+         * @brief Tokeniza por palavras os textos do intervalo [begin, end)
+         * @param texts Vetor de textos
+         * @param begin Primeiro índice do intervalo
+         * @param end Fim (exclusivo) do intervalo
+         */
+        static void wordTokenizationRange(std::vector<std::string>& texts, size_t begin, size_t end);
+
+        /**
+         * @brief Aplica a tokenização BPE aos textos do intervalo [begin, end)
+         *
+         * O tokenizador vem do TokenizerRegistry: é carregado uma vez por par
+         * de arquivos e compartilhado entre etapas, chunks e threads.
+         *
+         * @param texts Vetor de textos
+         * @param begin Primeiro índice do intervalo
+         * @param end Fim (exclusivo) do intervalo
+         * @param vocab_file Arquivo de vocabulário do tokenizador
+         * @param merges_file Arquivo de merges BPE
+         */
+        static void bpeTokenizationRange(std::vector<std::string>& texts, size_t begin, size_t end,
+                                         const std::string& vocab_file = "vocab.txt",
+                                         const std::string& merges_file = "merges.txt");
+
+        /**
+         * @brief Trunca as sequências do intervalo [begin, end) em max_length tokens
+         * @param texts Vetor de textos tokenizados
+         * @param begin Primeiro índice do intervalo
+         * @param end Fim (exclusivo) do intervalo
+         * @param max_length Tamanho máximo da sequência
+         */
+        static void partitionTokensRange(std::vector<std::string>& texts, size_t begin, size_t end,
+                                         size_t max_length = 128);
+
+        /**
+         * @brief Adiciona tokens especiais aos textos do intervalo [begin, end)
+         * @param texts Vetor de textos tokenizados
+         * @param begin Primeiro índice do intervalo
+         * @param end Fim (exclusivo) do intervalo
+         */
+        static void addSpecialTokensRange(std::vector<std::string>& texts, size_t begin, size_t end);
+
+        /**
+         * @brief Converte para índices os tokens dos textos do intervalo [begin, end)
+         * @param texts Vetor de textos tokenizados
+         * @param begin Primeiro índice do intervalo
+         * @param end Fim (exclusivo) do intervalo
+         */
+        static void tokensToIndicesRange(std::vector<std::string>& texts, size_t begin, size_t end);
+
+        /**
+         * @brief Gera embeddings simulados para o intervalo [begin, end)
+         * @param texts Vetor de textos com índices
+         * @param begin Primeiro índice do intervalo
+         * @param end Fim (exclusivo) do intervalo
+         * @param index_offset Posição no corpus do primeiro elemento de texts (para lotes)
+         */
+        static void generateEmbeddingsRange(std::vector<std::string>& texts, size_t begin, size_t end,
+                                            size_t index_offset = 0);
+
+        /**
+         * @brief Tokeniza por palavras os textos de [begin, end) em documentos tipados
+         * @param texts Textos normalizados (não são modificados)
+         * @param documents Documentos de saída (mesmo tamanho de texts)
+         * @param begin Primeiro índice do intervalo
+         * @param end Fim (exclusivo) do intervalo
+         */
+        static void wordTokenizationRange(const std::vector<std::string>& texts,
+                                          std::vector<TokenizedDocument>& documents,
+                                          size_t begin, size_t end);
+
+        /**
+         * @brief Aplica a tokenização BPE aos documentos de [begin, end)
+         * @param documents Documentos tokenizados por palavras
+         * @param begin Primeiro índice do intervalo
+         * @param end Fim (exclusivo) do intervalo
+         * @param vocab_file Arquivo de vocabulário do tokenizador (compartilhado via TokenizerRegistry)
+         * @param merges_file Arquivo de merges BPE
+         */
+        static void bpeTokenizationRange(std::vector<TokenizedDocument>& documents, size_t begin, size_t end,
+                                         const std::string& vocab_file = "vocab.txt",
+                                         const std::string& merges_file = "merges.txt");
+
+        /**
+         * @brief Trunca os documentos de [begin, end) em max_length tokens
+         * @param documents Documentos tokenizados
+         * @param begin Primeiro índice do intervalo
+         * @param end Fim (exclusivo) do intervalo
+         * @param max_length Tamanho máximo da sequência
+         */
+        static void partitionTokensRange(std::vector<TokenizedDocument>& documents, size_t begin, size_t end,
+                                         size_t max_length = 128);
+
+        /**
+         * @brief Adiciona tokens especiais aos documentos de [begin, end)
+         * @param documents Documentos tokenizados
+         * @param begin Primeiro índice do intervalo
+         * @param end Fim (exclusivo) do intervalo
+         */
+        static void addSpecialTokensRange(std::vector<TokenizedDocument>& documents, size_t begin, size_t end);
+
+        /**
+         * @brief Preenche os IDs dos documentos de [begin, end) a partir do vocabulário
+         * @param documents Documentos tokenizados
+         * @param begin Primeiro índice do intervalo
+         * @param end Fim (exclusivo) do intervalo
+         */
+        static void tokensToIndicesRange(std::vector<TokenizedDocument>& documents, size_t begin, size_t end);
+
         /**
          * @brief Obtém estatísticas do vocabulário
          * @return Mapa com estatísticas (tamanho, tokens mais comuns, etc.)
@@ -0,0 +1,181 @@
+#ifndef PIPELINE_TOKENIZED_DOCUMENT_H
+#define PIPELINE_TOKENIZED_DOCUMENT_H
+
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file tokenized_document.h
+ * @brief Representação tipada de um documento tokenizado
+ *
+ * As etapas de WordTokenization a TokensToIndices trocam documentos nesta
+ * forma em vez de strings com tokens separados por espaço: o texto dos tokens
+ * fica num pool contíguo, cada token é um intervalo (offset, tamanho) desse
+ * pool e os IDs ficam num vetor de inteiros. Conversões de/para string só
+ * acontecem nas bordas (fromString/toString/idsToString).
+ *
+ * Os três buffers usam o std::pmr::memory_resource passado na construção;
+ * os modos em lote passam uma utils::ArenaResource, liberada de uma vez no
+ * fim de cada lote. Cópias usam o recurso padrão (new/delete).
+ */
+
+namespace legal_doc_pipeline {
+namespace pipeline {
+
+    /**
+     * @brief Intervalo de um token dentro do pool do documento
+     */
+    struct TokenSpan {
+        uint32_t offset = 0;   ///< Posição do primeiro byte no pool
+        uint32_t length = 0;   ///< Tamanho do token em bytes
+    };
+
+    /**
+     * @brief Documento como sequência de tokens e, após TokensToIndices, de IDs
+     */
+    class TokenizedDocument {
+    private:
+        std::pmr::string pool;               ///< Bytes de todos os tokens, concatenados
+        std::pmr::vector<TokenSpan> spans;   ///< Tokens, na ordem do documento
+        std::pmr::vector<int> ids;           ///< IDs dos tokens (vazio até TokensToIndices)
+
+    public:
+        /**
+         * @brief Construtor
+         * @param resource Recurso de memória dos tokens e IDs
+         */
+        explicit TokenizedDocument(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : pool(resource), spans(resource), ids(resource) {}
+
+        /**
+         * @brief Obtém o recurso de memória do documento
+         * @return Recurso passado na construção
+         */
+        std::pmr::memory_resource* memoryResource() const { return pool.get_allocator().resource(); }
+
+        /**
+         * @brief Remove tokens e IDs mantendo a memória alocada para reuso
+         */
+        void clear();
+
+        /**
+         * @brief Remove tokens e IDs devolvendo a memória ao recurso
+         *
+         * Deve ser chamado antes de liberar a arena do documento.
+         */
+        void releaseMemory();
+
+        /**
+         * @brief Reserva espaço para evitar realocações ao adicionar tokens
+         * @param pool_bytes Bytes de texto esperados
+         * @param tokens Número de tokens esperado
+         */
+        void reserve(size_t pool_bytes, size_t tokens);
+
+        /**
+         * @brief Adiciona um token ao final do documento
+         * @param token Texto do token (copiado para o pool)
+         */
+        void addToken(std::string_view token);
+
+        /**
+         * @brief Insere um token antes da posição indicada
+         * @param index Posição do novo token (size() insere no final)
+         * @param token Texto do token
+         */
+        void insertToken(size_t index, std::string_view token);
+
+        /**
+         * @brief Mantém apenas os primeiros max_tokens tokens (e IDs)
+         * @param max_tokens Número máximo de tokens
+         */
+        void truncate(size_t max_tokens);
+
+        /**
+         * @brief Obtém o texto de um token
+         * @param index Posição do token
+         * @return View para o texto no pool (válida até a próxima modificação)
+         */
+        std::string_view token(size_t index) const {
+            const TokenSpan& span = spans[index];
+            return std::string_view(pool.data() + span.offset, span.length);
+        }
+
+        /**
+         * @brief Procura a primeira ocorrência de um token
+         * @param text Texto procurado
+         * @return Posição do token ou size() se não encontrado
+         */
+        size_t findToken(std::string_view text) const;
+
+        /**
+         * @brief Obtém o número de tokens
+         * @return Número de tokens
+         */
+        size_t size() const { return spans.size(); }
+
+        /**
+         * @brief Verifica se o documento não tem tokens
+         * @return true se vazio
+         */
+        bool empty() const { return spans.empty(); }
+
+        /**
+         * @brief Obtém os IDs dos tokens
+         * @return Referência para o vetor de IDs
+         */
+        const std::pmr::vector<int>& getIds() const { return ids; }
+
+        /**
+         * @brief Define os IDs dos tokens
+         * @return Referência mutável para o vetor de IDs
+         */
+        std::pmr::vector<int>& mutableIds() { return ids; }
+
+        /**
+         * @brief Copia tokens e IDs de outro documento
+         *
+         * Mantém o recurso de memória deste documento e reaproveita a sua
+         * capacidade: não aloca quando o conteúdo cabe nos buffers atuais.
+         *
+         * @param other Documento de origem
+         */
+        void assign(const TokenizedDocument& other);
+
+        /**
+         * @brief Troca o conteúdo com outro documento
+         *
+         * Sem cópias quando os dois usam o mesmo recurso de memória; caso
+         * contrário, cada documento copia o conteúdo do outro para o seu recurso.
+         *
+         * @param other Documento a ser trocado
+         */
+        void swap(TokenizedDocument& other);
+
+        /**
+         * @brief Cria um documento a partir de tokens separados por espaço em branco
+         * @param text Texto com tokens separados por espaço
+         * @return Documento tokenizado
+         */
+        static TokenizedDocument fromString(std::string_view text);
+
+        /**
+         * @brief Formata os tokens separados por um espaço
+         * @return Texto equivalente ao formato de string das etapas
+         */
+        std::string toString() const;
+
+        /**
+         * @brief Formata os IDs em decimal separados por um espaço
+         * @return Texto equivalente à saída em string de TokensToIndices
+         */
+        std::string idsToString() const;
+    };
+
+} // namespace pipeline
+} // namespace legal_doc_pipeline
+
+#endif // PIPELINE_TOKENIZED_DOCUMENT_H
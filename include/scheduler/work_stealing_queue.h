@@ -0,0 +1,81 @@
+#ifndef SCHEDULER_WORK_STEALING_QUEUE_H
+#define SCHEDULER_WORK_STEALING_QUEUE_H
+
+#include "../types.h"
+#include <deque>
+#include <mutex>
+
+/**
+ * @file work_stealing_queue.h
+ * @brief Deque de tarefas por worker com suporte a roubo de trabalho
+ *
+ * Cada worker possui sua própria deque: o dono insere e remove pelo fundo
+ * (localidade das tarefas sucessoras) e os demais workers roubam pelo topo.
+ * A ordenação por prioridade é respeitada dentro de uma janela limitada.
+ */
+
+namespace legal_doc_pipeline {
+namespace scheduler {
+
+    /**
+     * @brief Deque de tarefas prontas pertencente a um único worker
+     */
+    class WorkStealingQueue {
+    private:
+        mutable std::mutex deque_mutex;   ///< Mutex local (disputado apenas pelo dono e ladrões)
+        std::deque<WorkItem> items;       ///< Itens prontos (fundo = mais recentes)
+        size_t priority_window;           ///< Quantidade de itens inspecionados por prioridade
+
+    public:
+        /**
+         * @brief Construtor
+         * @param priority_window Número de itens considerados ao escolher a tarefa de maior prioridade
+         */
+        explicit WorkStealingQueue(size_t priority_window = 8);
+
+        /**
+         * @brief Insere um item no fundo da deque (operação do dono)
+         * @param item Item pronto para execução
+         */
+        void push(const WorkItem& item);
+
+        /**
+         * @brief Remove o item de maior prioridade entre os mais recentes (operação do dono)
+         * @param item Recebe o item removido
+         * @return true se um item foi obtido
+         */
+        bool pop(WorkItem& item);
+
+        /**
+         * @brief Rouba o item de maior prioridade entre os mais antigos (operação de outro worker)
+         * @param item Recebe o item roubado
+         * @return true se um item foi obtido
+         */
+        bool steal(WorkItem& item);
+
+        /**
+         * @brief Obtém o número de itens na deque
+         * @return Número de itens
+         */
+        size_t size() const;
+
+        /**
+         * @brief Verifica se a deque está vazia
+         * @return true se não há itens
+         */
+        bool empty() const;
+
+        /**
+         * @brief Remove todos os itens da deque
+         */
+        void clear();
+
+        // Desabilita cópia e atribuição
+        WorkStealingQueue(const WorkStealingQueue&) = delete;
+        WorkStealingQueue& operator=(const WorkStealingQueue&) = delete;
+    };
+
+} // namespace scheduler
+} // namespace legal_doc_pipeline
+
+#endif // SCHEDULER_WORK_STEALING_QUEUE_H
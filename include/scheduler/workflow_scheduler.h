@@ -2,12 +2,18 @@
 #define SCHEDULER_WORKFLOW_SCHEDULER_H
 
 #include "../types.h"
+#include "work_stealing_queue.h"
+#include "../utils/latency_histogram.h"
+#include <chrono>
 #include <map>
+#include <memory>
 #include <queue>
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
 #include <thread>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 /**
@@ -15,19 +21,83 @@
  * @brief Scheduler de workflow baseado em grafo de dependências
  * 
  * Implementa um scheduler que executa tarefas respeitando suas dependências
- * e prioridades, usando um pool de threads trabalhadoras.
+ * e prioridades, usando um pool de threads trabalhadoras. Suporta dois modos:
+ * fila de prioridade global ou deques por worker com roubo de tarefas.
+ *
+ * As tarefas recebem um TaskId denso em addTask; antes da execução as arestas
+ * são compiladas em vetores CSR (offsets + alvos), de modo que concluir uma
+ * tarefa percorre um trecho contíguo de inteiros, sem buscas por string nem
+ * alocações. A API por nome é só uma camada sobre os IDs.
+ *
+ * O grafo compilado fica congelado: compile() valida e ordena
+ * topologicamente uma única vez, e execuções seguintes de run() só
+ * reiniciam os contadores por tarefa. Adicionar tarefas ou arestas
+ * descongela o grafo, que é recompilado na próxima execução.
+ *
+ * Cada item executado gera um TaskExecutionRecord (worker, espera na fila,
+ * início e fim), gravado num vetor por worker sem sincronização. Os
+ * histogramas por TaskType são montados sob demanda a partir desses registros.
+ * Com um utils::TraceRecorder associado, os mesmos instantes viram eventos
+ * da linha do tempo (Chrome trace), sem leituras de relógio adicionais.
  */
 
 namespace legal_doc_pipeline {
+namespace utils {
+    class ThreadPool;
+    class TraceRecorder;
+}
+
 namespace scheduler {
 
+    /**
+     * @brief Execução de um item (tarefa inteira ou intervalo de uma tarefa data-parallel)
+     *
+     * Os instantes são nanossegundos desde o início da execução (run()).
+     */
+    struct TaskExecutionRecord {
+        TaskId task = INVALID_TASK_ID;           ///< Tarefa executada
+        TaskType type = TaskType::TEXT_CLEANING; ///< Tipo da tarefa
+        size_t begin = 0;                        ///< Primeiro documento do intervalo
+        size_t end = 0;                          ///< Fim (exclusivo) do intervalo
+        size_t worker = 0;                       ///< Índice do worker que executou o item
+        int64_t ready_ns = 0;                    ///< Item ficou pronto (entrou na fila)
+        int64_t start_ns = 0;                    ///< Início da execução
+        int64_t end_ns = 0;                      ///< Fim da execução
+
+        /**
+         * @brief Tempo entre ficar pronto e começar a executar
+         */
+        int64_t queueWaitNs() const { return start_ns - ready_ns; }
+
+        /**
+         * @brief Tempo de execução
+         */
+        int64_t runNs() const { return end_ns - start_ns; }
+    };
+
+    /**
+     * @brief Latências de todos os itens de um tipo de tarefa
+     */
+    struct TaskLatencyStats {
+        utils::LatencyHistogram queue_wait;   ///< Espera na fila (ns)
+        utils::LatencyHistogram run_time;     ///< Tempo de execução (ns)
+    };
+
     /**
      * @brief Scheduler de workflow com execução paralela baseada em grafo
      */
     class WorkflowScheduler {
     private:
-        std::map<std::string, Task> tasks;                              ///< Mapa de todas as tarefas por ID
-        std::priority_queue<Task*, std::vector<Task*>, TaskPtrCompare> ready_queue; ///< Fila de tarefas prontas
+        std::vector<Task> tasks;                                        ///< Tarefas indexadas por TaskId
+        std::unordered_map<std::string, TaskId> task_ids;               ///< Nome da tarefa -> TaskId
+        std::vector<std::pair<TaskId, TaskId>> edges;                   ///< Arestas (dependência, dependente) na ordem de inserção
+        std::vector<uint32_t> dependent_offsets;                        ///< CSR: sucessores de t em dependent_targets[offsets[t], offsets[t+1])
+        std::vector<TaskId> dependent_targets;                          ///< CSR: sucessores concatenados
+        std::vector<int> dependency_counts;                             ///< Número de predecessores de cada tarefa
+        std::vector<TaskId> topological_order;                          ///< Ordem topológica calculada por compile()
+        std::vector<TaskId> root_tasks;                                 ///< Tarefas sem predecessores (prontas no início)
+        bool graph_compiled;                                            ///< true se o grafo está compilado e validado (congelado)
+        std::priority_queue<WorkItem, std::vector<WorkItem>, WorkItemCompare> ready_queue; ///< Fila de itens prontos
         std::mutex queue_mutex;                                         ///< Mutex para proteger acesso às estruturas
         std::condition_variable cv_tasks_ready;                         ///< Condição para sinalizar tarefas prontas
         std::atomic<size_t> completed_task_count;                       ///< Contador de tarefas concluídas
@@ -35,17 +105,113 @@ namespace scheduler {
         std::vector<std::thread> workers;                               ///< Pool de threads trabalhadoras
         std::atomic<bool> shutdown_requested;                           ///< Flag para shutdown gracioso
         std::atomic<bool> has_dependency_errors;                        ///< Flag para erros de dependência
+        SchedulingMode mode;                                            ///< Estratégia de distribuição das tarefas
+        std::vector<std::unique_ptr<WorkStealingQueue>> worker_queues;  ///< Deques por worker (modo WORK_STEALING)
+        std::atomic<size_t> pending_ready_items;                        ///< Itens prontos nas deques (modo WORK_STEALING)
+        std::atomic<size_t> sleeping_workers;                           ///< Workers bloqueados aguardando tarefas (alterado sob queue_mutex)
+        std::atomic<size_t> stolen_task_count;                          ///< Itens obtidos por roubo
+        size_t active_worker_count;                                     ///< Workers da execução atual (define a granularidade)
+        utils::ThreadPool* thread_pool;                                 ///< Pool persistente (não possuído); nullptr = threads por execução
+        std::atomic<bool> pool_run_active;                              ///< true enquanto uma execução roda no pool
+        std::chrono::steady_clock::time_point run_start;                ///< Início da execução atual (origem dos registros)
+        std::vector<std::vector<TaskExecutionRecord>> worker_records;   ///< Registros de execução por worker
+        utils::TraceRecorder* trace_recorder;                           ///< Gravador da linha do tempo (não possuído); nullptr = desligado
+        int64_t trace_offset_ns;                                        ///< Início da execução na escala do trace
+
+        /**
+         * @brief Nanossegundos desde o início da execução atual
+         */
+        int64_t elapsedNanoseconds() const {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - run_start).count();
+        }
 
         /**
          * @brief Função executada por cada thread trabalhadora
+         * @param worker_index Índice do worker (dono de worker_records[worker_index])
+         */
+        void workerThread(size_t worker_index);
+
+        /**
+         * @brief Função executada por cada thread trabalhadora no modo WORK_STEALING
+         * @param worker_index Índice do worker (dono de worker_queues[worker_index])
+         */
+        void workStealingWorkerThread(size_t worker_index);
+
+        /**
+         * @brief Divide uma tarefa pronta em itens de execução e inicializa seu contador de sub-tarefas
+         *
+         * Um item para tarefas comuns; um item por intervalo de documentos para tarefas data-parallel.
+         *
+         * @param task Tarefa que acabou de ficar pronta
+         * @param items Recebe os itens, acrescentados ao final
+         * @return Número de itens gerados
+         */
+        size_t splitIntoWorkItems(Task& task, std::vector<WorkItem>& items);
+
+        /**
+         * @brief Reinicia o estado por execução: contadores de dependências e de sub-tarefas
+         */
+        void resetRunState();
+
+        /**
+         * @brief Obtém o TaskId de uma tarefa
+         * @param task Tarefa pertencente a este scheduler
+         * @return Índice da tarefa em tasks
+         */
+        TaskId idOf(const Task& task) const {
+            return static_cast<TaskId>(&task - tasks.data());
+        }
+
+        /**
+         * @brief Executa a operação da tarefa sobre o intervalo do item e registra a execução
+         * @param item Item a ser executado
+         * @param worker_index Worker que executa o item
+         */
+        void executeWorkItem(const WorkItem& item, size_t worker_index);
+
+        /**
+         * @brief Contabiliza a conclusão de um item
+         * @param item Item concluído
+         * @return true se era o último item pendente da tarefa
+         */
+        bool finishWorkItem(const WorkItem& item);
+
+        /**
+         * @brief Obtém um item da deque local ou rouba de outro worker
+         * @param worker_index Índice do worker solicitante
+         * @param item Recebe o item obtido
+         * @return true se um item foi obtido
+         */
+        bool acquireWorkItem(size_t worker_index, WorkItem& item);
+
+        /**
+         * @brief Insere os itens de uma tarefa pronta na deque de um worker e acorda workers ociosos
+         * @param task Tarefa pronta
+         * @param worker_index Índice da deque de destino
          */
-        void workerThread();
+        void pushReadyTask(Task* task, size_t worker_index);
 
         /**
-         * @brief Marca uma tarefa como concluída e atualiza dependências
-         * @param task_id ID da tarefa concluída
+         * @brief Marca uma tarefa como concluída e libera os sucessores (modo GLOBAL_QUEUE)
+         *
+         * A prontidão é detectada com fetch_sub no contador de dependências, sem o
+         * mutex global; o lock só protege a inserção no heap. Em vez de voltar a
+         * esperar na fila, o worker que concluiu a tarefa recebe o item de maior
+         * prioridade, e apenas um worker adormecido é acordado por item restante.
+         *
+         * @param completed_task Tarefa concluída
+         * @param next_item Recebe o item repassado ao worker que concluiu a tarefa
+         * @return true se next_item foi preenchido
          */
-        void markTaskCompleted(const std::string& task_id);
+        bool markTaskCompleted(Task& completed_task, WorkItem& next_item);
+
+        /**
+         * @brief Marca uma tarefa como concluída sem o mutex global (modo WORK_STEALING)
+         * @param completed_task Tarefa concluída
+         * @param worker_index Worker que executou a tarefa; recebe os sucessores prontos
+         */
+        void markTaskCompletedLocal(Task& completed_task, size_t worker_index);
 
         /**
          * @brief Inicializa a fila de tarefas prontas
@@ -55,8 +221,9 @@ namespace scheduler {
     public:
         /**
          * @brief Construtor
+         * @param mode Estratégia de distribuição das tarefas prontas
          */
-        WorkflowScheduler();
+        explicit WorkflowScheduler(SchedulingMode mode = SchedulingMode::GLOBAL_QUEUE);
 
         /**
          * @brief Destrutor
@@ -66,8 +233,9 @@ namespace scheduler {
         /**
          * @brief Adiciona uma tarefa ao scheduler
          * @param task Tarefa a ser adicionada
+         * @return TaskId da tarefa (se o nome já existe, o ID da tarefa existente, que é mantida)
          */
-        void addTask(const Task& task);
+        TaskId addTask(const Task& task);
 
         /**
          * @brief Adiciona uma dependência entre tarefas
@@ -77,14 +245,100 @@ namespace scheduler {
          */
         bool addDependency(const std::string& task_id, const std::string& dependency_id);
 
+        /**
+         * @brief Adiciona uma dependência entre tarefas pelos IDs numéricos
+         * @param task_id Tarefa dependente
+         * @param dependency_id Tarefa da qual depende
+         * @return true se os dois IDs existem
+         */
+        bool addDependency(TaskId task_id, TaskId dependency_id);
+
+        /**
+         * @brief Obtém o TaskId associado a um nome de tarefa
+         * @param name Nome (Task::id) da tarefa
+         * @return TaskId, ou INVALID_TASK_ID se não existe
+         */
+        TaskId getTaskId(const std::string& name) const;
+
+        /**
+         * @brief Obtém o número de tarefas registradas
+         * @return Número de tarefas
+         */
+        size_t getTaskCount() const;
+
+        /**
+         * @brief Obtém o número de tarefas concluídas na última execução
+         *
+         * Consulta barata, sem montar os histogramas de getExecutionStats.
+         *
+         * @return Número de tarefas concluídas
+         */
+        size_t getCompletedTaskCount() const;
+
+        /**
+         * @brief Compila e congela o grafo: CSR, validação e ordem topológica
+         *
+         * Chamado automaticamente por run(); chamadas repetidas sem alterações
+         * no grafo não fazem nada.
+         *
+         * @return true se o grafo é válido (sem dependências inválidas nem ciclos)
+         */
+        bool compile();
+
+        /**
+         * @brief Verifica se o grafo está compilado e congelado
+         * @return true se compile() teve sucesso e nada foi adicionado depois
+         */
+        bool isCompiled() const;
+
+        /**
+         * @brief Obtém a ordem topológica calculada na compilação
+         * @return TaskIds em ordem topológica (vazio se o grafo não está compilado)
+         */
+        const std::vector<TaskId>& getTopologicalOrder() const;
+
         /**
          * @brief Executa o workflow com o número especificado de workers
          * @param input_data Dados de entrada para processamento
-         * @param num_workers Número de threads trabalhadoras
+         * @param num_workers Número de threads trabalhadoras (valores menores que 1 usam 1)
          * @return true se a execução foi bem-sucedida
          */
         bool run(const std::vector<std::string>& input_data, int num_workers = 4);
 
+        /**
+         * @brief Usa um pool de threads persistente nas próximas execuções
+         *
+         * Cada worker vira um job do pool, então run() deixa de criar e destruir
+         * threads. Com menos threads no pool que num_workers, os workers
+         * excedentes só começam quando os primeiros terminam (o resultado é o
+         * mesmo, com menos paralelismo). O pool deve viver mais que o scheduler.
+         *
+         * @param pool Pool a usar, ou nullptr para voltar às threads por execução
+         */
+        void setThreadPool(utils::ThreadPool* pool);
+
+        /**
+         * @brief Grava cada item executado como evento da linha do tempo nas próximas execuções
+         *
+         * O evento leva o nome da tarefa, a categoria "scheduler" e o intervalo
+         * de documentos. O gravador deve viver mais que o scheduler.
+         *
+         * @param recorder Gravador a usar, ou nullptr para desligar
+         */
+        void setTraceRecorder(utils::TraceRecorder* recorder);
+
+        /**
+         * @brief Define a estratégia de distribuição de tarefas (aplicada na próxima execução)
+         * @param new_mode Nova estratégia
+         */
+        void setSchedulingMode(SchedulingMode new_mode);
+
+        /**
+         * @brief Obtém a estratégia de distribuição de tarefas
+         * @return Estratégia atual
+         */
+        SchedulingMode getSchedulingMode() const;
+
         /**
          * @brief Para a execução do scheduler graciosamente
          */
@@ -98,10 +352,36 @@ namespace scheduler {
 
         /**
          * @brief Obtém estatísticas de execução
+         *
+         * Além dos contadores, traz para cada tipo de tarefa executado o número
+         * de itens ("latency.<TIPO>.items") e os percentis 50/95/99 da espera
+         * na fila e do tempo de execução, em nanossegundos.
+         *
          * @return Mapa com estatísticas
          */
         std::map<std::string, size_t> getExecutionStats() const;
 
+        /**
+         * @brief Obtém os registros de execução da última execução
+         *
+         * Um registro por item executado (tarefas data-parallel geram um por
+         * intervalo), em ordem de início. Deve ser chamado fora de run().
+         *
+         * @return Registros ordenados por start_ns
+         */
+        std::vector<TaskExecutionRecord> getExecutionRecords() const;
+
+        /**
+         * @brief Obtém os histogramas de latência por tipo de tarefa da última execução
+         *
+         * Os percentis p50/p95/p99 também aparecem em getExecutionStats, nas
+         * chaves "latency.<TIPO>.queue_wait_p50_ns", "latency.<TIPO>.run_p99_ns" etc.
+         * Deve ser chamado fora de run().
+         *
+         * @return Estatísticas por tipo (só tipos com itens executados)
+         */
+        std::map<TaskType, TaskLatencyStats> getTaskLatencyStats() const;
+
         /**
          * @brief Verifica se o scheduler está rodando
          * @return true se o scheduler está ativo
@@ -115,6 +395,10 @@ namespace scheduler {
 
         /**
          * @brief Valida a consistência do grafo de dependências
+         *
+         * Usa o algoritmo de Kahn (ordenação topológica iterativa), sem recursão,
+         * o que comporta grafos com centenas de milhares de tarefas.
+         *
          * @return true se o grafo é válido (sem ciclos)
          */
         bool validateDependencyGraph() const;
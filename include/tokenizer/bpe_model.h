@@ -0,0 +1,158 @@
+#ifndef TOKENIZER_BPE_MODEL_H
+#define TOKENIZER_BPE_MODEL_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @file bpe_model.h
+ * @brief Modelo BPE em nível de byte carregado de vocab.txt e merges.txt
+ *
+ * Formato dos arquivos (o mesmo gravado por save()):
+ * - vocab.txt: um token por linha; o ID é o número da linha (a partir de 0)
+ * - merges.txt: um par "esquerda direita" por linha; a ordem define o rank
+ *   (linhas iniciadas por "#version" são ignoradas)
+ *
+ * Os tokens usam o alfabeto de bytes do GPT-2: cada byte é representado por
+ * um caractere Unicode imprimível, então espaços e bytes UTF-8 incompletos
+ * nunca aparecem crus nos arquivos. A saída de encodeWord traz os bytes
+ * originais de cada token.
+ *
+ * A codificação de uma palavra mantém os símbolos numa lista ligada e os
+ * pares adjacentes numa fila de prioridade por rank, aplicando sempre o merge
+ * de menor rank (o mais à esquerda em caso de empate): O(n log n) por palavra.
+ * Palavras já codificadas ficam num cache particionado em shards com mutex
+ * próprio, para uso concorrente.
+ */
+
+namespace hf_tokenizers {
+
+    /**
+     * @brief Token produzido pelo modelo BPE
+     */
+    struct BpeToken {
+        unsigned int id;      ///< ID no vocabulário
+        std::string_view text; ///< Bytes originais do token (válidos enquanto o modelo existir)
+    };
+
+    /**
+     * @brief Modelo BPE com cache de palavras
+     */
+    class BpeModel {
+    private:
+        static constexpr size_t CACHE_SHARDS = 16;              ///< Shards do cache de palavras
+        static constexpr size_t CACHE_ENTRIES_PER_SHARD = 8192; ///< Limite de palavras por shard
+
+        /**
+         * @brief Partição do cache com seu próprio mutex
+         */
+        struct CacheShard {
+            std::mutex mutex;
+            std::unordered_map<std::string, std::vector<unsigned int>> words;
+        };
+
+        std::unordered_map<std::string, unsigned int> token_to_id; ///< Token (alfabeto de bytes) -> ID
+        std::vector<std::string> id_to_bytes;                      ///< ID -> bytes originais do token
+        std::unordered_map<uint64_t, std::pair<uint32_t, unsigned int>> merge_ranks; ///< (esq, dir) -> (rank, ID do resultado)
+        std::array<unsigned int, 256> byte_ids{};                  ///< ID do token de cada byte
+        unsigned int unknown_id = 0;                               ///< ID usado para bytes fora do vocabulário
+        size_t merge_count = 0;                                    ///< Merges carregados
+        mutable std::array<CacheShard, CACHE_SHARDS> cache;        ///< Cache palavra -> IDs
+
+        /**
+         * @brief Aplica os merges aos bytes da palavra
+         * @param word Palavra
+         * @param ids Recebe os IDs dos tokens
+         */
+        void mergeWord(std::string_view word, std::vector<unsigned int>& ids) const;
+
+    public:
+        BpeModel() = default;
+        BpeModel(const BpeModel&) = delete;
+        BpeModel& operator=(const BpeModel&) = delete;
+
+        /**
+         * @brief Carrega o vocabulário e os merges
+         * @param vocab_path Caminho do vocab.txt
+         * @param merges_path Caminho do merges.txt
+         * @return true se os dois arquivos foram lidos e o vocabulário não está vazio
+         */
+        bool load(const std::string& vocab_path, const std::string& merges_path);
+
+        /**
+         * @brief Carrega o modelo a partir de listas já em memória
+         * @param vocab Tokens no alfabeto de bytes, na ordem dos IDs
+         * @param merges Pares de merge em ordem de rank
+         */
+        void load(const std::vector<std::string>& vocab,
+                  const std::vector<std::pair<std::string, std::string>>& merges);
+
+        /**
+         * @brief Codifica uma palavra
+         * @param word Bytes da palavra (sem separadores)
+         * @param tokens Recebe os tokens, acrescentados ao final
+         */
+        void encodeWord(std::string_view word, std::vector<BpeToken>& tokens) const;
+
+        /**
+         * @brief Obtém o número de tokens do vocabulário
+         * @return Tamanho do vocabulário
+         */
+        size_t vocabularySize() const { return id_to_bytes.size(); }
+
+        /**
+         * @brief Obtém o número de merges carregados
+         * @return Merges com resultado presente no vocabulário
+         */
+        size_t mergeCount() const { return merge_count; }
+
+        /**
+         * @brief Obtém o número de palavras no cache
+         * @return Soma das entradas de todos os shards
+         */
+        size_t cachedWords() const;
+
+        /**
+         * @brief Converte bytes para o alfabeto de bytes do GPT-2
+         * @param bytes Bytes originais
+         * @return Texto com um caractere imprimível por byte
+         */
+        static std::string toByteAlphabet(std::string_view bytes);
+
+        /**
+         * @brief Treina um vocabulário BPE a partir de contagens de palavras
+         *
+         * Começa com os 256 bytes (mais os tokens especiais) e aplica, a cada
+         * passo, o merge do par adjacente mais frequente até atingir vocab_size.
+         *
+         * @param word_counts Palavra -> frequência
+         * @param vocab_size Tamanho desejado do vocabulário
+         * @param special_tokens Tokens colocados no início do vocabulário
+         * @param vocab Recebe os tokens no alfabeto de bytes
+         * @param merges Recebe os merges em ordem de rank
+         */
+        static void train(const std::map<std::string, size_t>& word_counts, size_t vocab_size,
+                          const std::vector<std::string>& special_tokens,
+                          std::vector<std::string>& vocab,
+                          std::vector<std::pair<std::string, std::string>>& merges);
+
+        /**
+         * @brief Grava vocabulário e merges no formato lido por load()
+         * @return true se os dois arquivos foram gravados
+         */
+        static bool save(const std::string& vocab_path, const std::string& merges_path,
+                         const std::vector<std::string>& vocab,
+                         const std::vector<std::pair<std::string, std::string>>& merges);
+    };
+
+} // namespace hf_tokenizers
+
+#endif // TOKENIZER_BPE_MODEL_H
@@ -0,0 +1,133 @@
+#ifndef TOKENIZER_DOUBLE_ARRAY_TRIE_H
+#define TOKENIZER_DOUBLE_ARRAY_TRIE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @file double_array_trie.h
+ * @brief Trie de vetor duplo (double-array) para o vocabulário do tokenizador
+ *
+ * O vocabulário é compilado em dois vetores paralelos, base e check: a
+ * transição do estado s pelo byte c vai para t = base[s] + c e só é válida se
+ * check[t] == s. A busca do maior prefixo do vocabulário é uma única varredura
+ * para frente sobre os bytes da palavra, sem alocações nem comparações de
+ * strings.
+ */
+
+namespace hf_tokenizers {
+
+    /**
+     * @brief Autômato de vocabulário com busca de maior prefixo
+     */
+    class DoubleArrayTrie {
+    private:
+        /**
+         * @brief Estado do autômato; base e check ficam juntos na mesma linha de cache
+         */
+        struct Unit {
+            int32_t base = 0;    ///< Deslocamento dos filhos deste estado
+            int32_t check = -1;  ///< Estado pai (-1 = posição livre)
+        };
+
+        std::vector<Unit> units;         ///< Estados indexados pela posição
+        std::vector<int64_t> values;     ///< ID do token que termina no estado (-1 = nenhum)
+        size_t key_count = 0;            ///< Número de chaves armazenadas
+
+        // Lista duplamente ligada das posições livres, usada apenas durante build()
+        std::vector<int32_t> free_next;  ///< Próxima posição livre (-1 = fim)
+        std::vector<int32_t> free_prev;  ///< Posição livre anterior (-1 = início)
+        int32_t free_head = -1;          ///< Primeira posição livre
+        int32_t free_tail = -1;          ///< Última posição livre
+
+        /**
+         * @brief Marca a posição como ocupada pelo filho de parent
+         */
+        void occupy(int32_t position, int32_t parent);
+
+        /**
+         * @brief Insere os filhos do estado para as chaves [begin, end), todas com o mesmo prefixo de tamanho depth
+         */
+        void buildNode(const std::vector<std::pair<std::string, unsigned int>>& entries,
+                       size_t begin, size_t end, size_t depth, int32_t state);
+
+        /**
+         * @brief Escolhe uma base em que todos os rótulos caiam em posições livres
+         */
+        int32_t findBase(const std::vector<unsigned char>& labels);
+
+        /**
+         * @brief Garante que o vetor de estados tenha pelo menos size posições
+         */
+        void ensureSize(size_t size);
+
+    public:
+        /**
+         * @brief Compila o vocabulário, substituindo o conteúdo anterior
+         *
+         * Chaves vazias são ignoradas; para chaves repetidas vale a primeira.
+         *
+         * @param entries Pares (token, id)
+         */
+        void build(std::vector<std::pair<std::string, unsigned int>> entries);
+
+        /**
+         * @brief Procura o maior token do vocabulário que é prefixo do texto
+         * @param data Início do texto
+         * @param size Tamanho do texto
+         * @param length Recebe o tamanho do prefixo encontrado
+         * @param id Recebe o ID do token
+         * @return true se algum prefixo está no vocabulário
+         */
+        bool longestPrefix(const char* data, size_t size, size_t& length, unsigned int& id) const {
+            if (units.empty()) {
+                return false;
+            }
+            int32_t state = 0;
+            bool found = false;
+            const int32_t limit = static_cast<int32_t>(units.size());
+            for (size_t i = 0; i < size; ++i) {
+                int32_t next = units[state].base + static_cast<unsigned char>(data[i]);
+                if (next >= limit || units[next].check != state) {
+                    break;
+                }
+                state = next;
+                if (values[state] >= 0) {
+                    length = i + 1;
+                    id = static_cast<unsigned int>(values[state]);
+                    found = true;
+                }
+            }
+            return found;
+        }
+
+        /**
+         * @brief Procura um token exato
+         * @param key Token procurado
+         * @param id Recebe o ID do token
+         * @return true se o token está no vocabulário
+         */
+        bool find(std::string_view key, unsigned int& id) const;
+
+        /**
+         * @brief Obtém o número de tokens compilados
+         * @return Número de chaves
+         */
+        size_t size() const { return key_count; }
+
+        /**
+         * @brief Obtém a memória ocupada pelos vetores do autômato
+         * @return Tamanho em bytes
+         */
+        size_t memoryBytes() const {
+            return units.size() * sizeof(Unit) + values.size() * sizeof(int64_t);
+        }
+    };
+
+} // namespace hf_tokenizers
+
+#endif // TOKENIZER_DOUBLE_ARRAY_TRIE_H
@@ -0,0 +1,69 @@
+#ifndef TOKENIZER_REGISTRY_H
+#define TOKENIZER_REGISTRY_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include "tokenizer_wrapper.h"
+
+/**
+ * @file tokenizer_registry.h
+ * @brief Cache de processo dos tokenizadores carregados, por par de arquivos
+ *
+ * Carregar vocab.txt e merges.txt custa bem mais que tokenizar um intervalo de
+ * documentos, então cada par (vocab, merges) é carregado uma única vez e
+ * compartilhado por todas as etapas, chunks e threads. O tokenizador
+ * devolvido é imutável: só expõe métodos const, seguros para uso concorrente.
+ *
+ * As chaves são os caminhos exatamente como informados ("vocab.txt" e
+ * "./vocab.txt" são entradas distintas).
+ */
+
+/**
+ * @brief Registro global de tokenizadores compartilhados
+ */
+class TokenizerRegistry {
+private:
+    /**
+     * @brief Entrada do registro; o carregamento acontece fora do mutex do mapa
+     */
+    struct Entry {
+        std::once_flag loaded;                              ///< Garante um único carregamento
+        std::shared_ptr<const TokenizerWrapper> tokenizer;  ///< Tokenizador carregado
+    };
+
+    static std::mutex registry_mutex;  ///< Protege o mapa de entradas
+    static std::map<std::pair<std::string, std::string>, std::shared_ptr<Entry>> entries; ///< (vocab, merges) -> entrada
+
+public:
+    /**
+     * @brief Obtém o tokenizador do par de arquivos, carregando-o na primeira chamada
+     *
+     * Chamadas concorrentes para o mesmo par esperam o mesmo carregamento;
+     * pares diferentes carregam em paralelo.
+     *
+     * @param vocab_path Caminho do vocab.txt
+     * @param merges_path Caminho do merges.txt
+     * @return Tokenizador compartilhado (nunca nulo)
+     */
+    static std::shared_ptr<const TokenizerWrapper> get(const std::string& vocab_path,
+                                                       const std::string& merges_path);
+
+    /**
+     * @brief Obtém o número de pares de arquivos registrados
+     * @return Número de entradas
+     */
+    static size_t size();
+
+    /**
+     * @brief Esvazia o registro
+     *
+     * Tokenizadores já obtidos continuam válidos enquanto houver referências;
+     * a próxima chamada a get() carrega os arquivos novamente.
+     */
+    static void clear();
+};
+
+#endif // TOKENIZER_REGISTRY_H
@@ -4,12 +4,16 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <chrono>
 #include <thread>
 #include <numeric>
 #include <map>
 #include <stdexcept>
 #include <algorithm>
+#include <memory>
+#include "bpe_model.h"
+#include "double_array_trie.h"
 
 // Mock-up do namespace ou classes da biblioteca huggingface-tokenizer-in-cxx
 // Em um ambiente real, você incluiria os arquivos de cabeçalho reais e linkaria com a biblioteca.
@@ -51,17 +55,28 @@ namespace hf_tokenizers {
 
     /**
      * @brief Classe principal do tokenizador BPE (Byte Pair Encoding)
+     *
+     * Quando vocab.txt e merges.txt existem, as palavras passam pelo modelo BPE
+     * real (BpeModel). Sem os arquivos, usa um vocabulário simulado com busca
+     * de maior prefixo, como nos exemplos.
      */
     class Tokenizer {
     private:
-        std::map<std::string, unsigned int> vocabulary; ///< Vocabulário do tokenizador
+        std::map<std::string, unsigned int> vocabulary; ///< Vocabulário simulado do tokenizador
+        DoubleArrayTrie vocabulary_trie;                ///< Vocabulário compilado para busca de maior prefixo
+        std::unique_ptr<BpeModel> bpe_model;            ///< Modelo BPE carregado dos arquivos (nulo se ausentes)
+
+        /**
+         * @brief Compila o vocabulário atual no trie
+         */
+        void compile_vocabulary();
 
         /**
          * @brief Processa um token individual e o adiciona ao encoding
          * @param token_str String do token a ser processado
          * @param encoding Encoding onde o token será adicionado
          */
-        void process_token(const std::string& token_str, Encoding& encoding) const;
+        void process_token(std::string_view token_str, Encoding& encoding) const;
 
     public:
         /**
@@ -71,12 +86,91 @@ namespace hf_tokenizers {
          */
         Tokenizer(const std::string& vocab_path, const std::string& merges_path);
 
+        /**
+         * @brief Construtor com um vocabulário já carregado
+         * @param vocab Mapa de token para ID
+         */
+        explicit Tokenizer(std::map<std::string, unsigned int> vocab);
+
+        /**
+         * @brief Obtém o número de tokens do vocabulário
+         * @return Tamanho do vocabulário
+         */
+        size_t vocabulary_size() const { return bpe_model ? bpe_model->vocabularySize() : vocabulary.size(); }
+
+        /**
+         * @brief Indica se o modelo BPE real foi carregado
+         * @return true se vocab.txt e merges.txt foram lidos
+         */
+        bool uses_bpe_model() const { return bpe_model != nullptr; }
+
+        /**
+         * @brief Obtém o modelo BPE carregado
+         * @return Ponteiro para o modelo (nulo se o vocabulário simulado está em uso)
+         */
+        const BpeModel* get_bpe_model() const { return bpe_model.get(); }
+
+        /**
+         * @brief Obtém a memória ocupada pelo vocabulário compilado
+         * @return Tamanho do trie em bytes
+         */
+        size_t trie_memory_bytes() const { return vocabulary_trie.memoryBytes(); }
+
+        /**
+         * @brief Percorre as palavras do texto na segmentação usada por encode()
+         *
+         * ' ', '.', ',' e '\n' separam palavras; cada espaço também é visitado
+         * como uma palavra própria (" "), pois vira token. Não aloca memória.
+         *
+         * @param text Texto a ser segmentado
+         * @param visit Chamado com a view de cada palavra, na ordem do texto
+         */
+        template <typename VisitWord>
+        static void for_each_word(std::string_view text, VisitWord visit) {
+            size_t start = 0;
+            for (size_t pos = 0; pos < text.size(); ++pos) {
+                char c = text[pos];
+                if (c != ' ' && c != '.' && c != ',' && c != '\n') {
+                    continue;
+                }
+                if (pos > start) {
+                    visit(text.substr(start, pos - start));
+                }
+                if (c == ' ') { // Adiciona espaço como token se relevante
+                    visit(text.substr(pos, 1));
+                }
+                start = pos + 1;
+            }
+            if (start < text.size()) {
+                visit(text.substr(start));
+            }
+        }
+
         /**
          * @brief Realiza a tokenização de um texto
          * @param text Texto a ser tokenizado
          * @return Encoding com os tokens gerados
          */
         Encoding encode(const std::string& text) const;
+
+        /**
+         * @brief Tokeniza uma única palavra sem materializar strings
+         *
+         * O texto de cada subtoken aponta para o vocabulário do modelo BPE ou,
+         * no vocabulário simulado, para a própria palavra: vale enquanto ambos
+         * existirem. Não aloca quando pieces já tem capacidade.
+         *
+         * @param word Palavra a ser tokenizada (sem separadores)
+         * @param pieces Recebe os subtokens, acrescentados ao final
+         */
+        void encode_pieces(std::string_view word, std::vector<BpeToken>& pieces) const;
+
+        /**
+         * @brief Tokeniza uma única palavra (sem separadores), acumulando no encoding
+         * @param word Palavra a ser tokenizada
+         * @param encoding Encoding onde os subtokens serão adicionados
+         */
+        void encode_word(const std::string& word, Encoding& encoding) const;
     };
 }
 
@@ -85,6 +179,8 @@ namespace hf_tokenizers {
  * 
  * Esta classe encapsula o tokenizador HuggingFace e fornece métodos
  * convenientes para tokenização com gerenciamento automático de memória.
+ * Todos os métodos de tokenização são const e podem ser chamados de várias
+ * threads; para compartilhar uma instância carregada, use TokenizerRegistry.
  */
 class TokenizerWrapper {
 private:
@@ -109,14 +205,40 @@ public:
      * @return Encoding com tokens e tokens especiais
      * @throws std::runtime_error se o tokenizador não estiver inicializado
      */
-    hf_tokenizers::Encoding tokenize_and_add_special_tokens(const std::string& text);
+    hf_tokenizers::Encoding tokenize_and_add_special_tokens(const std::string& text) const;
 
     /**
      * @brief Converte texto diretamente para IDs de tokens
      * @param text Texto a ser convertido
      * @return Vetor com os IDs dos tokens (incluindo tokens especiais)
      */
-    std::vector<unsigned int> text_to_ids(const std::string& text);
+    std::vector<unsigned int> text_to_ids(const std::string& text) const;
+
+    /**
+     * @brief Tokeniza uma única palavra já separada, sem tokens especiais
+     * @param word Palavra a ser tokenizada
+     * @param encoding Encoding onde os subtokens serão adicionados
+     * @throws std::runtime_error se o tokenizador não estiver inicializado
+     */
+    void tokenize_word(const std::string& word, hf_tokenizers::Encoding& encoding) const;
+
+    /**
+     * @brief Tokeniza uma única palavra já separada, sem alocar strings por subtoken
+     * @param word Palavra a ser tokenizada
+     * @param pieces Recebe os subtokens (views válidas enquanto o tokenizador e a palavra existirem)
+     * @throws std::runtime_error se o tokenizador não estiver inicializado
+     */
+    void tokenize_pieces(std::string_view word, std::vector<hf_tokenizers::BpeToken>& pieces) const;
+
+    /**
+     * @brief Percorre as palavras do texto com a segmentação do tokenizador
+     * @param text Texto a ser segmentado
+     * @param visit Chamado com a view de cada palavra (espaços incluídos como " ")
+     */
+    template <typename VisitWord>
+    static void for_each_word(std::string_view text, VisitWord visit) {
+        hf_tokenizers::Tokenizer::for_each_word(text, visit);
+    }
 
     // Impede cópia para evitar problemas com gerenciamento de memória
     TokenizerWrapper(const TokenizerWrapper&) = delete;
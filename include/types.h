@@ -5,6 +5,7 @@
 #include <vector>
 #include <functional>
 #include <atomic>
+#include <cstdint>
 
 /**
  * @file types.h
@@ -30,17 +31,51 @@ namespace legal_doc_pipeline {
         GENERATE_EMBEDDINGS
     };
 
+    /**
+     * @brief Nome de um tipo de tarefa (usado em chaves de estatísticas e relatórios)
+     * @param type Tipo da tarefa
+     * @return Nome do enumerador (ex.: "TEXT_CLEANING")
+     */
+    const char* taskTypeName(TaskType type);
+
+    /**
+     * @brief Estratégia de distribuição de tarefas prontas entre os workers
+     */
+    enum class SchedulingMode {
+        GLOBAL_QUEUE,   ///< Fila de prioridade única protegida por mutex global
+        WORK_STEALING   ///< Deque por worker com roubo de tarefas entre workers
+    };
+
+    /**
+     * @brief Identificador denso de uma tarefa no scheduler (índice na ordem de inserção)
+     */
+    using TaskId = uint32_t;
+
+    /**
+     * @brief Valor de TaskId que não corresponde a nenhuma tarefa
+     */
+    constexpr TaskId INVALID_TASK_ID = static_cast<TaskId>(-1);
+
+    /**
+     * @brief Operação de uma tarefa data-parallel sobre o intervalo [begin, end) de documentos
+     */
+    using RangeOperation = std::function<void(std::vector<std::string>&, size_t, size_t)>;
+
     /**
      * @brief Estrutura que representa uma tarefa no grafo de dependências
+     *
+     * As arestas do grafo não ficam na tarefa: o scheduler as guarda em
+     * vetores compactos (CSR) indexados por TaskId.
      */
     struct Task {
         std::string id;                                                    ///< Identificador único da tarefa
         TaskType type;                                                     ///< Tipo da tarefa
         int priority;                                                      ///< Prioridade (menor valor = maior prioridade)
-        std::vector<std::string> dependencies;                           ///< IDs das tarefas predecessoras
-        std::vector<std::string> dependents;                             ///< IDs das tarefas sucessoras
         std::function<void(std::vector<std::string>&)> operation;        ///< Função da tarefa
+        RangeOperation range_operation;                                  ///< Função por intervalo (vazia se a tarefa não é data-parallel)
+        size_t grain_size;                                               ///< Documentos por sub-tarefa (0 = automático)
         std::atomic<int> remaining_dependencies;                         ///< Contador de dependências não satisfeitas
+        std::atomic<size_t> remaining_subtasks;                          ///< Sub-tarefas ainda em execução
         bool is_completed;                                               ///< Flag de conclusão
 
         /**
@@ -52,6 +87,28 @@ namespace legal_doc_pipeline {
          */
         Task(std::string id, TaskType type, int priority, std::function<void(std::vector<std::string>&)> op);
 
+        /**
+         * @brief Construtor de tarefa data-parallel
+         *
+         * O scheduler divide os documentos em intervalos de até grain_size itens,
+         * executa cada intervalo como sub-tarefa e só libera os sucessores quando
+         * todos os intervalos terminam. O campo operation recebe uma versão que
+         * processa o vetor inteiro, para quem executa a tarefa diretamente.
+         *
+         * @param id Identificador único
+         * @param type Tipo da tarefa
+         * @param priority Prioridade da tarefa
+         * @param range_op Função executada sobre cada intervalo [begin, end)
+         * @param grain_size Documentos por sub-tarefa (0 = automático)
+         */
+        Task(std::string id, TaskType type, int priority, RangeOperation range_op, size_t grain_size = 0);
+
+        /**
+         * @brief Verifica se a tarefa é data-parallel
+         * @return true se a tarefa possui operação por intervalo
+         */
+        bool isDataParallel() const;
+
         /**
          * @brief Construtor de cópia
          * @param other Tarefa a ser copiada
@@ -73,6 +130,25 @@ namespace legal_doc_pipeline {
         bool operator()(const Task* a, const Task* b) const;
     };
 
+    /**
+     * @brief Unidade de execução do scheduler: uma tarefa sobre um intervalo de documentos
+     *
+     * Tarefas comuns geram um único item; tarefas data-parallel geram um item por intervalo.
+     */
+    struct WorkItem {
+        Task* task = nullptr;   ///< Tarefa a que o item pertence
+        size_t begin = 0;       ///< Primeiro documento do intervalo
+        size_t end = 0;         ///< Fim (exclusivo) do intervalo
+        int64_t ready_ns = 0;   ///< Instante em que o item ficou pronto (ns desde o início da execução)
+    };
+
+    /**
+     * @brief Comparador de WorkItem na fila de prioridade (ordena pela prioridade da tarefa)
+     */
+    struct WorkItemCompare {
+        bool operator()(const WorkItem& a, const WorkItem& b) const;
+    };
+
     /**
      * @brief Configuração para execução do pipeline
      */
@@ -82,6 +158,14 @@ namespace legal_doc_pipeline {
         size_t max_sequence_length = 128;       ///< Tamanho máximo de sequência
         std::string vocab_file = "vocab.txt";   ///< Arquivo de vocabulário
         std::string merges_file = "merges.txt"; ///< Arquivo de merges BPE
+        SchedulingMode scheduling_mode = SchedulingMode::GLOBAL_QUEUE; ///< Estratégia do scheduler
+        size_t task_grain_size = 0;             ///< Documentos por sub-tarefa data-parallel (0 = automático)
+        size_t stream_batch_size = 32;          ///< Documentos por lote no modo streaming
+        size_t stream_queue_capacity = 4;       ///< Lotes em espera entre duas etapas no modo streaming
+        bool pin_worker_threads = false;        ///< Fixa cada thread do pool em uma CPU (Linux)
+        size_t worker_spin_iterations = 0;      ///< Espera ativa das threads ociosas do pool antes de dormir
+        bool enable_tracing = false;            ///< Grava a linha do tempo de tarefas e chunks (PipelineManager::writeTrace)
+        bool use_batch_arena = true;            ///< Tokens dos modos particionado e streaming numa arena por lote (utils::ArenaResource)
         
         /**
          * @brief Cria uma configuração para execução sequencial pura
@@ -94,6 +178,18 @@ namespace legal_doc_pipeline {
         }
     };
 
+    /**
+     * @brief Estatísticas de uma etapa do pipeline em modo streaming
+     */
+    struct StageStats {
+        std::string name;              ///< Nome da etapa
+        size_t documents = 0;          ///< Documentos processados
+        size_t batches = 0;            ///< Lotes processados
+        double busy_time = 0.0;        ///< Tempo processando lotes (segundos)
+        double wait_time = 0.0;        ///< Tempo bloqueado nas filas de entrada/saída (segundos)
+        double throughput = 0.0;       ///< Documentos por segundo de processamento efetivo
+    };
+
     /**
      * @brief Resultado da execução do pipeline
      */
@@ -103,6 +199,8 @@ namespace legal_doc_pipeline {
         size_t tasks_completed;                   ///< Número de tarefas completadas
         bool success;                             ///< Flag de sucesso
         std::string error_message;                ///< Mensagem de erro, se houver
+        std::vector<StageStats> stage_stats;      ///< Estatísticas por etapa (apenas modo streaming)
+        double load_imbalance = 0.0;              ///< Tempo do worker mais ocupado / tempo médio (apenas modo particionado; 1.0 = equilibrado)
     };
 
     /**
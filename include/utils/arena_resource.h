@@ -0,0 +1,102 @@
+#ifndef UTILS_ARENA_RESOURCE_H
+#define UTILS_ARENA_RESOURCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * @file arena_resource.h
+ * @brief Arena de memória por lote (std::pmr::memory_resource)
+ *
+ * Alocações avançam um ponteiro dentro de blocos obtidos do recurso de
+ * origem; liberações individuais não fazem nada. Ao fim do lote, release()
+ * devolve toda a memória de uma vez e mantém os blocos para o próximo lote:
+ * depois do primeiro lote, tokens e IDs dos documentos não chamam malloc.
+ *
+ * Não é thread-safe: cada arena pertence a um lote processado por uma thread
+ * de cada vez.
+ */
+
+namespace legal_doc_pipeline {
+namespace utils {
+
+    /**
+     * @brief Recurso monotônico com blocos reaproveitados entre lotes
+     */
+    class ArenaResource : public std::pmr::memory_resource {
+    private:
+        /**
+         * @brief Bloco obtido do recurso de origem
+         */
+        struct Block {
+            std::byte* data;   ///< Início do bloco
+            size_t size;       ///< Tamanho em bytes
+        };
+
+        std::pmr::memory_resource* upstream;   ///< Origem dos blocos
+        size_t next_block_size;                ///< Tamanho do próximo bloco novo (dobra a cada bloco)
+        std::vector<Block> blocks;             ///< Blocos na ordem de uso
+        size_t current_block = 0;              ///< Bloco em uso
+        size_t offset = 0;                     ///< Bytes já usados no bloco atual
+        uint64_t allocation_count = 0;         ///< Alocações atendidas
+        uint64_t allocated_bytes = 0;          ///< Bytes entregues
+        uint64_t upstream_count = 0;           ///< Blocos pedidos ao recurso de origem
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    public:
+        /**
+         * @brief Construtor (nenhuma memória é pedida até a primeira alocação)
+         * @param initial_block_bytes Tamanho do primeiro bloco
+         * @param upstream Recurso de origem dos blocos
+         */
+        explicit ArenaResource(size_t initial_block_bytes = 64 * 1024,
+                               std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+        ~ArenaResource() override;
+
+        ArenaResource(const ArenaResource&) = delete;
+        ArenaResource& operator=(const ArenaResource&) = delete;
+
+        /**
+         * @brief Descarta tudo o que foi alocado, mantendo os blocos para reuso
+         *
+         * Nenhum objeto alocado na arena pode ser usado (nem destruído com
+         * liberação) depois desta chamada.
+         */
+        void release();
+
+        /**
+         * @brief Obtém o número de alocações atendidas desde a construção
+         * @return Alocações
+         */
+        uint64_t allocationCount() const { return allocation_count; }
+
+        /**
+         * @brief Obtém o total de bytes entregues desde a construção
+         * @return Bytes
+         */
+        uint64_t allocatedBytes() const { return allocated_bytes; }
+
+        /**
+         * @brief Obtém o número de blocos pedidos ao recurso de origem
+         * @return Blocos (cada um é uma chamada ao alocador de origem)
+         */
+        uint64_t upstreamAllocations() const { return upstream_count; }
+
+        /**
+         * @brief Obtém a memória reservada nos blocos
+         * @return Bytes
+         */
+        size_t capacity() const;
+    };
+
+} // namespace utils
+} // namespace legal_doc_pipeline
+
+#endif // UTILS_ARENA_RESOURCE_H
@@ -0,0 +1,115 @@
+#ifndef UTILS_BOUNDED_QUEUE_H
+#define UTILS_BOUNDED_QUEUE_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+/**
+ * @file bounded_queue.h
+ * @brief Fila bloqueante de capacidade limitada
+ *
+ * Conecta etapas do pipeline em modo streaming: o produtor bloqueia quando a
+ * fila está cheia (back-pressure) e o consumidor bloqueia quando está vazia.
+ * Após close(), os itens restantes ainda são entregues e pop() passa a
+ * retornar false quando a fila esvazia.
+ */
+
+namespace legal_doc_pipeline {
+namespace utils {
+
+    /**
+     * @brief Fila FIFO thread-safe com capacidade máxima
+     * @tparam T Tipo dos itens (movidos para dentro e para fora da fila)
+     */
+    template <typename T>
+    class BoundedQueue {
+    private:
+        mutable std::mutex queue_mutex;       ///< Protege items e closed
+        std::condition_variable not_full;     ///< Sinaliza espaço livre para o produtor
+        std::condition_variable not_empty;    ///< Sinaliza item disponível para o consumidor
+        std::deque<T> items;                  ///< Itens enfileirados
+        size_t capacity;                      ///< Número máximo de itens
+        bool closed = false;                  ///< Flag de fim de produção
+
+    public:
+        /**
+         * @brief Construtor
+         * @param capacity Número máximo de itens (mínimo 1)
+         */
+        explicit BoundedQueue(size_t capacity) : capacity(capacity > 0 ? capacity : 1) {}
+
+        /**
+         * @brief Insere um item, bloqueando enquanto a fila estiver cheia
+         * @param item Item a ser inserido
+         * @return false se a fila já foi fechada (o item é descartado)
+         */
+        bool push(T item) {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            not_full.wait(lock, [this] { return closed || items.size() < capacity; });
+            if (closed) {
+                return false;
+            }
+            items.push_back(std::move(item));
+            lock.unlock();
+            not_empty.notify_one();
+            return true;
+        }
+
+        /**
+         * @brief Remove o item mais antigo, bloqueando enquanto a fila estiver vazia
+         * @param item Recebe o item removido
+         * @return false se a fila foi fechada e não há mais itens
+         */
+        bool pop(T& item) {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            not_empty.wait(lock, [this] { return closed || !items.empty(); });
+            if (items.empty()) {
+                return false;
+            }
+            item = std::move(items.front());
+            items.pop_front();
+            lock.unlock();
+            not_full.notify_one();
+            return true;
+        }
+
+        /**
+         * @brief Encerra a produção e acorda todos os threads bloqueados
+         */
+        void close() {
+            {
+                std::lock_guard<std::mutex> lock(queue_mutex);
+                closed = true;
+            }
+            not_full.notify_all();
+            not_empty.notify_all();
+        }
+
+        /**
+         * @brief Obtém o número de itens na fila
+         * @return Número de itens
+         */
+        size_t size() const {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            return items.size();
+        }
+
+        /**
+         * @brief Obtém a capacidade máxima da fila
+         * @return Capacidade
+         */
+        size_t getCapacity() const {
+            return capacity;
+        }
+
+        // Desabilita cópia e atribuição
+        BoundedQueue(const BoundedQueue&) = delete;
+        BoundedQueue& operator=(const BoundedQueue&) = delete;
+    };
+
+} // namespace utils
+} // namespace legal_doc_pipeline
+
+#endif // UTILS_BOUNDED_QUEUE_H
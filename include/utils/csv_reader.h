@@ -1,6 +1,8 @@
 #ifndef UTILS_CSV_READER_H
 #define UTILS_CSV_READER_H
 
+#include <cstddef>
+#include <functional>
 #include <string>
 #include <vector>
 #include <map>
@@ -10,7 +12,9 @@
  * @brief Utilitários para leitura de arquivos CSV
  * 
  * Este módulo fornece funcionalidades para ler e processar arquivos CSV,
- * específicamente otimizado para o dataset de documentos jurídicos.
+ * específicamente otimizado para o dataset de documentos jurídicos. Os
+ * registros são lidos com CsvRecordIterator, então campos entre aspas podem
+ * ocupar várias linhas físicas.
  */
 
 namespace legal_doc_pipeline {
@@ -44,6 +48,25 @@ namespace utils {
             char delimiter = ';'
         );
 
+        /**
+         * @brief Entrega os valores de uma coluna um a um, sem materializar o vetor
+         *
+         * A memória usada é limitada ao bloco de leitura e ao registro atual,
+         * permitindo processar arquivos maiores que a RAM.
+         *
+         * @param filename Caminho para o arquivo CSV
+         * @param column_name Nome da coluna a ser lida
+         * @param consumer Chamado com cada valor (pode movê-lo)
+         * @param delimiter Delimitador usado no CSV (padrão: ';')
+         * @return Número de valores entregues (0 se o arquivo ou a coluna não existem)
+         */
+        size_t forEachValue(
+            const std::string& filename,
+            const std::string& column_name,
+            const std::function<void(std::string&)>& consumer,
+            char delimiter = ';'
+        );
+
         /**
          * @brief Lê todas as colunas de um arquivo CSV
          * @param filename Caminho para o arquivo CSV
@@ -88,13 +111,6 @@ namespace utils {
          * @return String sem aspas duplas
          */
         std::string removeQuotes(const std::string& str);
-        
-        /**
-         * @brief Remove BOM UTF-8 de uma string, se presente
-         * @param str String a ser processada
-         * @return String sem BOM UTF-8
-         */
-        std::string removeBOM(const std::string& str);
     };
 
 } // namespace utils
@@ -0,0 +1,101 @@
+#ifndef UTILS_CSV_RECORD_ITERATOR_H
+#define UTILS_CSV_RECORD_ITERATOR_H
+
+#include <cstddef>
+#include <fstream>
+#include <istream>
+#include <string>
+#include <vector>
+
+/**
+ * @file csv_record_iterator.h
+ * @brief Iteração de registros CSV em streaming, com memória limitada
+ *
+ * Lê a entrada em blocos de tamanho fixo e entrega um registro lógico por
+ * vez, seguindo a RFC 4180: campos entre aspas podem conter delimitadores e
+ * quebras de linha, e "" dentro de aspas é uma aspa literal. A memória usada
+ * é o bloco de leitura mais o maior registro, independentemente do tamanho
+ * do arquivo.
+ */
+
+namespace legal_doc_pipeline {
+namespace utils {
+
+    /**
+     * @brief Iterador de registros sobre um arquivo ou stream CSV
+     */
+    class CsvRecordIterator {
+    private:
+        std::ifstream file;            ///< Arquivo aberto pelo construtor com nome
+        std::istream* input;           ///< Stream efetivamente lido
+        char delimiter;                ///< Delimitador de campos
+        std::vector<char> buffer;      ///< Bloco de leitura
+        size_t position = 0;           ///< Próximo byte não consumido do bloco
+        size_t available = 0;          ///< Bytes válidos no bloco
+        bool started = false;          ///< true após a leitura do primeiro bloco (BOM já tratado)
+        size_t records_read = 0;       ///< Registros entregues até agora
+        bool unterminated_quote = false; ///< Último registro terminou dentro de aspas
+
+        /**
+         * @brief Lê o próximo bloco da entrada
+         * @return true se há bytes disponíveis
+         */
+        bool fill();
+
+    public:
+        /**
+         * @brief Abre um arquivo para iteração
+         * @param filename Caminho para o arquivo CSV
+         * @param delimiter Delimitador usado no CSV (padrão: ';')
+         * @param buffer_size Tamanho do bloco de leitura em bytes
+         */
+        explicit CsvRecordIterator(const std::string& filename, char delimiter = ';',
+                                   size_t buffer_size = 64 * 1024);
+
+        /**
+         * @brief Itera sobre um stream já aberto (não assume sua posse)
+         * @param stream Stream de entrada
+         * @param delimiter Delimitador usado no CSV (padrão: ';')
+         * @param buffer_size Tamanho do bloco de leitura em bytes
+         */
+        explicit CsvRecordIterator(std::istream& stream, char delimiter = ';',
+                                   size_t buffer_size = 64 * 1024);
+
+        CsvRecordIterator(const CsvRecordIterator&) = delete;
+        CsvRecordIterator& operator=(const CsvRecordIterator&) = delete;
+
+        /**
+         * @brief Verifica se a entrada foi aberta com sucesso
+         * @return true se é possível ler
+         */
+        bool isOpen() const;
+
+        /**
+         * @brief Lê o próximo registro
+         *
+         * Os campos vêm sem as aspas delimitadoras e com "" convertido em ".
+         * O '\r' de finais de linha CRLF é descartado. As strings de fields
+         * são reutilizadas entre chamadas para evitar realocações.
+         *
+         * @param fields Recebe os campos do registro
+         * @return false ao fim da entrada
+         */
+        bool next(std::vector<std::string>& fields);
+
+        /**
+         * @brief Obtém o número de registros lidos
+         * @return Registros entregues por next()
+         */
+        size_t getRecordsRead() const { return records_read; }
+
+        /**
+         * @brief Indica se o último registro terminou com aspas não fechadas
+         * @return true se a entrada acabou dentro de um campo entre aspas
+         */
+        bool hasUnterminatedQuote() const { return unterminated_quote; }
+    };
+
+} // namespace utils
+} // namespace legal_doc_pipeline
+
+#endif // UTILS_CSV_RECORD_ITERATOR_H
@@ -0,0 +1,111 @@
+#ifndef UTILS_LATENCY_HISTOGRAM_H
+#define UTILS_LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file latency_histogram.h
+ * @brief Histograma de latências com buckets log-lineares
+ *
+ * Cada potência de dois é dividida em 16 buckets iguais, então o erro
+ * relativo de um percentil é de no máximo 1/16 (~6%), com memória fixa e
+ * registro O(1) sem alocações. Valores abaixo de 16 ns têm bucket próprio;
+ * valores acima de ~2^48 ns (~3 dias) caem no último bucket.
+ */
+
+namespace legal_doc_pipeline {
+namespace utils {
+
+    /**
+     * @brief Histograma de durações em nanossegundos
+     */
+    class LatencyHistogram {
+    private:
+        static constexpr unsigned SUB_BUCKET_BITS = 4;                   ///< log2 dos buckets por potência de dois
+        static constexpr uint64_t SUB_BUCKETS = 1u << SUB_BUCKET_BITS;   ///< Buckets por potência de dois
+        static constexpr unsigned MAX_EXPONENT = 47;                     ///< Maior bit mais significativo distinguido
+        static constexpr size_t BUCKET_COUNT = (MAX_EXPONENT - SUB_BUCKET_BITS + 2) * SUB_BUCKETS; ///< Total de buckets
+
+        std::array<uint64_t, BUCKET_COUNT> counts{};   ///< Amostras por bucket
+        uint64_t sample_count = 0;                     ///< Total de amostras
+        uint64_t total = 0;                            ///< Soma das amostras (ns)
+        uint64_t min_value = 0;                        ///< Menor amostra (ns)
+        uint64_t max_value = 0;                        ///< Maior amostra (ns)
+
+        /**
+         * @brief Índice do bucket de um valor
+         */
+        static size_t bucketIndex(uint64_t value);
+
+        /**
+         * @brief Maior valor que cai no bucket
+         */
+        static uint64_t bucketUpperBound(size_t index);
+
+    public:
+        /**
+         * @brief Registra uma amostra
+         * @param nanoseconds Duração em nanossegundos
+         */
+        void record(uint64_t nanoseconds);
+
+        /**
+         * @brief Soma as amostras de outro histograma
+         * @param other Histograma a acumular
+         */
+        void merge(const LatencyHistogram& other);
+
+        /**
+         * @brief Remove todas as amostras
+         */
+        void reset();
+
+        /**
+         * @brief Obtém o valor abaixo do qual está a fração p das amostras
+         *
+         * O resultado é o limite superior do bucket, limitado à maior amostra.
+         *
+         * @param p Percentil entre 0 e 100 (ex.: 99.0)
+         * @return Duração em nanossegundos, ou 0 sem amostras
+         */
+        uint64_t percentile(double p) const;
+
+        /**
+         * @brief Obtém o número de amostras
+         * @return Total de amostras registradas
+         */
+        uint64_t count() const { return sample_count; }
+
+        /**
+         * @brief Obtém a soma das amostras
+         * @return Soma em nanossegundos
+         */
+        uint64_t sum() const { return total; }
+
+        /**
+         * @brief Obtém a menor amostra
+         * @return Menor duração (ns), ou 0 sem amostras
+         */
+        uint64_t min() const { return min_value; }
+
+        /**
+         * @brief Obtém a maior amostra
+         * @return Maior duração (ns), ou 0 sem amostras
+         */
+        uint64_t max() const { return max_value; }
+
+        /**
+         * @brief Obtém a média das amostras
+         * @return Média em nanossegundos, ou 0 sem amostras
+         */
+        double mean() const {
+            return sample_count == 0 ? 0.0 : static_cast<double>(total) / static_cast<double>(sample_count);
+        }
+    };
+
+} // namespace utils
+} // namespace legal_doc_pipeline
+
+#endif // UTILS_LATENCY_HISTOGRAM_H
@@ -0,0 +1,135 @@
+#ifndef UTILS_LOGGER_H
+#define UTILS_LOGGER_H
+
+#include <atomic>
+#include <cstddef>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+/**
+ * @file logger.h
+ * @brief Log com níveis, buffers por thread e escrita assíncrona
+ *
+ * Cada thread escreve num buffer circular próprio (um produtor, um
+ * consumidor, sem locks); uma thread de fundo drena os buffers e grava as
+ * mensagens na saída em ordem de tempo. Com o buffer cheio a mensagem é
+ * descartada e contada, nunca bloqueando quem escreve.
+ *
+ * Há dois filtros:
+ * - compilação: níveis abaixo de PIPELINE_LOG_MIN_LEVEL somem do binário
+ *   (padrão 1 = VERBOSE; TRACE só existe com -DPIPELINE_LOG_MIN_LEVEL=0);
+ * - execução: Logger::setLevel, definido pelo PipelineManager a partir de
+ *   PipelineConfig::enable_debug. Uma mensagem desabilitada custa uma
+ *   leitura atômica relaxada; a mensagem nem chega a ser formatada.
+ *
+ * O nível de depuração se chama VERBOSE porque o build de debug define a
+ * macro DEBUG.
+ */
+
+#ifndef PIPELINE_LOG_MIN_LEVEL
+#define PIPELINE_LOG_MIN_LEVEL 1
+#endif
+
+namespace legal_doc_pipeline {
+namespace utils {
+
+    /**
+     * @brief Níveis de log, do mais detalhado ao mais grave
+     */
+    enum class LogLevel {
+        TRACE = 0,     ///< Eventos por item de execução
+        VERBOSE = 1,   ///< Progresso de tarefas e workers (PipelineConfig::enable_debug)
+        INFO = 2,      ///< Eventos pontuais (padrão)
+        WARNING = 3,   ///< Situações recuperáveis
+        ERROR = 4,     ///< Falhas
+        OFF = 5        ///< Desabilita o log
+    };
+
+    /**
+     * @brief Fachada estática do log assíncrono
+     */
+    class Logger {
+    private:
+        static std::atomic<int> runtime_level;   ///< Nível mínimo em execução
+
+    public:
+        /**
+         * @brief Verifica se o nível está habilitado em execução
+         * @param level Nível da mensagem
+         * @return true se a mensagem deve ser registrada
+         */
+        static bool isEnabled(LogLevel level) {
+            return static_cast<int>(level) >= runtime_level.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Define o nível mínimo em execução
+         * @param level Novo nível
+         */
+        static void setLevel(LogLevel level);
+
+        /**
+         * @brief Obtém o nível mínimo em execução
+         * @return Nível atual (padrão INFO)
+         */
+        static LogLevel getLevel();
+
+        /**
+         * @brief Registra uma mensagem no buffer da thread atual
+         *
+         * Mensagens maiores que o espaço de uma entrada são truncadas.
+         *
+         * @param level Nível da mensagem
+         * @param message Texto, sem quebra de linha final
+         */
+        static void write(LogLevel level, const std::string& message);
+
+        /**
+         * @brief Grava imediatamente as mensagens pendentes de todas as threads
+         */
+        static void flush();
+
+        /**
+         * @brief Define a saída das mensagens (grava as pendentes na saída anterior)
+         * @param sink Stream de saída, ou nullptr para std::cout
+         */
+        static void setSink(std::ostream* sink);
+
+        /**
+         * @brief Obtém o número de mensagens descartadas por buffer cheio
+         * @return Total desde o início do processo
+         */
+        static size_t droppedMessages();
+
+        /**
+         * @brief Nome do nível para a saída
+         * @param level Nível
+         * @return Nome em maiúsculas
+         */
+        static const char* levelName(LogLevel level);
+    };
+
+} // namespace utils
+} // namespace legal_doc_pipeline
+
+/**
+ * @brief Registra message (expressão de operator<<) se level passa nos dois filtros
+ */
+#define PIPELINE_LOG(level, message)                                                              \
+    do {                                                                                          \
+        if (static_cast<int>(level) >= PIPELINE_LOG_MIN_LEVEL &&                                  \
+            ::legal_doc_pipeline::utils::Logger::isEnabled(level)) {                              \
+            std::ostringstream pipeline_log_stream_;                                              \
+            pipeline_log_stream_ << message;                                                      \
+            ::legal_doc_pipeline::utils::Logger::write(level, pipeline_log_stream_.str());        \
+        }                                                                                         \
+    } while (0)
+
+#define PIPELINE_LOG_TRACE(message) PIPELINE_LOG(::legal_doc_pipeline::utils::LogLevel::TRACE, message)
+#define PIPELINE_LOG_VERBOSE(message) PIPELINE_LOG(::legal_doc_pipeline::utils::LogLevel::VERBOSE, message)
+#define PIPELINE_LOG_INFO(message) PIPELINE_LOG(::legal_doc_pipeline::utils::LogLevel::INFO, message)
+#define PIPELINE_LOG_WARNING(message) PIPELINE_LOG(::legal_doc_pipeline::utils::LogLevel::WARNING, message)
+#define PIPELINE_LOG_ERROR(message) PIPELINE_LOG(::legal_doc_pipeline::utils::LogLevel::ERROR, message)
+
+#endif // UTILS_LOGGER_H
@@ -0,0 +1,140 @@
+#ifndef UTILS_MAPPED_CSV_READER_H
+#define UTILS_MAPPED_CSV_READER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file mapped_csv_reader.h
+ * @brief Leitura paralela de CSV sobre o arquivo mapeado em memória
+ *
+ * O arquivo é mapeado com mmap e dividido em blocos de bytes parseados por
+ * threads diferentes. Como campos entre aspas podem conter quebras de linha,
+ * a fronteira de registro de cada bloco é encontrada em duas passadas: a
+ * primeira conta as aspas de cada bloco e a soma de prefixos da paridade diz
+ * se o bloco começa dentro de um campo; a segunda localiza o primeiro '\n'
+ * fora de aspas e parseia os registros que começam no bloco. Os valores são
+ * string_views para o mapeamento; só campos com aspas escapadas ("") são
+ * copiados, para um buffer do próprio bloco.
+ */
+
+namespace legal_doc_pipeline {
+namespace utils {
+
+    /**
+     * @brief Arquivo mapeado somente leitura (RAII, apenas movível)
+     */
+    class MappedFile {
+    private:
+        const char* data = nullptr;   ///< Início do mapeamento
+        size_t length = 0;            ///< Tamanho do arquivo em bytes
+
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        /**
+         * @brief Mapeia o arquivo, substituindo um mapeamento anterior
+         * @param filename Caminho do arquivo
+         * @return true se o arquivo foi aberto e mapeado (arquivos vazios incluídos)
+         */
+        bool open(const std::string& filename);
+
+        /**
+         * @brief Desfaz o mapeamento
+         */
+        void close();
+
+        /**
+         * @brief Obtém o conteúdo mapeado
+         * @return View para os bytes do arquivo
+         */
+        std::string_view view() const { return std::string_view(data, length); }
+
+        /**
+         * @brief Obtém o tamanho do arquivo
+         * @return Tamanho em bytes
+         */
+        size_t size() const { return length; }
+    };
+
+    /**
+     * @brief Coluna lida pelo MappedCsvReader
+     *
+     * Os valores apontam para o mapeamento ou para os buffers de campos
+     * escapados, ambos mantidos vivos por este objeto; por isso ele só pode
+     * ser movido, nunca copiado.
+     */
+    struct CsvColumnView {
+        std::vector<std::string_view> values;   ///< Um valor por registro, sem aspas e aparado
+        MappedFile file;                        ///< Mapeamento referenciado pelos valores
+        std::vector<std::string> buffers;       ///< Campos com aspas escapadas, um buffer por bloco
+
+        CsvColumnView() = default;
+        CsvColumnView(const CsvColumnView&) = delete;
+        CsvColumnView& operator=(const CsvColumnView&) = delete;
+        CsvColumnView(CsvColumnView&&) = default;
+        CsvColumnView& operator=(CsvColumnView&&) = default;
+
+        size_t size() const { return values.size(); }
+        bool empty() const { return values.empty(); }
+        std::string_view operator[](size_t index) const { return values[index]; }
+
+        /**
+         * @brief Copia os valores para strings independentes do mapeamento
+         * @return Vetor com uma string por registro
+         */
+        std::vector<std::string> toStrings() const;
+    };
+
+    /**
+     * @brief Leitor de colunas CSV com mmap e parse em blocos paralelos
+     *
+     * Segue a RFC 4180: campos entre aspas podem conter delimitadores e
+     * quebras de linha, e "" dentro de aspas é uma aspa literal. Assim como
+     * o CsvReader, remove o BOM UTF-8 do cabeçalho e apara espaços e
+     * caracteres de controle (" \t\r\n") nas bordas de cada valor.
+     */
+    class MappedCsvReader {
+    private:
+        size_t num_threads;       ///< Threads de parse (0 = hardware_concurrency)
+        size_t min_chunk_bytes;   ///< Tamanho mínimo de um bloco
+
+    public:
+        /**
+         * @brief Construtor
+         * @param num_threads Número de threads de parse (0 = automático)
+         * @param min_chunk_bytes Tamanho mínimo de cada bloco; arquivos pequenos usam menos threads
+         */
+        explicit MappedCsvReader(size_t num_threads = 0, size_t min_chunk_bytes = 1 << 20);
+
+        /**
+         * @brief Lê uma coluna específica de um arquivo CSV
+         * @param filename Caminho para o arquivo CSV
+         * @param column_name Nome da coluna a ser lida
+         * @param delimiter Delimitador usado no CSV (padrão: ';')
+         * @return Coluna com um valor por registro (vazia em caso de erro)
+         */
+        CsvColumnView readColumn(const std::string& filename,
+                                 const std::string& column_name,
+                                 char delimiter = ';') const;
+
+        /**
+         * @brief Obtém o número de blocos usado para um arquivo de determinado tamanho
+         * @param bytes Tamanho do corpo do arquivo
+         * @return Número de blocos (pelo menos 1)
+         */
+        size_t chunkCount(size_t bytes) const;
+    };
+
+} // namespace utils
+} // namespace legal_doc_pipeline
+
+#endif // UTILS_MAPPED_CSV_READER_H
@@ -0,0 +1,48 @@
+#ifndef UTILS_MEMORY_USAGE_H
+#define UTILS_MEMORY_USAGE_H
+
+#include <cstddef>
+
+/**
+ * @file memory_usage.h
+ * @brief Consulta da memória residente do processo
+ *
+ * Lê VmRSS e VmHWM de /proc/self/status (Linux). Em outras plataformas as
+ * consultas retornam 0, e quem chama deve tratar o valor como indisponível.
+ */
+
+namespace legal_doc_pipeline {
+namespace utils {
+
+    /**
+     * @brief Memória residente atual e pico do processo
+     */
+    class MemoryUsage {
+    public:
+        /**
+         * @brief Obtém a memória residente atual (VmRSS)
+         * @return Bytes residentes, ou 0 se indisponível
+         */
+        static size_t currentResidentBytes();
+
+        /**
+         * @brief Obtém o pico de memória residente (VmHWM)
+         * @return Bytes do pico, ou 0 se indisponível
+         */
+        static size_t peakResidentBytes();
+
+        /**
+         * @brief Reinicia o pico para a memória residente atual
+         *
+         * Usa /proc/self/clear_refs (Linux 4.0+), permitindo medir o pico de
+         * uma única fase do programa.
+         *
+         * @return true se o pico foi reiniciado
+         */
+        static bool resetPeak();
+    };
+
+} // namespace utils
+} // namespace legal_doc_pipeline
+
+#endif // UTILS_MEMORY_USAGE_H
@@ -0,0 +1,100 @@
+#ifndef UTILS_SIMD_TEXT_H
+#define UTILS_SIMD_TEXT_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @file simd_text.h
+ * @brief Kernels vetorizados para as etapas de texto
+ *
+ * Conversão para minúsculas (ASCII e maiúsculas Latin-1 codificadas em UTF-8,
+ * À-Þ = C3 80..C3 9E, exceto × = C3 97) e classificação de bytes de palavra
+ * usada pelos tokenizadores. Cada kernel tem versões AVX2, SSE2 e escalar; a
+ * versão é escolhida em tempo de execução conforme a CPU.
+ */
+
+namespace legal_doc_pipeline {
+namespace utils {
+
+    /**
+     * @brief Conjunto de instruções usado pelos kernels
+     */
+    enum class SimdLevel {
+        SCALAR,   ///< Laço byte a byte (qualquer arquitetura)
+        SSE2,     ///< Vetores de 16 bytes (base do x86-64)
+        AVX2      ///< Vetores de 32 bytes
+    };
+
+    /**
+     * @brief Kernels de texto com despacho em tempo de execução
+     */
+    class SimdText {
+    public:
+        /**
+         * @brief Detecta o melhor nível suportado pela CPU (resultado em cache)
+         * @return Nível de SIMD disponível
+         */
+        static SimdLevel detectLevel();
+
+        /**
+         * @brief Obtém o nome de um nível para relatórios
+         * @param level Nível de SIMD
+         * @return Nome legível ("scalar", "sse2", "avx2")
+         */
+        static const char* levelName(SimdLevel level);
+
+        /**
+         * @brief Converte para minúsculas ASCII e maiúsculas Latin-1 em UTF-8
+         *
+         * Um byte de continuação 0x80-0x9E (exceto 0x97) precedido de 0xC3 ganha
+         * 0x20; bytes ASCII 'A'-'Z' viram 'a'-'z'. Os demais bytes não mudam.
+         *
+         * @param data Buffer a ser convertido in-place
+         * @param size Tamanho do buffer
+         * @param level Nível desejado (limitado ao suportado pela CPU)
+         */
+        static void toLowerInPlace(char* data, size_t size, SimdLevel level);
+
+        /**
+         * @brief Converte para minúsculas usando o melhor nível disponível
+         * @param text Texto a ser convertido in-place
+         */
+        static void toLowerInPlace(std::string& text);
+
+        /**
+         * @brief Verifica se o byte pertence a uma palavra
+         *
+         * Mesmo conjunto de [a-zA-Z0-9À-ÿ] com regex::collate no locale "C":
+         * alfanuméricos ASCII e bytes 0x80-0xC3.
+         *
+         * @param c Byte
+         * @return true se o byte faz parte de uma palavra
+         */
+        static bool isWordByte(unsigned char c) {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                   (c >= '0' && c <= '9') || (c >= 0x80 && c <= 0xC3);
+        }
+
+        /**
+         * @brief Conta os bytes de palavra consecutivos no início do buffer
+         * @param data Início do buffer
+         * @param size Tamanho do buffer
+         * @param level Nível desejado (limitado ao suportado pela CPU)
+         * @return Número de bytes até o primeiro byte que não é de palavra
+         */
+        static size_t wordRunLength(const char* data, size_t size, SimdLevel level);
+
+        /**
+         * @brief Conta os bytes de palavra usando o melhor nível disponível
+         * @param data Início do buffer
+         * @param size Tamanho do buffer
+         * @return Número de bytes até o primeiro byte que não é de palavra
+         */
+        static size_t wordRunLength(const char* data, size_t size);
+    };
+
+} // namespace utils
+} // namespace legal_doc_pipeline
+
+#endif // UTILS_SIMD_TEXT_H
@@ -0,0 +1,110 @@
+#ifndef UTILS_THREAD_POOL_H
+#define UTILS_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file thread_pool.h
+ * @brief Pool de threads persistente compartilhado pelos modos do pipeline
+ *
+ * As threads são criadas uma vez e reaproveitadas entre execuções, de modo que
+ * lotes pequenos não pagam a criação de threads. Uma thread ociosa pode girar
+ * (spin) por algumas iterações antes de dormir na variável de condição, o que
+ * reduz a latência de despertar à custa de CPU; opcionalmente, cada thread é
+ * fixada em uma CPU (Linux).
+ *
+ * runBatch() não deve ser chamado de dentro de uma thread do próprio pool: a
+ * chamada bloqueia até o lote terminar e poderia esperar por si mesma.
+ */
+
+namespace legal_doc_pipeline {
+namespace utils {
+
+    /**
+     * @brief Opções de criação do pool
+     */
+    struct ThreadPoolOptions {
+        size_t num_threads = 0;        ///< Número de threads (0 = hardware_concurrency)
+        bool pin_threads = false;      ///< Fixa a thread i na CPU permitida i % número de CPUs permitidas (Linux)
+        size_t spin_iterations = 0;    ///< Iterações de espera ativa antes de dormir (0 = dorme direto)
+    };
+
+    /**
+     * @brief Pool de threads com fila FIFO de trabalhos
+     */
+    class ThreadPool {
+    private:
+        ThreadPoolOptions options;                  ///< Opções efetivas (num_threads já resolvido)
+        std::vector<std::thread> threads;           ///< Threads do pool
+        std::deque<std::function<void()>> jobs;     ///< Trabalhos aguardando uma thread
+        std::mutex jobs_mutex;                      ///< Protege jobs, parked_threads e stopping
+        std::condition_variable jobs_available;     ///< Acorda threads dormindo
+        std::atomic<size_t> queued_jobs;            ///< Tamanho de jobs, lido sem lock durante o spin
+        size_t parked_threads;                      ///< Threads dormindo na variável de condição
+        std::atomic<size_t> pinned_threads;         ///< Threads fixadas com sucesso em uma CPU
+        bool stopping;                              ///< Flag de destruição do pool
+
+        /**
+         * @brief Laço executado por cada thread do pool
+         * @param index Índice da thread (define a CPU quando pin_threads está ativo)
+         */
+        void workerLoop(size_t index);
+
+    public:
+        /**
+         * @brief Cria o pool e inicia as threads
+         * @param options Opções do pool
+         */
+        explicit ThreadPool(const ThreadPoolOptions& options = ThreadPoolOptions{});
+
+        /**
+         * @brief Termina os trabalhos já enfileirados e encerra as threads
+         */
+        ~ThreadPool();
+
+        /**
+         * @brief Executa job(0) ... job(count - 1) nas threads do pool e espera todos terminarem
+         *
+         * Os índices são enfileirados de uma vez; com count maior que o número de
+         * threads, os excedentes rodam conforme as threads ficam livres. A primeira
+         * exceção lançada por um job é relançada depois que o lote termina.
+         *
+         * @param count Número de invocações
+         * @param job Função chamada com o índice da invocação
+         */
+        void runBatch(size_t count, const std::function<void(size_t)>& job);
+
+        /**
+         * @brief Obtém o número de threads do pool
+         * @return Número de threads
+         */
+        size_t size() const { return threads.size(); }
+
+        /**
+         * @brief Obtém as opções efetivas do pool
+         * @return Opções (com num_threads resolvido)
+         */
+        const ThreadPoolOptions& getOptions() const { return options; }
+
+        /**
+         * @brief Obtém o número de threads fixadas em uma CPU
+         * @return Threads com afinidade aplicada (0 se pin_threads está desativado ou não é suportado)
+         */
+        size_t pinnedThreadCount() const { return pinned_threads.load(); }
+
+        // Desabilita cópia e atribuição
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+    };
+
+} // namespace utils
+} // namespace legal_doc_pipeline
+
+#endif // UTILS_THREAD_POOL_H
@@ -0,0 +1,173 @@
+#ifndef UTILS_TRACE_RECORDER_H
+#define UTILS_TRACE_RECORDER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file trace_recorder.h
+ * @brief Linha do tempo de execução exportada no formato Chrome trace
+ *
+ * Cada thread grava eventos de duração (início, fim, intervalo de
+ * documentos) num buffer próprio, localizado por um cache thread_local: o
+ * registro não usa locks nem aloca, exceto quando o buffer cresce. O arquivo
+ * gerado por writeChromeTrace abre no Perfetto (ui.perfetto.dev) ou em
+ * chrome://tracing, com uma trilha por thread.
+ *
+ * Quem instrumenta recebe um ponteiro para o gravador; com nullptr o custo é
+ * um único teste de ponteiro.
+ */
+
+namespace legal_doc_pipeline {
+namespace utils {
+
+    /**
+     * @brief Evento de duração na linha do tempo
+     */
+    struct TraceEvent {
+        static constexpr size_t NAME_CAPACITY = 47;   ///< Caracteres do nome guardados (o resto é truncado)
+
+        char name[NAME_CAPACITY + 1];   ///< Nome do evento (terminado em zero)
+        const char* category;           ///< Categoria (literal estático, ex.: "scheduler")
+        int64_t begin_ns;               ///< Início (ns desde a criação do gravador)
+        int64_t end_ns;                 ///< Fim (ns desde a criação do gravador)
+        uint64_t range_begin;           ///< Primeiro documento do intervalo
+        uint64_t range_end;             ///< Fim (exclusivo) do intervalo
+    };
+
+    /**
+     * @brief Gravador de eventos com buffers por thread
+     *
+     * record() pode ser chamado de qualquer thread; clear(), eventCount() e a
+     * exportação devem ser chamados sem gravações em andamento (entre execuções).
+     */
+    class TraceRecorder {
+    private:
+        /**
+         * @brief Eventos de uma thread
+         */
+        struct ThreadBuffer {
+            uint32_t thread_number = 0;     ///< Número sequencial da thread (tid no trace)
+            std::vector<TraceEvent> events; ///< Eventos na ordem de gravação
+            size_t dropped = 0;             ///< Eventos descartados por buffer cheio
+        };
+
+        const uint64_t recorder_id;                            ///< Identificador único (invalida caches de gravadores destruídos)
+        const size_t max_events_per_thread;                    ///< Limite de eventos por thread
+        const std::chrono::steady_clock::time_point origin;    ///< Instante zero do trace
+        mutable std::mutex buffers_mutex;                      ///< Protege buffers (só no primeiro evento de cada thread)
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;    ///< Um buffer por thread que gravou
+
+        /**
+         * @brief Buffer da thread atual, criado no primeiro uso
+         */
+        ThreadBuffer& threadBuffer();
+
+    public:
+        /**
+         * @brief Construtor
+         * @param max_events_per_thread Eventos guardados por thread; os excedentes são descartados e contados
+         */
+        explicit TraceRecorder(size_t max_events_per_thread = 1 << 20);
+
+        TraceRecorder(const TraceRecorder&) = delete;
+        TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+        /**
+         * @brief Converte um instante para a escala do trace
+         * @param time Instante do relógio monotônico
+         * @return Nanossegundos desde a criação do gravador
+         */
+        int64_t toTraceTime(std::chrono::steady_clock::time_point time) const {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(time - origin).count();
+        }
+
+        /**
+         * @brief Instante atual na escala do trace
+         * @return Nanossegundos desde a criação do gravador
+         */
+        int64_t now() const {
+            return toTraceTime(std::chrono::steady_clock::now());
+        }
+
+        /**
+         * @brief Grava um evento de duração na trilha da thread atual
+         * @param category Categoria (literal estático)
+         * @param name Nome do evento
+         * @param begin_ns Início na escala do trace
+         * @param end_ns Fim na escala do trace
+         * @param range_begin Primeiro documento do intervalo
+         * @param range_end Fim (exclusivo) do intervalo
+         */
+        void record(const char* category, std::string_view name, int64_t begin_ns, int64_t end_ns,
+                    uint64_t range_begin = 0, uint64_t range_end = 0);
+
+        /**
+         * @brief Obtém o número de eventos guardados
+         * @return Soma de todas as threads
+         */
+        size_t eventCount() const;
+
+        /**
+         * @brief Obtém o número de eventos descartados por buffer cheio
+         * @return Soma de todas as threads
+         */
+        size_t droppedEvents() const;
+
+        /**
+         * @brief Descarta os eventos gravados (a origem do trace é mantida)
+         */
+        void clear();
+
+        /**
+         * @brief Gera o JSON no formato Chrome trace (eventos "X" e nomes de thread)
+         * @return Documento JSON
+         */
+        std::string toChromeTraceJson() const;
+
+        /**
+         * @brief Grava o JSON do trace num arquivo
+         * @param path Caminho do arquivo (.json)
+         * @return true se o arquivo foi gravado
+         */
+        bool writeChromeTrace(const std::string& path) const;
+    };
+
+    /**
+     * @brief Grava um evento do início ao fim do escopo (sem efeito com gravador nulo)
+     */
+    class TraceScope {
+    private:
+        TraceRecorder* recorder;   ///< Gravador, ou nullptr
+        const char* category;      ///< Categoria do evento
+        std::string_view name;     ///< Nome do evento (deve viver até o fim do escopo)
+        uint64_t range_begin;      ///< Primeiro documento do intervalo
+        uint64_t range_end;        ///< Fim (exclusivo) do intervalo
+        int64_t begin_ns;          ///< Início na escala do trace
+
+    public:
+        TraceScope(TraceRecorder* recorder, const char* category, std::string_view name,
+                   uint64_t range_begin = 0, uint64_t range_end = 0)
+            : recorder(recorder), category(category), name(name), range_begin(range_begin),
+              range_end(range_end), begin_ns(recorder ? recorder->now() : 0) {}
+
+        ~TraceScope() {
+            if (recorder) {
+                recorder->record(category, name, begin_ns, recorder->now(), range_begin, range_end);
+            }
+        }
+
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+    };
+
+} // namespace utils
+} // namespace legal_doc_pipeline
+
+#endif // UTILS_TRACE_RECORDER_H
@@ -1,9 +1,12 @@
 #include "include/pipeline/pipeline_manager.h"
 #include "include/utils/csv_reader.h"
+#include "include/utils/mapped_csv_reader.h"
 #include "include/utils/timer.h"
 #include "include/types.h"
 #include <iostream>
+#include <iomanip>
 #include <algorithm>
+#include <cstdlib>
 #include <thread>
 
 /**
@@ -100,6 +103,34 @@ void printDetailedStats(const legal_doc_pipeline::PipelineResult& parallel_resul
     }
 }
 
+/**
+ * @brief Função para imprimir os percentis de latência por etapa do pipeline paralelo
+ * @param manager Gerenciador que executou o pipeline
+ */
+void printLatencyStats(const legal_doc_pipeline::pipeline::PipelineManager& manager) {
+    const TaskType stage_types[] = {
+        TaskType::TEXT_CLEANING, TaskType::NORMALIZATION, TaskType::WORD_TOKENIZATION,
+        TaskType::BPE_TOKENIZATION, TaskType::PARTITION_TOKENS, TaskType::ADD_SPECIAL_TOKENS,
+        TaskType::TOKENS_TO_INDICES, TaskType::GENERATE_EMBEDDINGS
+    };
+    auto stats = manager.getExecutionStats();
+
+    std::cout << "\nLatência por etapa (Scheduler, µs - espera na fila | execução p50/p95/p99):" << std::endl;
+    for (TaskType type : stage_types) {
+        const std::string prefix = std::string("latency.") + taskTypeName(type) + ".";
+        if (stats.count(prefix + "items") == 0) {
+            continue;
+        }
+        std::cout << std::setprecision(1) << "  - " << taskTypeName(type) << " (" << static_cast<size_t>(stats[prefix + "items"]) << " itens): "
+                  << stats[prefix + "queue_wait_p50_ns"] / 1000.0 << "/"
+                  << stats[prefix + "queue_wait_p95_ns"] / 1000.0 << "/"
+                  << stats[prefix + "queue_wait_p99_ns"] / 1000.0 << " | "
+                  << stats[prefix + "run_p50_ns"] / 1000.0 << "/"
+                  << stats[prefix + "run_p95_ns"] / 1000.0 << "/"
+                  << stats[prefix + "run_p99_ns"] / 1000.0 << std::endl;
+    }
+}
+
 /**
  * @brief Função principal da aplicação
  */
@@ -124,6 +155,10 @@ int main() {
     config.num_workers = max_threads;
     config.enable_debug = false;
     config.max_sequence_length = 128;
+
+    // PIPELINE_TRACE_FILE=trace.json grava a linha do tempo das execuções (abre no Perfetto)
+    const char* trace_file = std::getenv("PIPELINE_TRACE_FILE");
+    config.enable_tracing = trace_file != nullptr && trace_file[0] != '\0';
     
     std::cout << "Configuração do pipeline:" << std::endl;
     std::cout << "  - Threads disponíveis detectadas: " << max_threads << std::endl;
@@ -146,7 +181,10 @@ int main() {
             return 1;
         }
 
-        std::vector<std::string> initial_texts = csv_reader.readColumn(csv_filename, column_to_process);
+        // Parse paralelo sobre o arquivo mapeado; o pipeline recebe cópias independentes
+        legal_doc_pipeline::utils::MappedCsvReader mapped_reader(config.num_workers);
+        std::vector<std::string> initial_texts =
+            mapped_reader.readColumn(csv_filename, column_to_process).toStrings();
 
         if (initial_texts.empty()) {
             std::cerr << "Erro: Nenhum dado lido ou coluna não encontrada." << std::endl;
@@ -171,6 +209,12 @@ int main() {
 
         printDetailedStats(comparison_result.parallel_result, comparison_result.sequential_result, 
                           comparison_result.partitioned_result, config.num_workers);
+        if (comparison_result.parallel_result.success) {
+            printLatencyStats(manager);
+        }
+        if (config.enable_tracing && manager.writeTrace(trace_file)) {
+            std::cout << "\nLinha do tempo gravada em '" << trace_file << "' (abra em https://ui.perfetto.dev)" << std::endl;
+        }
 
         // 4. Verificar consistência dos resultados
         if (comparison_result.parallel_result.success && comparison_result.sequential_result.success && 
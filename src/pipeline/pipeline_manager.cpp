@@ -2,18 +2,31 @@
 #include "../../include/pipeline/text_processor.h"
 #include "../../include/scheduler/workflow_scheduler.h"
 #include "../../include/utils/timer.h"
+#include "../../include/utils/bounded_queue.h"
+#include "../../include/utils/logger.h"
+#include "../../include/utils/thread_pool.h"
+#include "../../include/utils/trace_recorder.h"
 #include <iostream>
 #include <memory>
 #include <thread>
 #include <mutex>
+#include <atomic>
 #include <algorithm>
 #include <iomanip>
+#include <chrono>
+#include <cmath>
 
 namespace legal_doc_pipeline {
 namespace pipeline {
 
     PipelineManager::PipelineManager(const PipelineConfig& config) 
-        : config(config), scheduler(std::make_unique<scheduler::WorkflowScheduler>()) {}
+        : config(config), scheduler(std::make_unique<scheduler::WorkflowScheduler>(config.scheduling_mode)) {
+        // Mensagens VERBOSE (progresso de tarefas e workers) só com enable_debug
+        utils::Logger::setLevel(config.enable_debug ? utils::LogLevel::VERBOSE : utils::LogLevel::INFO);
+        if (config.enable_tracing) {
+            trace_recorder = std::make_unique<utils::TraceRecorder>();
+        }
+    }
 
     PipelineManager::~PipelineManager() = default;
 
@@ -35,21 +48,23 @@ namespace pipeline {
             // Prepara dados
             std::vector<std::string> processed_data = prepareData(input_data);
 
-            // Configura o scheduler
-            scheduler->clear();
-            setupTasks(scheduler.get());
-            setupDependencies(scheduler.get());
+            // Reutiliza o workflow compilado; cada execução só reinicia o estado por tarefa
+            bool success = ensureWorkflow();
+            token_documents.resize(processed_data.size());
 
-            // Executa o pipeline
-            bool success = scheduler->run(processed_data, config.num_workers);
+            // Executa o pipeline nas threads persistentes
+            scheduler->setThreadPool(&workerPool());
+            scheduler->setTraceRecorder(activeTraceRecorder());
+            success = success && scheduler->run(processed_data, config.num_workers);
 
             timer.stop();
+            utils::Logger::flush();
             last_parallel_time = timer.getElapsedSeconds();
 
             if (success) {
                 result.processed_data = scheduler->getProcessedData();
                 result.execution_time = timer.getElapsedSeconds();
-                result.tasks_completed = scheduler->getExecutionStats().at("completed_tasks");
+                result.tasks_completed = scheduler->getCompletedTaskCount();
                 result.success = true;
 
                 std::cout << "--- Pipeline Paralelo Concluído ---" << std::endl;
@@ -95,37 +110,42 @@ namespace pipeline {
 
                 TextProcessor::cleanTextSequential(processed_data);
                 task_count++;
-                std::cout << "Tarefa 'CleanText' finalizada! Total concluídas: " << task_count << std::endl;
+                PIPELINE_LOG_VERBOSE("Tarefa 'CleanText' finalizada! Total concluídas: " << task_count);
 
                 TextProcessor::normalizeTextSequential(processed_data);
                 task_count++;
-                std::cout << "Tarefa 'NormalizeText' finalizada! Total concluídas: " << task_count << std::endl;
+                PIPELINE_LOG_VERBOSE("Tarefa 'NormalizeText' finalizada! Total concluídas: " << task_count);
+
+                // Da tokenização em diante os documentos seguem na forma tipada
+                const size_t count = processed_data.size();
+                std::vector<TokenizedDocument> documents(count);
 
-                TextProcessor::wordTokenizationSequential(processed_data);
+                TextProcessor::wordTokenizationRange(processed_data, documents, 0, count);
                 task_count++;
-                std::cout << "Tarefa 'WordTokenization' finalizada! Total concluídas: " << task_count << std::endl;
+                PIPELINE_LOG_VERBOSE("Tarefa 'WordTokenization' finalizada! Total concluídas: " << task_count);
 
-                TextProcessor::bpeTokenization(processed_data);
+                TextProcessor::bpeTokenizationRange(documents, 0, count, config.vocab_file, config.merges_file);
                 task_count++;
-                std::cout << "Tarefa 'BPETokenization' finalizada! Total concluídas: " << task_count << std::endl;
+                PIPELINE_LOG_VERBOSE("Tarefa 'BPETokenization' finalizada! Total concluídas: " << task_count);
 
-                TextProcessor::partitionTokens(processed_data, config.max_sequence_length);
+                TextProcessor::partitionTokensRange(documents, 0, count, config.max_sequence_length);
                 task_count++;
-                std::cout << "Tarefa 'PartitionTokens' finalizada! Total concluídas: " << task_count << std::endl;
+                PIPELINE_LOG_VERBOSE("Tarefa 'PartitionTokens' finalizada! Total concluídas: " << task_count);
 
-                TextProcessor::addSpecialTokens(processed_data);
+                TextProcessor::addSpecialTokensRange(documents, 0, count);
                 task_count++;
-                std::cout << "Tarefa 'AddSpecialTokens' finalizada! Total concluídas: " << task_count << std::endl;
+                PIPELINE_LOG_VERBOSE("Tarefa 'AddSpecialTokens' finalizada! Total concluídas: " << task_count);
 
-                TextProcessor::tokensToIndices(processed_data);
+                TextProcessor::tokensToIndicesRange(documents, 0, count);
                 task_count++;
-                std::cout << "Tarefa 'TokensToIndices' finalizada! Total concluídas: " << task_count << std::endl;
+                PIPELINE_LOG_VERBOSE("Tarefa 'TokensToIndices' finalizada! Total concluídas: " << task_count);
 
                 TextProcessor::generateEmbeddings(processed_data);
                 task_count++;
-                std::cout << "Tarefa 'GenerateEmbeddings' finalizada! Total concluídas: " << task_count << std::endl;
+                PIPELINE_LOG_VERBOSE("Tarefa 'GenerateEmbeddings' finalizada! Total concluídas: " << task_count);
 
                 timer.stop();
+                utils::Logger::flush();
                 last_sequential_time = timer.getElapsedSeconds();
 
                 result.processed_data = processed_data;
@@ -143,17 +163,21 @@ namespace pipeline {
                 sequential_scheduler->clear();
                 setupTasks(sequential_scheduler.get());
                 setupDependencies(sequential_scheduler.get());
+                token_documents.resize(processed_data.size());
 
                 // Executa com apenas 1 worker
+                sequential_scheduler->setThreadPool(&workerPool());
+                sequential_scheduler->setTraceRecorder(activeTraceRecorder());
                 bool success = sequential_scheduler->run(processed_data, 1);
 
                 timer.stop();
+                utils::Logger::flush();
                 last_sequential_time = timer.getElapsedSeconds();
 
                 if (success) {
                     result.processed_data = sequential_scheduler->getProcessedData();
                     result.execution_time = timer.getElapsedSeconds();
-                    result.tasks_completed = sequential_scheduler->getExecutionStats().at("completed_tasks");
+                    result.tasks_completed = sequential_scheduler->getCompletedTaskCount();
                     result.success = true;
 
                     std::cout << "--- Pipeline Sequencial Concluído ---" << std::endl;
@@ -188,74 +212,101 @@ namespace pipeline {
 
             timer.start();
 
-            // Prepara dados
-            std::vector<std::string> prepared_data = prepareData(input_data);
+            // Única cópia do corpus: os chunks são processados nas suas posições deste vetor
+            std::vector<std::string> processed_data = prepareData(input_data);
             
-            // Calcula o tamanho ideal do chunk
-            size_t chunk_size = calculateOptimalChunkSize(prepared_data.size(), config.num_workers);
-            std::cout << "Tamanho do chunk: " << chunk_size << " documentos por worker" << std::endl;
-
-            // Divide os dados em chunks
-            std::vector<std::vector<std::string>> data_chunks = partitionData(prepared_data, chunk_size);
-            std::cout << "Número de chunks criados: " << data_chunks.size() << std::endl;
-
-            // Processa chunks em paralelo usando threads
-            std::vector<std::thread> workers;
-            std::vector<std::vector<std::string>> processed_chunks(data_chunks.size());
-            std::vector<bool> chunk_success(data_chunks.size(), false);
-            std::mutex progress_mutex;
-            size_t completed_chunks = 0;
-
-            // Lança workers para processar chunks em paralelo
-            for (size_t i = 0; i < data_chunks.size(); ++i) {
-                workers.emplace_back([this, i, &data_chunks, &processed_chunks, &chunk_success, 
-                                   &progress_mutex, &completed_chunks]() {
-                    try {
-                        // Processa o chunk sequencialmente (pipeline completo)
-                        processed_chunks[i] = processChunkSequentially(data_chunks[i], i);
-                        chunk_success[i] = true;
-
-                        // Update progress thread-safely
-                        {
-                            std::lock_guard<std::mutex> lock(progress_mutex);
-                            completed_chunks++;
-                            std::cout << "Chunk " << i << " completado! Progresso: " 
-                                     << completed_chunks << "/" << data_chunks.size() << std::endl;
+            // O tamanho estático passa a ser só o limite superior (em documentos) de cada chunk
+            const size_t total = processed_data.size();
+            const size_t max_chunk_size = calculateOptimalChunkSize(total, config.num_workers);
+            const std::vector<uint64_t> cost_prefix = calculateCostPrefix(processed_data);
+            const uint64_t total_cost = cost_prefix.back();
+            utils::ThreadPool& pool = workerPool();
+            const size_t workers = pool.size();
+            std::cout << "Tamanho máximo do chunk: " << max_chunk_size << " documentos" << std::endl;
+
+            // Os workers reivindicam intervalos [begin, end) avançando um cursor atômico.
+            // Os intervalos são medidos em custo (bytes + custo fixo por documento): o custo
+            // de cada um diminui com o trabalho restante (guided) e respeita uma duração
+            // mínima estimada pelo tempo observado por unidade de custo
+            std::vector<std::vector<std::string>> worker_chunks(workers);
+            std::vector<double> worker_busy_time(workers, 0.0);
+            std::atomic<size_t> next_document(0);
+            std::atomic<uint64_t> processed_cost(0);
+            std::atomic<uint64_t> busy_nanoseconds(0);
+            std::atomic<size_t> chunk_count(0);
+            std::atomic<bool> failed(false);
+            std::mutex error_mutex;
+            utils::TraceRecorder* tracer = activeTraceRecorder();
+
+            pool.runBatch(workers, [&](size_t worker_index) {
+                while (!failed) {
+                    size_t begin = next_document.load();
+                    size_t end = 0;
+                    do {
+                        if (begin >= total) {
+                            return;
                         }
+                        uint64_t cost_done = processed_cost.load();
+                        double seconds_per_cost = cost_done == 0 ? 0.0
+                            : busy_nanoseconds.load() * 1e-9 / static_cast<double>(cost_done);
+                        uint64_t target_cost = calculateAdaptiveChunkCost(total_cost - cost_prefix[begin],
+                                                                          workers, seconds_per_cost);
+                        end = findChunkEnd(cost_prefix, begin, target_cost, max_chunk_size);
+                    } while (!next_document.compare_exchange_weak(begin, end));
+
+                    const size_t chunk_id = chunk_count++;
+                    try {
+                        utils::TraceScope chunk_scope(tracer, "partitioned", "Chunk", begin, end);
+                        auto chunk_start = std::chrono::steady_clock::now();
+                        // Move as strings do intervalo para o vetor do worker (sem copiar bytes),
+                        // processa o pipeline completo e devolve-as às mesmas posições
+                        std::vector<std::string>& chunk = worker_chunks[worker_index];
+                        chunk.assign(std::make_move_iterator(processed_data.begin() + begin),
+                                     std::make_move_iterator(processed_data.begin() + end));
+                        processChunkInPlace(chunk, begin);
+                        std::move(chunk.begin(), chunk.end(), processed_data.begin() + begin);
+                        chunk.clear();
+                        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - chunk_start).count();
+
+                        worker_busy_time[worker_index] += elapsed * 1e-9;
+                        busy_nanoseconds += static_cast<uint64_t>(elapsed);
+                        processed_cost += cost_prefix[end] - cost_prefix[begin];
+
+                        PIPELINE_LOG_VERBOSE("Chunk " << chunk_id << " [" << begin << ", " << end << ") completado! Progresso: "
+                                             << processed_cost.load() << "/" << total_cost << " unidades de custo");
                     } catch (const std::exception& e) {
-                        std::lock_guard<std::mutex> lock(progress_mutex);
-                        std::cerr << "Erro no chunk " << i << ": " << e.what() << std::endl;
-                        chunk_success[i] = false;
+                        failed = true;
+                        std::lock_guard<std::mutex> lock(error_mutex);
+                        std::cerr << "Erro no chunk " << chunk_id << ": " << e.what() << std::endl;
                     }
-                });
-            }
+                }
+            });
 
-            // Aguarda todos os workers terminarem
-            for (auto& worker : workers) {
-                worker.join();
+            // Desbalanceamento: o worker mais ocupado define o tempo total
+            double max_busy = *std::max_element(worker_busy_time.begin(), worker_busy_time.end());
+            double mean_busy = 0.0;
+            for (double busy : worker_busy_time) {
+                mean_busy += busy;
             }
+            mean_busy /= static_cast<double>(workers);
+            last_partitioned_imbalance = mean_busy > 0.0 ? max_busy / mean_busy : 1.0;
 
             timer.stop();
+            utils::Logger::flush();
             last_partitioned_time = timer.getElapsedSeconds();
 
-            // Verifica se todos os chunks foram processados com sucesso
-            bool all_success = true;
-            for (bool success : chunk_success) {
-                if (!success) {
-                    all_success = false;
-                    break;
-                }
-            }
-
-            if (all_success) {
-                // Reconstrói os dados processados na ordem original
-                result.processed_data = mergeProcessedChunks(processed_chunks);
+            if (!failed) {
+                result.processed_data = std::move(processed_data);
                 result.execution_time = timer.getElapsedSeconds();
-                result.tasks_completed = data_chunks.size() * 8; // 8 tarefas por chunk
+                result.tasks_completed = chunk_count.load() * 8; // 8 tarefas por chunk
+                result.load_imbalance = last_partitioned_imbalance;
                 result.success = true;
 
                 std::cout << "--- Pipeline Paralelo com Particionamento Concluído ---" << std::endl;
-                std::cout << "Chunks processados com sucesso: " << data_chunks.size() << std::endl;
+                std::cout << "Chunks processados com sucesso: " << chunk_count.load() << std::endl;
+                std::cout << "Desbalanceamento de carga (máx/média por worker): " << std::fixed
+                          << std::setprecision(2) << last_partitioned_imbalance << std::defaultfloat << std::endl;
                 std::cout << "Tempo total de execução: " << timer.getElapsedString() << std::endl;
                 std::cout << "Throughput: " << (input_data.size() / timer.getElapsedSeconds()) 
                          << " documentos/segundo" << std::endl;
@@ -272,6 +323,158 @@ namespace pipeline {
         return result;
     }
 
+    PipelineResult PipelineManager::runStreaming(const std::vector<std::string>& input_data) {
+        PipelineResult result;
+        result.success = false;
+
+        if (!validateInput(input_data)) {
+            result.error_message = "Dados de entrada inválidos";
+            return result;
+        }
+
+        const size_t batch_size = std::max<size_t>(1, config.stream_batch_size);
+        const size_t queue_capacity = std::max<size_t>(1, config.stream_queue_capacity);
+        std::vector<StreamingStage> stages = createStreamingStages();
+
+        std::cout << "\n--- Iniciando Pipeline em Streaming ---" << std::endl;
+        std::cout << "Total de documentos: " << input_data.size() << std::endl;
+        std::cout << "Lotes de " << batch_size << " documentos, filas de " << queue_capacity
+                  << " lotes entre " << stages.size() << " etapas" << std::endl;
+
+        timer.start();
+
+        // queues[i] alimenta a etapa i; a última fila recebe os lotes concluídos
+        std::vector<std::unique_ptr<utils::BoundedQueue<DocumentBatch>>> queues;
+        for (size_t i = 0; i <= stages.size(); ++i) {
+            queues.push_back(std::make_unique<utils::BoundedQueue<DocumentBatch>>(queue_capacity));
+        }
+
+        std::vector<StageStats> stage_stats(stages.size());
+        std::mutex error_mutex;
+        std::string first_error;
+
+        // Em caso de erro, fecha todas as filas para desbloquear as demais etapas
+        auto abort_pipeline = [&](const std::string& message) {
+            {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (first_error.empty()) {
+                    first_error = message;
+                }
+            }
+            for (auto& queue : queues) {
+                queue->close();
+            }
+        };
+
+        std::vector<std::thread> stage_threads;
+        for (size_t s = 0; s < stages.size(); ++s) {
+            stage_threads.emplace_back([&, s]() {
+                using clock = std::chrono::steady_clock;
+                StageStats& stats = stage_stats[s];
+                stats.name = stages[s].name;
+
+                DocumentBatch batch;
+                while (true) {
+                    auto wait_start = clock::now();
+                    bool has_batch = queues[s]->pop(batch);
+                    stats.wait_time += std::chrono::duration<double>(clock::now() - wait_start).count();
+                    if (!has_batch) {
+                        break;
+                    }
+
+                    try {
+                        auto busy_start = clock::now();
+                        stages[s].process(batch);
+                        stats.busy_time += std::chrono::duration<double>(clock::now() - busy_start).count();
+                    } catch (const std::exception& e) {
+                        abort_pipeline("Exceção na etapa '" + stages[s].name + "': " + e.what());
+                        return;
+                    }
+                    stats.documents += batch.documents.size();
+                    stats.batches++;
+
+                    wait_start = clock::now();
+                    bool accepted = queues[s + 1]->push(std::move(batch));
+                    stats.wait_time += std::chrono::duration<double>(clock::now() - wait_start).count();
+                    if (!accepted) {
+                        return;
+                    }
+                }
+                // Fim da entrada: propaga o encerramento para a próxima etapa
+                queues[s + 1]->close();
+            });
+        }
+
+        // O coletor remonta a saída na ordem original a partir de first_index
+        std::vector<std::string> output(input_data.size());
+        std::thread collector([&]() {
+            DocumentBatch batch;
+            while (queues.back()->pop(batch)) {
+                std::move(batch.documents.begin(), batch.documents.end(),
+                          output.begin() + static_cast<std::ptrdiff_t>(batch.first_index));
+            }
+        });
+
+        // Produtor: copia um lote por vez da entrada, respeitando a back-pressure
+        for (size_t first = 0; first < input_data.size(); first += batch_size) {
+            size_t last = std::min(first + batch_size, input_data.size());
+            DocumentBatch batch;
+            batch.first_index = first;
+            batch.documents.assign(input_data.begin() + static_cast<std::ptrdiff_t>(first),
+                                   input_data.begin() + static_cast<std::ptrdiff_t>(last));
+            if (!queues.front()->push(std::move(batch))) {
+                break;
+            }
+        }
+        queues.front()->close();
+
+        for (auto& stage_thread : stage_threads) {
+            stage_thread.join();
+        }
+        collector.join();
+
+        timer.stop();
+        utils::Logger::flush();
+        last_streaming_time = timer.getElapsedSeconds();
+
+        for (StageStats& stats : stage_stats) {
+            stats.throughput = stats.busy_time > 0.0 ? stats.documents / stats.busy_time : 0.0;
+        }
+
+        if (!first_error.empty()) {
+            result.error_message = first_error;
+            result.stage_stats = std::move(stage_stats);
+            return result;
+        }
+
+        result.processed_data = std::move(output);
+        result.execution_time = timer.getElapsedSeconds();
+        result.tasks_completed = stages.size();
+        result.stage_stats = std::move(stage_stats);
+        result.success = true;
+
+        // Relatório por etapa: a etapa com maior tempo ocupado limita o throughput
+        const StageStats* bottleneck = &result.stage_stats.front();
+        std::cout << "--- Pipeline em Streaming Concluído ---" << std::endl;
+        std::cout << std::fixed << std::setprecision(4);
+        std::cout << std::left << std::setw(22) << "  Etapa" << std::setw(12) << "lotes"
+                  << std::setw(14) << "ocupado (s)" << std::setw(14) << "espera (s)"
+                  << "docs/s" << std::endl;
+        for (const StageStats& stats : result.stage_stats) {
+            std::cout << "  " << std::setw(20) << stats.name << std::setw(12) << stats.batches
+                      << std::setw(14) << stats.busy_time << std::setw(14) << stats.wait_time
+                      << std::setprecision(1) << stats.throughput << std::setprecision(4) << std::endl;
+            if (stats.busy_time > bottleneck->busy_time) {
+                bottleneck = &stats;
+            }
+        }
+        std::cout << std::right;
+        std::cout << "Gargalo: " << bottleneck->name << std::endl;
+        std::cout << "Tempo total de execução (streaming): " << timer.getElapsedString() << std::endl;
+
+        return result;
+    }
+
     std::pair<PipelineResult, PipelineResult> PipelineManager::runComparison(
         const std::vector<std::string>& input_data) {
         
@@ -398,47 +601,86 @@ namespace pipeline {
         return result;
     }
 
+    bool PipelineManager::ensureWorkflow() {
+        if (workflow_owner == this && scheduler->isCompiled()) {
+            return true;
+        }
+
+        scheduler->clear();
+        setupTasks(scheduler.get());
+        setupDependencies(scheduler.get());
+        if (!scheduler->compile()) {
+            workflow_owner = nullptr;
+            return false;
+        }
+        workflow_owner = this;
+        return true;
+    }
+
+    utils::ThreadPool& PipelineManager::workerPool() {
+        const size_t threads = static_cast<size_t>(std::max(config.num_workers, 1));
+        if (!thread_pool ||
+            thread_pool->size() != threads ||
+            thread_pool->getOptions().pin_threads != config.pin_worker_threads ||
+            thread_pool->getOptions().spin_iterations != config.worker_spin_iterations) {
+            utils::ThreadPoolOptions options;
+            options.num_threads = threads;
+            options.pin_threads = config.pin_worker_threads;
+            options.spin_iterations = config.worker_spin_iterations;
+            thread_pool = std::make_unique<utils::ThreadPool>(options);
+        }
+        return *thread_pool;
+    }
+
+    utils::TraceRecorder* PipelineManager::activeTraceRecorder() const {
+        return config.enable_tracing ? trace_recorder.get() : nullptr;
+    }
+
     void PipelineManager::setupTasks(scheduler::WorkflowScheduler* scheduler_ptr) {
-        // Adiciona as tarefas com suas prioridades
+        // Adiciona as tarefas com suas prioridades; cada etapa é data-parallel e o
+        // scheduler a divide em intervalos de documentos (task_grain_size).
+        // De WordTokenization a TokensToIndices os tokens ficam em token_documents;
+        // os textos só voltam a ser escritos por GenerateEmbeddings.
         scheduler_ptr->addTask(Task("CleanText", TaskType::TEXT_CLEANING, 10, 
-                                   [](std::vector<std::string>& texts) { 
-                                       TextProcessor::cleanText(texts); 
-                                   }));
+                                   [](std::vector<std::string>& texts, size_t begin, size_t end) { 
+                                       TextProcessor::cleanTextRange(texts, begin, end); 
+                                   }, config.task_grain_size));
 
         scheduler_ptr->addTask(Task("NormalizeText", TaskType::NORMALIZATION, 20, 
-                                   [](std::vector<std::string>& texts) { 
-                                       TextProcessor::normalizeText(texts); 
-                                   }));
+                                   [](std::vector<std::string>& texts, size_t begin, size_t end) { 
+                                       TextProcessor::normalizeTextRange(texts, begin, end); 
+                                   }, config.task_grain_size));
 
         scheduler_ptr->addTask(Task("WordTokenization", TaskType::WORD_TOKENIZATION, 30, 
-                                   [](std::vector<std::string>& texts) { 
-                                       TextProcessor::wordTokenization(texts); 
-                                   }));
+                                   [this](std::vector<std::string>& texts, size_t begin, size_t end) { 
+                                       TextProcessor::wordTokenizationRange(texts, token_documents, begin, end); 
+                                   }, config.task_grain_size));
 
         scheduler_ptr->addTask(Task("BPETokenization", TaskType::BPE_TOKENIZATION, 40, 
-                                   [](std::vector<std::string>& texts) { 
-                                       TextProcessor::bpeTokenization(texts); 
-                                   }));
+                                   [this](std::vector<std::string>&, size_t begin, size_t end) { 
+                                       TextProcessor::bpeTokenizationRange(token_documents, begin, end,
+                                                                           config.vocab_file, config.merges_file); 
+                                   }, config.task_grain_size));
 
         scheduler_ptr->addTask(Task("PartitionTokens", TaskType::PARTITION_TOKENS, 50, 
-                                   [this](std::vector<std::string>& texts) { 
-                                       TextProcessor::partitionTokens(texts, config.max_sequence_length); 
-                                   }));
+                                   [this](std::vector<std::string>&, size_t begin, size_t end) { 
+                                       TextProcessor::partitionTokensRange(token_documents, begin, end, config.max_sequence_length); 
+                                   }, config.task_grain_size));
 
         scheduler_ptr->addTask(Task("AddSpecialTokens", TaskType::ADD_SPECIAL_TOKENS, 60, 
-                                   [](std::vector<std::string>& texts) { 
-                                       TextProcessor::addSpecialTokens(texts); 
-                                   }));
+                                   [this](std::vector<std::string>&, size_t begin, size_t end) { 
+                                       TextProcessor::addSpecialTokensRange(token_documents, begin, end); 
+                                   }, config.task_grain_size));
 
         scheduler_ptr->addTask(Task("TokensToIndices", TaskType::TOKENS_TO_INDICES, 70, 
-                                   [](std::vector<std::string>& texts) { 
-                                       TextProcessor::tokensToIndices(texts); 
-                                   }));
+                                   [this](std::vector<std::string>&, size_t begin, size_t end) { 
+                                       TextProcessor::tokensToIndicesRange(token_documents, begin, end); 
+                                   }, config.task_grain_size));
 
         scheduler_ptr->addTask(Task("GenerateEmbeddings", TaskType::GENERATE_EMBEDDINGS, 80, 
-                                   [](std::vector<std::string>& texts) { 
-                                       TextProcessor::generateEmbeddings(texts); 
-                                   }));
+                                   [](std::vector<std::string>& texts, size_t begin, size_t end) { 
+                                       TextProcessor::generateEmbeddingsRange(texts, begin, end); 
+                                   }, config.task_grain_size));
     }
 
     void PipelineManager::setupDependencies(scheduler::WorkflowScheduler* scheduler_ptr) {
@@ -452,6 +694,59 @@ namespace pipeline {
         scheduler_ptr->addDependency("GenerateEmbeddings", "TokensToIndices");
     }
 
+    std::vector<StreamingStage> PipelineManager::createStreamingStages() const {
+        // Mesmas etapas de setupTasks, aplicadas ao lote inteiro
+        const size_t max_length = config.max_sequence_length;
+        const std::string vocab_file = config.vocab_file;
+        const std::string merges_file = config.merges_file;
+        const bool use_arena = config.use_batch_arena;
+        return {
+            {"CleanText", [](DocumentBatch& batch) {
+                TextProcessor::cleanTextRange(batch.documents, 0, batch.documents.size());
+            }},
+            {"NormalizeText", [](DocumentBatch& batch) {
+                TextProcessor::normalizeTextRange(batch.documents, 0, batch.documents.size());
+            }},
+            {"WordTokenization", [use_arena](DocumentBatch& batch) {
+                std::pmr::memory_resource* resource = std::pmr::get_default_resource();
+                if (use_arena) {
+                    // Bloco inicial proporcional ao texto: em geral uma única alocação por lote
+                    size_t text_bytes = 0;
+                    for (const std::string& document : batch.documents) {
+                        text_bytes += document.size();
+                    }
+                    batch.arena = std::make_unique<utils::ArenaResource>(text_bytes * 4 + 4096);
+                    resource = batch.arena.get();
+                }
+                batch.tokens.clear();
+                batch.tokens.reserve(batch.documents.size());
+                for (size_t i = 0; i < batch.documents.size(); ++i) {
+                    batch.tokens.emplace_back(resource);
+                }
+                TextProcessor::wordTokenizationRange(batch.documents, batch.tokens, 0, batch.documents.size());
+            }},
+            {"BPETokenization", [vocab_file, merges_file](DocumentBatch& batch) {
+                TextProcessor::bpeTokenizationRange(batch.tokens, 0, batch.tokens.size(), vocab_file, merges_file);
+            }},
+            {"PartitionTokens", [max_length](DocumentBatch& batch) {
+                TextProcessor::partitionTokensRange(batch.tokens, 0, batch.tokens.size(), max_length);
+            }},
+            {"AddSpecialTokens", [](DocumentBatch& batch) {
+                TextProcessor::addSpecialTokensRange(batch.tokens, 0, batch.tokens.size());
+            }},
+            {"TokensToIndices", [](DocumentBatch& batch) {
+                TextProcessor::tokensToIndicesRange(batch.tokens, 0, batch.tokens.size());
+            }},
+            {"GenerateEmbeddings", [](DocumentBatch& batch) {
+                TextProcessor::generateEmbeddingsRange(batch.documents, 0, batch.documents.size(),
+                                                       batch.first_index);
+                // Os tokens morrem antes da arena, que devolve toda a memória do lote de uma vez
+                batch.tokens.clear();
+                batch.arena.reset();
+            }}
+        };
+    }
+
     bool PipelineManager::validateInput(const std::vector<std::string>& input_data) {
         if (input_data.empty()) {
             std::cerr << "Erro: Dados de entrada vazios" << std::endl;
@@ -487,6 +782,16 @@ namespace pipeline {
 
     void PipelineManager::updateConfig(const PipelineConfig& new_config) {
         config = new_config;
+        utils::Logger::setLevel(config.enable_debug ? utils::LogLevel::VERBOSE : utils::LogLevel::INFO);
+        // Ligar o tracing preserva os eventos já gravados
+        if (config.enable_tracing && !trace_recorder) {
+            trace_recorder = std::make_unique<utils::TraceRecorder>();
+        }
+        if (scheduler) {
+            scheduler->setSchedulingMode(config.scheduling_mode);
+        }
+        // A granularidade das tarefas é copiada na montagem do workflow
+        workflow_owner = nullptr;
     }
 
     std::map<std::string, double> PipelineManager::getExecutionStats() const {
@@ -495,24 +800,49 @@ namespace pipeline {
         stats["parallel_time"] = last_parallel_time;
         stats["sequential_time"] = last_sequential_time;
         stats["partitioned_time"] = last_partitioned_time;
+        stats["partitioned_load_imbalance"] = last_partitioned_imbalance;
+        stats["streaming_time"] = last_streaming_time;
         
         if (scheduler) {
             auto scheduler_stats = scheduler->getExecutionStats();
             stats["completed_tasks"] = static_cast<double>(scheduler_stats["completed_tasks"]);
             stats["total_tasks"] = static_cast<double>(scheduler_stats["total_tasks"]);
+
+            // Percentis por tipo de tarefa da última execução de runParallel
+            for (const auto& entry : scheduler_stats) {
+                if (entry.first.compare(0, 8, "latency.") == 0) {
+                    stats[entry.first] = static_cast<double>(entry.second);
+                }
+            }
         }
         
         return stats;
     }
 
+    utils::TraceRecorder* PipelineManager::getTraceRecorder() const {
+        return trace_recorder.get();
+    }
+
+    bool PipelineManager::writeTrace(const std::string& path) const {
+        if (!trace_recorder) {
+            std::cerr << "Erro: tracing desligado (PipelineConfig::enable_tracing); nenhum trace para gravar" << std::endl;
+            return false;
+        }
+        return trace_recorder->writeChromeTrace(path);
+    }
+
     void PipelineManager::reset() {
         if (scheduler) {
             scheduler->clear();
         }
+        workflow_owner = nullptr;
+        token_documents.clear();
         timer.reset();
         last_parallel_time = 0.0;
         last_sequential_time = 0.0;
         last_partitioned_time = 0.0;
+        last_partitioned_imbalance = 0.0;
+        last_streaming_time = 0.0;
     }
 
     size_t PipelineManager::calculateOptimalChunkSize(size_t total_size, size_t num_workers) {
@@ -532,68 +862,110 @@ namespace pipeline {
         
         if (base_chunk_size < MIN_CHUNK_SIZE) {
             // Se chunks ficarem muito pequenos, prefere menos workers
-            return std::min(static_cast<size_t>(total_size / (num_workers / 2)), MAX_CHUNK_SIZE);
+            return std::min(static_cast<size_t>(total_size / std::max<size_t>(1, num_workers / 2)), MAX_CHUNK_SIZE);
         }
         
         return std::min(base_chunk_size, MAX_CHUNK_SIZE);
     }
 
-    std::vector<std::vector<std::string>> PipelineManager::partitionData(
-        const std::vector<std::string>& data, size_t chunk_size) {
-        
-        std::vector<std::vector<std::string>> chunks;
-        
-        for (size_t i = 0; i < data.size(); i += chunk_size) {
-            size_t end = std::min(i + chunk_size, data.size());
-            std::vector<std::string> chunk(data.begin() + i, data.begin() + end);
-            chunks.push_back(std::move(chunk));
+    std::vector<uint64_t> PipelineManager::calculateCostPrefix(const std::vector<std::string>& data) {
+        // O custo fixo cobre o que não depende do tamanho: cópias, alocações, tokens especiais
+        const uint64_t DOCUMENT_BASE_COST = 256;
+        std::vector<uint64_t> prefix(data.size() + 1, 0);
+        for (size_t i = 0; i < data.size(); ++i) {
+            prefix[i + 1] = prefix[i] + data[i].size() + DOCUMENT_BASE_COST;
         }
-        
-        return chunks;
+        return prefix;
+    }
+
+    uint64_t PipelineManager::calculateAdaptiveChunkCost(uint64_t remaining_cost, size_t num_workers,
+                                                         double seconds_per_cost) {
+        if (remaining_cost == 0) {
+            return 0;
+        }
+
+        // Guided: metade do trabalho restante dividida entre os workers, para que os
+        // últimos chunks sejam pequenos e os workers terminem juntos
+        uint64_t workers = std::max<size_t>(1, num_workers);
+        uint64_t target_cost = (remaining_cost + 2 * workers - 1) / (2 * workers);
+
+        // Chunks mais curtos que MIN_CHUNK_SECONDS gastam mais com reivindicação e cópia que com trabalho
+        const double MIN_CHUNK_SECONDS = 0.001;
+        if (seconds_per_cost > 0.0) {
+            double min_cost = std::ceil(MIN_CHUNK_SECONDS / seconds_per_cost);
+            if (min_cost > static_cast<double>(target_cost)) {
+                target_cost = min_cost >= static_cast<double>(remaining_cost)
+                    ? remaining_cost : static_cast<uint64_t>(min_cost);
+            }
+        }
+        return std::min(target_cost, remaining_cost);
+    }
+
+    size_t PipelineManager::findChunkEnd(const std::vector<uint64_t>& cost_prefix, size_t begin,
+                                         uint64_t target_cost, size_t max_chunk_size) {
+        const size_t total = cost_prefix.size() - 1;
+        const size_t limit = std::min(total, begin + std::max<size_t>(1, max_chunk_size));
+        // Primeiro end com custo acumulado >= alvo; um documento maior que o alvo forma um chunk sozinho
+        auto it = std::lower_bound(cost_prefix.begin() + begin + 1, cost_prefix.begin() + limit + 1,
+                                   cost_prefix[begin] + target_cost);
+        size_t end = static_cast<size_t>(it - cost_prefix.begin());
+        return std::max(begin + 1, std::min(end, limit));
     }
 
     std::vector<std::string> PipelineManager::processChunkSequentially(
-        const std::vector<std::string>& chunk_data, size_t chunk_id) {
-        
-        // Cria uma cópia local dos dados para processamento
-        std::vector<std::string> processed_data = chunk_data;
-        
-        // Aplica todas as etapas do pipeline sequencialmente neste chunk
-        // Isso garante que cada chunk passe pelo pipeline completo independentemente
+        const std::vector<std::string>& chunk_data, size_t chunk_id, size_t first_index) {
         
         // Note: chunk_id é usado apenas para debug/logging se necessário
         (void)chunk_id; // Suprime warning de parâmetro não usado
         
-        TextProcessor::cleanTextSequential(processed_data);
-        TextProcessor::normalizeTextSequential(processed_data);
-        TextProcessor::wordTokenizationSequential(processed_data);
-        TextProcessor::bpeTokenization(processed_data);
-        TextProcessor::partitionTokens(processed_data, config.max_sequence_length);
-        TextProcessor::addSpecialTokens(processed_data);
-        TextProcessor::tokensToIndices(processed_data);
-        TextProcessor::generateEmbeddings(processed_data);
-        
+        std::vector<std::string> processed_data = chunk_data;
+        processChunkInPlace(processed_data, first_index);
         return processed_data;
     }
 
-    std::vector<std::string> PipelineManager::mergeProcessedChunks(
-        const std::vector<std::vector<std::string>>& processed_chunks) {
-        
-        std::vector<std::string> merged_data;
-        
-        // Calcula o tamanho total para pré-alocar memória
-        size_t total_size = 0;
-        for (const auto& chunk : processed_chunks) {
-            total_size += chunk.size();
+    void PipelineManager::processChunkInPlace(std::vector<std::string>& chunk, size_t first_index) {
+        // Aplica todas as etapas do pipeline sequencialmente neste chunk
+        // Isso garante que cada chunk passe pelo pipeline completo independentemente
+        const size_t count = chunk.size();
+        const size_t last_index = first_index + count;
+        utils::TraceRecorder* tracer = activeTraceRecorder();
+        {
+            utils::TraceScope scope(tracer, "partitioned", "CleanText", first_index, last_index);
+            TextProcessor::cleanTextRange(chunk, 0, count);
         }
-        merged_data.reserve(total_size);
-        
-        // Reconstrói os dados na ordem original
-        for (const auto& chunk : processed_chunks) {
-            merged_data.insert(merged_data.end(), chunk.begin(), chunk.end());
+        {
+            utils::TraceScope scope(tracer, "partitioned", "NormalizeText", first_index, last_index);
+            TextProcessor::normalizeTextRange(chunk, 0, count);
         }
-        
-        return merged_data;
+
+        // As etapas tipadas rodam em sub-lotes, liberando os tokens de cada um em
+        // seguida: só TOKEN_BATCH_SIZE documentos tokenizados existem por vez.
+        // Com a arena (uma por thread), todos os sub-lotes e chunks reaproveitam os mesmos blocos
+        const size_t TOKEN_BATCH_SIZE = 64;
+        thread_local utils::ArenaResource arena;
+        std::pmr::memory_resource* resource = config.use_batch_arena ? &arena : std::pmr::get_default_resource();
+        std::vector<TokenizedDocument> documents;
+        documents.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            documents.emplace_back(resource);
+        }
+        for (size_t begin = 0; begin < count; begin += TOKEN_BATCH_SIZE) {
+            size_t end = std::min(begin + TOKEN_BATCH_SIZE, count);
+            // WordTokenization a TokensToIndices intercalados por sub-lote: um evento por sub-lote
+            utils::TraceScope scope(tracer, "partitioned", "TokenizeBatch", first_index + begin, first_index + end);
+            TextProcessor::wordTokenizationRange(chunk, documents, begin, end);
+            TextProcessor::bpeTokenizationRange(documents, begin, end, config.vocab_file, config.merges_file);
+            TextProcessor::partitionTokensRange(documents, begin, end, config.max_sequence_length);
+            TextProcessor::addSpecialTokensRange(documents, begin, end);
+            TextProcessor::tokensToIndicesRange(documents, begin, end);
+            for (size_t i = begin; i < end; ++i) {
+                documents[i].releaseMemory();
+            }
+            arena.release();
+        }
+        // Numeração global: o documento i do chunk é o documento first_index + i do corpus
+        utils::TraceScope scope(tracer, "partitioned", "GenerateEmbeddings", first_index, last_index);
+        TextProcessor::generateEmbeddingsRange(chunk, 0, count, first_index);
     }
 
 } // namespace pipeline
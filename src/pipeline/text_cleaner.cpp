@@ -0,0 +1,167 @@
+#include "../../include/pipeline/text_cleaner.h"
+#include <array>
+#include <cstring>
+#include <regex>
+
+namespace legal_doc_pipeline {
+namespace pipeline {
+
+    namespace {
+
+        /**
+         * @brief Tabela dos bytes mantidos pela cadeia de regex original
+         *
+         * "À-ÿ" no fonte UTF-8 é a sequência C3 80 '-' C3 BF; com regex::collate
+         * no locale "C" a classe [^a-zA-Z0-9\sÀ-ÿ] mantém os bytes 0x80-0xC3 e
+         * descarta 0xC4-0xFF. Espaços em branco não entram na tabela: assim como
+         * os bytes descartados, viram um separador colapsado.
+         */
+        constexpr std::array<bool, 256> makeKeptBytes() {
+            std::array<bool, 256> table{};
+            for (int c = 'a'; c <= 'z'; ++c) table[c] = true;
+            for (int c = 'A'; c <= 'Z'; ++c) table[c] = true;
+            for (int c = '0'; c <= '9'; ++c) table[c] = true;
+            for (int c = 0x80; c <= 0xC3; ++c) table[c] = true;
+            return table;
+        }
+
+        constexpr std::array<bool, 256> KEPT_BYTES = makeKeptBytes();
+
+        /**
+         * @brief Verifica se text[pos..] começa com o literal
+         */
+        template <size_t N>
+        inline bool startsWith(const std::string& text, size_t pos, const char (&literal)[N]) {
+            return text.size() - pos >= N - 1 && std::memcmp(text.data() + pos, literal, N - 1) == 0;
+        }
+
+        /**
+         * @brief Tamanho da entidade decodificada para um único caractere em pos (0 se nenhuma)
+         *
+         * &amp; é decodificado antes das demais, então "&amp;lt;" vira "&lt;" e
+         * depois "<": a entidade encadeada é consumida junto.
+         */
+        inline size_t matchEntity(const std::string& text, size_t pos) {
+            if (startsWith(text, pos, "&amp;")) {
+                size_t next = pos + 5;
+                if (startsWith(text, next, "lt;") || startsWith(text, next, "gt;")) {
+                    return 8;
+                }
+                if (startsWith(text, next, "quot;") || startsWith(text, next, "apos;") ||
+                    startsWith(text, next, "nbsp;")) {
+                    return 10;
+                }
+                return 5;
+            }
+            if (startsWith(text, pos, "&lt;") || startsWith(text, pos, "&gt;")) {
+                return 4;
+            }
+            if (startsWith(text, pos, "&quot;") || startsWith(text, pos, "&apos;") ||
+                startsWith(text, pos, "&nbsp;")) {
+                return 6;
+            }
+            return 0;
+        }
+
+        /**
+         * @brief Posição do '>' que fecha a tag aberta em pos (npos se não houver)
+         *
+         * Equivale a "<.*?>": o '.' do ECMAScript não casa com '\n' nem '\r'.
+         */
+        inline size_t findTagEnd(const std::string& text, size_t pos) {
+            for (size_t i = pos + 1; i < text.size(); ++i) {
+                char c = text[i];
+                if (c == '>') return i;
+                if (c == '\n' || c == '\r') return std::string::npos;
+            }
+            return std::string::npos;
+        }
+
+        /**
+         * @brief Posição do primeiro '\n' ou '\r' a partir de pos (size() se não houver)
+         */
+        inline size_t findLineEnd(const std::string& text, size_t pos) {
+            size_t end = text.find_first_of("\n\r", pos);
+            return end == std::string::npos ? text.size() : end;
+        }
+
+    } // namespace
+
+    void TextCleaner::cleanInPlace(std::string& text) {
+        // Cada byte lido produz no máximo um byte de saída, então a escrita
+        // (out) nunca ultrapassa a leitura (in) e o buffer pode ser reutilizado
+        const size_t size = text.size();
+        char* data = &text[0];
+        size_t out = 0;
+        size_t in = 0;
+        bool pending_space = false;
+        size_t no_tag_until = 0;   // '<' antes desta posição não tem '>' na mesma linha
+
+        while (in < size) {
+            unsigned char c = static_cast<unsigned char>(data[in]);
+
+            if (KEPT_BYTES[c]) {
+                if (pending_space && out > 0) {
+                    data[out++] = ' ';
+                }
+                pending_space = false;
+                data[out++] = static_cast<char>(c);
+                ++in;
+                continue;
+            }
+
+            // Tags, entidades, caracteres filtrados e espaços viram um separador
+            pending_space = true;
+            if (c == '<' && in >= no_tag_until) {
+                size_t tag_end = findTagEnd(text, in);
+                if (tag_end == std::string::npos) {
+                    // Evita reexaminar a mesma linha para cada '<' sem fechamento
+                    no_tag_until = findLineEnd(text, in);
+                    ++in;
+                } else {
+                    in = tag_end + 1;
+                }
+            } else if (c == '&') {
+                size_t entity_length = matchEntity(text, in);
+                in += entity_length > 0 ? entity_length : 1;
+            } else {
+                ++in;
+            }
+        }
+
+        // O espaço pendente no fim é descartado (trim)
+        text.resize(out);
+    }
+
+    std::string TextCleaner::clean(const std::string& text) {
+        std::string result = text;
+        cleanInPlace(result);
+        return result;
+    }
+
+    void TextCleaner::cleanWithRegex(std::string& text) {
+        // Remove tags HTML
+        text = std::regex_replace(text, std::regex("<.*?>"), " ");
+
+        // Decodifica entidades HTML comuns
+        text = std::regex_replace(text, std::regex("&amp;"), "&");
+        text = std::regex_replace(text, std::regex("&lt;"), "<");
+        text = std::regex_replace(text, std::regex("&gt;"), ">");
+        text = std::regex_replace(text, std::regex("&quot;"), "\"");
+        text = std::regex_replace(text, std::regex("&apos;"), "'");
+        text = std::regex_replace(text, std::regex("&nbsp;"), " ");
+
+        // Mantém apenas caracteres alfanuméricos, acentuados e espaços
+        text = std::regex_replace(text,
+            std::regex("[^a-zA-Z0-9\\sÀ-ÿ]", std::regex::ECMAScript | std::regex::collate),
+            " ");
+
+        // Substitui múltiplos espaços por um único espaço
+        text = std::regex_replace(text, std::regex("\\s+"), " ");
+
+        // Remove espaços no início e fim
+        text = std::regex_replace(text, std::regex("^\\s+|\\s+$"), "");
+    }
+
+} // namespace pipeline
+} // namespace legal_doc_pipeline
@@ -1,23 +1,135 @@
 #include "../../include/pipeline/text_processor.h"
-#include "../../include/tokenizer/tokenizer_wrapper.h"
+#include "../../include/pipeline/text_cleaner.h"
+#include "../../include/utils/logger.h"
+#include "../../include/utils/simd_text.h"
+#include "../../include/tokenizer/tokenizer_registry.h"
 #include <algorithm>
-#include <regex>
+#include <cctype>
+#include <charconv>
+#include <cstring>
 #include <iostream>
-#include <sstream>
-#include <numeric>
 #include <thread>
 #include <chrono>
 
 namespace legal_doc_pipeline {
 namespace pipeline {
 
+    namespace {
+
+        /**
+         * @brief Verifica se o byte é uma pontuação emitida como token próprio
+         */
+        inline bool isPunctuationByte(unsigned char c) {
+            switch (c) {
+                case '.': case ',': case '!': case '?': case ';': case ':':
+                case '"': case '\'': case '(': case ')': case '[': case ']':
+                case '{': case '}':
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        /**
+         * @brief Percorre palavras e pontuação do texto
+         *
+         * Equivalente a iterar "[a-zA-Z0-9À-ÿ]+|[.,!?;:\"'()\[\]{}]" (regex::collate);
+         * os demais bytes são descartados.
+         *
+         * @param text Texto de entrada
+         * @param emit Chamado com (início, tamanho) de cada token
+         */
+        template <typename EmitToken>
+        void scanWordTokens(const std::string& text, EmitToken emit) {
+            const char* data = text.data();
+            const size_t size = text.size();
+            size_t i = 0;
+            while (i < size) {
+                unsigned char c = static_cast<unsigned char>(data[i]);
+                size_t token_length = 0;
+                if (utils::SimdText::isWordByte(c)) {
+                    token_length = utils::SimdText::wordRunLength(data + i, size - i);
+                } else if (isPunctuationByte(c)) {
+                    token_length = 1;
+                } else {
+                    ++i;
+                    continue;
+                }
+                emit(data + i, token_length);
+                i += token_length;
+            }
+        }
+
+        /**
+         * @brief Separa palavras e pontuação por espaço simples
+         *
+         * O resultado é montado num buffer por thread e copiado de volta para o
+         * texto, que reaproveita a própria capacidade entre execuções.
+         */
+        void tokenizeWords(std::string& text) {
+            thread_local std::string buffer;
+            buffer.clear();
+            buffer.reserve(text.size() * 2);
+
+            scanWordTokens(text, [](const char* token, size_t length) {
+                if (!buffer.empty()) {
+                    buffer.push_back(' ');
+                }
+                buffer.append(token, length);
+            });
+            text.assign(buffer);
+        }
+
+        /**
+         * @brief Verifica se o byte separa tokens (mesmo critério de std::istream >>)
+         */
+        inline bool isSpaceByte(char c) {
+            return std::isspace(static_cast<unsigned char>(c)) != 0;
+        }
+
+        /**
+         * @brief Percorre os tokens separados por espaço em branco
+         * @param text Texto de entrada
+         * @param visit Chamado com a view de cada token; retorna false para parar
+         */
+        template <typename VisitToken>
+        void scanWhitespaceTokens(std::string_view text, VisitToken visit) {
+            size_t i = 0;
+            while (i < text.size()) {
+                while (i < text.size() && isSpaceByte(text[i])) {
+                    ++i;
+                }
+                size_t start = i;
+                while (i < text.size() && !isSpaceByte(text[i])) {
+                    ++i;
+                }
+                if (i > start && !visit(text.substr(start, i - start))) {
+                    return;
+                }
+            }
+        }
+
+        /**
+         * @brief Verifica se o token é um dos especiais ([CLS], [SEP], [EOF])
+         */
+        inline bool isSpecialToken(std::string_view token) {
+            return token == "[CLS]" || token == "[SEP]" || token == "[EOF]";
+        }
+
+    } // namespace
+
     // Inicialização das variáveis estáticas
-    std::map<std::string, int> TextProcessor::vocabulary;
-    bool TextProcessor::vocabulary_initialized = false;
+    std::map<std::string, int, std::less<>> TextProcessor::vocabulary;
+    std::atomic<bool> TextProcessor::vocabulary_initialized{false};
+    std::mutex TextProcessor::vocabulary_mutex;
     const int TextProcessor::UNK_TOKEN_ID;
 
     void TextProcessor::initializeVocabulary() {
         if (vocabulary_initialized) return;
+
+        // Intervalos da mesma etapa podem chegar aqui ao mesmo tempo
+        std::lock_guard<std::mutex> lock(vocabulary_mutex);
+        if (vocabulary_initialized) return;
         
         // Vocabulário simulado para mapeamento de tokens para IDs
         vocabulary = {
@@ -36,215 +148,308 @@ namespace pipeline {
     }
 
     void TextProcessor::cleanText(std::vector<std::string>& texts) {
-        std::cout << "  [Task] Executando CleanText..." << std::endl;
-        
-        for (std::string& text : texts) {
-            // Remove tags HTML
-            text = std::regex_replace(text, std::regex("<.*?>"), " ");
-            
-            // Decodifica entidades HTML comuns
-            text = std::regex_replace(text, std::regex("&amp;"), "&");
-            text = std::regex_replace(text, std::regex("&lt;"), "<");
-            text = std::regex_replace(text, std::regex("&gt;"), ">");
-            text = std::regex_replace(text, std::regex("&quot;"), "\"");
-            text = std::regex_replace(text, std::regex("&apos;"), "'");
-            text = std::regex_replace(text, std::regex("&nbsp;"), " ");
-            
-            // Mantém apenas caracteres alfanuméricos, acentuados e espaços
-            text = std::regex_replace(text, 
-                std::regex("[^a-zA-Z0-9\\sÀ-ÿ]", std::regex::ECMAScript | std::regex::collate), 
-                " ");
-            
-            // Substitui múltiplos espaços por um único espaço
-            text = std::regex_replace(text, std::regex("\\s+"), " ");
-            
-            // Remove espaços no início e fim
-            text = std::regex_replace(text, std::regex("^\\s+|\\s+$"), "");
+        PIPELINE_LOG_VERBOSE("  [Task] Executando CleanText...");
+        cleanTextRange(texts, 0, texts.size());
+        PIPELINE_LOG_VERBOSE("  [Task] CleanText concluído.");
+    }
+
+    void TextProcessor::cleanTextRange(std::vector<std::string>& texts, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            // Remove tags, decodifica entidades, filtra caracteres, colapsa e apara
+            // espaços numa única passada (mesma saída da antiga cadeia de regex)
+            TextCleaner::cleanInPlace(texts[i]);
         }
-        
-        std::cout << "  [Task] CleanText concluído." << std::endl;
     }
 
     void TextProcessor::normalizeText(std::vector<std::string>& texts) {
-        std::cout << "  [Task] Executando NormalizeText..." << std::endl;
-        
-        for (std::string& text : texts) {
-            std::transform(text.begin(), text.end(), text.begin(),
-                          [](unsigned char c){ return std::tolower(c); });
+        PIPELINE_LOG_VERBOSE("  [Task] Executando NormalizeText...");
+        normalizeTextRange(texts, 0, texts.size());
+        PIPELINE_LOG_VERBOSE("  [Task] NormalizeText concluído.");
+    }
+
+    void TextProcessor::normalizeTextRange(std::vector<std::string>& texts, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            // Minúsculas ASCII e Latin-1 (À-Þ em UTF-8) com kernels vetorizados
+            utils::SimdText::toLowerInPlace(texts[i]);
         }
-        
-        std::cout << "  [Task] NormalizeText concluído." << std::endl;
     }
 
     void TextProcessor::wordTokenization(std::vector<std::string>& texts) {
-        std::cout << "  [Task] Executando WordTokenization (aprimorado)..." << std::endl;
-        
-        // Expressão regular para encontrar palavras e pontuação
-        std::regex word_punct_regex("[a-zA-Z0-9À-ÿ]+|[.,!?;:\"'()\\[\\]{}]", 
-                                   std::regex::ECMAScript | std::regex::collate);
-
-        for (std::string& text : texts) {
-            std::vector<std::string> tokens;
-            auto words_begin = std::sregex_iterator(text.begin(), text.end(), word_punct_regex);
-            auto words_end = std::sregex_iterator();
-
-            for (std::sregex_iterator i = words_begin; i != words_end; ++i) {
-                std::smatch match = *i;
-                std::string token = match.str();
-                
-                // Filtra tokens vazios ou de apenas espaço
-                if (!token.empty() && !std::all_of(token.begin(), token.end(), ::isspace)) {
-                    tokens.push_back(token);
-                }
-            }
-            
-            // Reconstrói o texto como uma string de tokens separados por espaço
-            text = std::accumulate(tokens.begin(), tokens.end(), std::string(),
-                                  [](const std::string& a, const std::string& b) {
-                                      return a.empty() ? b : a + " " + b;
-                                  });
+        PIPELINE_LOG_VERBOSE("  [Task] Executando WordTokenization (aprimorado)...");
+        wordTokenizationRange(texts, 0, texts.size());
+        PIPELINE_LOG_VERBOSE("  [Task] WordTokenization concluído.");
+    }
+
+    void TextProcessor::wordTokenizationRange(std::vector<std::string>& texts, size_t begin, size_t end) {
+        for (size_t idx = begin; idx < end; ++idx) {
+            tokenizeWords(texts[idx]);
         }
-        
-        std::cout << "  [Task] WordTokenization concluído." << std::endl;
     }
 
-    void TextProcessor::bpeTokenization(std::vector<std::string>& texts) {
-        std::cout << "  [Task] Executando BPETokenization..." << std::endl;
-        
+    void TextProcessor::bpeTokenization(std::vector<std::string>& texts,
+                                        const std::string& vocab_file, const std::string& merges_file) {
+        PIPELINE_LOG_VERBOSE("  [Task] Executando BPETokenization...");
+        bpeTokenizationRange(texts, 0, texts.size(), vocab_file, merges_file);
+        PIPELINE_LOG_VERBOSE("  [Task] BPETokenization concluído.");
+    }
+
+    void TextProcessor::bpeTokenizationRange(std::vector<std::string>& texts, size_t begin, size_t end,
+                                             const std::string& vocab_file, const std::string& merges_file) {
         try {
-            TokenizerWrapper tokenizer("vocab.txt", "merges.txt");
-            
-            for (std::string& text : texts) {
-                // Simula a tokenização BPE
-                auto encoding = tokenizer.tokenize_and_add_special_tokens(text);
-                
-                // Converte de volta para string para manter compatibilidade
-                std::string token_representation = "[CLS] ";
-                for (const auto& token : encoding.tokens) {
-                    if (token.text != "[CLS]" && token.text != "[SEP]" && token.text != "[EOF]") {
-                        token_representation += token.text + " ";
+            std::shared_ptr<const TokenizerWrapper> shared_tokenizer = TokenizerRegistry::get(vocab_file, merges_file);
+            const TokenizerWrapper& tokenizer = *shared_tokenizer;
+
+            // Buffers por thread reaproveitados entre documentos e chamadas
+            thread_local std::vector<hf_tokenizers::BpeToken> pieces;
+            thread_local std::string output;
+
+            for (size_t i = begin; i < end; ++i) {
+                std::string& text = texts[i];
+                output.clear();
+                output.reserve(text.size() * 2 + 16);
+                output.append("[CLS] ");
+
+                // Mesma segmentação de Tokenizer::encode; cada subtoken (exceto os especiais) seguido de espaço
+                TokenizerWrapper::for_each_word(text, [&tokenizer](std::string_view word) {
+                    pieces.clear();
+                    tokenizer.tokenize_pieces(word, pieces);
+                    for (const auto& piece : pieces) {
+                        if (!isSpecialToken(piece.text)) {
+                            output.append(piece.text);
+                            output.push_back(' ');
+                        }
                     }
-                }
-                token_representation += "[SEP]";
-                text = token_representation;
+                });
+                output.append("[SEP]");
+                text.assign(output);
             }
         } catch (const std::exception& e) {
             std::cerr << "Erro durante a tokenização: " << e.what() << std::endl;
         }
-        
-        std::cout << "  [Task] BPETokenization concluído." << std::endl;
     }
 
     void TextProcessor::partitionTokens(std::vector<std::string>& texts, size_t max_length) {
-        std::cout << "  [Task] Executando PartitionTokens..." << std::endl;
-        
-        std::vector<std::string> partitioned_texts;
+        PIPELINE_LOG_VERBOSE("  [Task] Executando PartitionTokens...");
+        partitionTokensRange(texts, 0, texts.size(), max_length);
+        PIPELINE_LOG_VERBOSE("  [Task] PartitionTokens concluído.");
+    }
 
-        for (const std::string& text_tokens_str : texts) {
-            std::istringstream iss(text_tokens_str);
-            std::string token;
-            std::vector<std::string> tokens;
-            
-            // Extrai todos os tokens da string
-            while (iss >> token) {
-                tokens.push_back(token);
+    void TextProcessor::partitionTokensRange(std::vector<std::string>& texts, size_t begin, size_t end,
+                                             size_t max_length) {
+        for (size_t idx = begin; idx < end; ++idx) {
+            std::string& text = texts[idx];
+
+            // Basta saber se há mais de max_length tokens
+            size_t count = 0;
+            scanWhitespaceTokens(text, [&count, max_length](std::string_view) {
+                return ++count <= max_length;
+            });
+            if (count <= max_length) {
+                continue;
             }
 
-            if (tokens.size() > max_length) {
-                // Trunca a sequência para o tamanho máximo
-                std::vector<std::string> truncated_tokens(tokens.begin(), tokens.begin() + max_length);
-                
-                // Reconstrói a string truncada
-                std::string truncated_str = "";
-                for (size_t i = 0; i < truncated_tokens.size(); ++i) {
-                    truncated_str += truncated_tokens[i];
-                    if (i < truncated_tokens.size() - 1) {
-                        truncated_str += " ";
-                    }
+            // Trunca no próprio buffer: os tokens mantidos são compactados com um espaço
+            // entre eles, e a escrita nunca ultrapassa a posição de leitura
+            size_t write = 0;
+            size_t kept = 0;
+            scanWhitespaceTokens(text, [&text, &write, &kept, max_length](std::string_view token) {
+                if (kept == max_length) {
+                    return false;
                 }
-                partitioned_texts.push_back(truncated_str);
-            } else {
-                partitioned_texts.push_back(text_tokens_str);
-            }
+                if (kept > 0) {
+                    text[write++] = ' ';
+                }
+                std::memmove(&text[write], token.data(), token.size());
+                write += token.size();
+                return ++kept < max_length;
+            });
+            text.resize(write);
         }
-        
-        texts = partitioned_texts;
-        std::cout << "  [Task] PartitionTokens concluído." << std::endl;
     }
 
     void TextProcessor::addSpecialTokens(std::vector<std::string>& texts) {
-        std::cout << "  [Task] Executando AddSpecialTokens..." << std::endl;
-        
-        for (std::string& text : texts) {
-            // Adiciona [EOF] no final se não estiver presente
-            if (text.find("[EOF]") == std::string::npos) {
-                text += " [EOF]";
+        PIPELINE_LOG_VERBOSE("  [Task] Executando AddSpecialTokens...");
+        addSpecialTokensRange(texts, 0, texts.size());
+        PIPELINE_LOG_VERBOSE("  [Task] AddSpecialTokens concluído.");
+    }
+
+    void TextProcessor::addSpecialTokensRange(std::vector<std::string>& texts, size_t begin, size_t end) {
+        thread_local std::string output;
+
+        for (size_t i = begin; i < end; ++i) {
+            std::string& text = texts[i];
+            // Regras: [EOF] no fim se ausente, [CLS] no início se ausente e [SEP]
+            // antes do primeiro [EOF] se ausente
+            size_t eof_pos = text.find("[EOF]");
+            bool has_eof = eof_pos != std::string::npos;
+            bool needs_cls = text.compare(0, 5, "[CLS]") != 0;
+            bool needs_sep = text.find("[SEP]") == std::string::npos;
+
+            // Caso comum (saída de BPETokenization): só acrescenta no fim do próprio texto
+            if (!needs_cls && !has_eof) {
+                text.append(needs_sep ? " [SEP] [EOF]" : " [EOF]");
+                continue;
             }
-            
-            // Garante que há [CLS] no início se não estiver presente
-            if (text.find("[CLS]") != 0) {
-                text = "[CLS] " + text;
+
+            // Demais casos: monta o resultado numa única passada no buffer da thread
+            std::string_view source(text);
+            size_t split = has_eof ? eof_pos : source.size();
+            output.clear();
+            if (needs_cls) {
+                output.append("[CLS] ");
             }
-            
-            // Garante que há [SEP] antes do [EOF] se não estiver presente
-            if (text.find("[SEP]") == std::string::npos) {
-                size_t eof_pos = text.find("[EOF]");
-                if (eof_pos != std::string::npos) {
-                    text.insert(eof_pos, "[SEP] ");
-                } else {
-                    text += " [SEP]";
-                }
+            output.append(source.substr(0, split));
+            if (!has_eof) {
+                output.push_back(' ');
+            }
+            if (needs_sep) {
+                output.append("[SEP] ");
+            }
+            if (has_eof) {
+                output.append(source.substr(split));
+            } else {
+                output.append("[EOF]");
             }
+            text.assign(output);
         }
-        
-        std::cout << "  [Task] AddSpecialTokens concluído." << std::endl;
     }
 
     void TextProcessor::tokensToIndices(std::vector<std::string>& texts) {
-        std::cout << "[Task] Executando TokensToIndices (simulado)..." << std::endl;
-        
+        PIPELINE_LOG_VERBOSE("[Task] Executando TokensToIndices (simulado)...");
+        tokensToIndicesRange(texts, 0, texts.size());
+        PIPELINE_LOG_VERBOSE("[Task] TokensToIndices concluído.");
+    }
+
+    void TextProcessor::tokensToIndicesRange(std::vector<std::string>& texts, size_t begin, size_t end) {
         // Assegura que o vocabulário esteja inicializado
         initializeVocabulary();
+        thread_local std::string output;
 
-        for (std::string& text_tokens_str : texts) {
-            std::vector<int> final_indexed_sequence;
-            std::istringstream iss(text_tokens_str);
-            std::string token_str;
+        for (size_t idx = begin; idx < end; ++idx) {
+            std::string& text = texts[idx];
+            output.clear();
+            output.reserve(text.size() + 16);
 
-            while (iss >> token_str) {
-                // Busca o token no vocabulário
-                auto it = vocabulary.find(token_str);
-                if (it != vocabulary.end()) {
-                    final_indexed_sequence.push_back(it->second);
-                } else {
-                    final_indexed_sequence.push_back(UNK_TOKEN_ID);
+            // Busca cada token no vocabulário sem copiá-lo e escreve o ID em decimal
+            scanWhitespaceTokens(text, [](std::string_view token) {
+                auto it = vocabulary.find(token);
+                int id = (it != vocabulary.end()) ? it->second : UNK_TOKEN_ID;
+                char digits[16];
+                std::to_chars_result converted = std::to_chars(digits, digits + sizeof(digits), id);
+                if (!output.empty()) {
+                    output.push_back(' ');
                 }
-            }
+                output.append(digits, converted.ptr);
+                return true;
+            });
+            text.assign(output);
+        }
+    }
 
-            // Converte a sequência de IDs para string
-            text_tokens_str = "";
-            if (!final_indexed_sequence.empty()) {
-                for (size_t i = 0; i < final_indexed_sequence.size(); ++i) {
-                    text_tokens_str += std::to_string(final_indexed_sequence[i]);
-                    if (i < final_indexed_sequence.size() - 1) {
-                        text_tokens_str += " ";
-                    }
+    void TextProcessor::wordTokenizationRange(const std::vector<std::string>& texts,
+                                              std::vector<TokenizedDocument>& documents,
+                                              size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            TokenizedDocument& document = documents[i];
+            document.clear();
+            // Os tokens nunca somam mais bytes que o texto; palavras têm em média mais de 4 bytes
+            document.reserve(texts[i].size(), texts[i].size() / 4 + 1);
+            scanWordTokens(texts[i], [&document](const char* token, size_t length) {
+                document.addToken(std::string_view(token, length));
+            });
+        }
+    }
+
+    void TextProcessor::bpeTokenizationRange(std::vector<TokenizedDocument>& documents, size_t begin, size_t end,
+                                             const std::string& vocab_file, const std::string& merges_file) {
+        try {
+            std::shared_ptr<const TokenizerWrapper> shared_tokenizer = TokenizerRegistry::get(vocab_file, merges_file);
+            const TokenizerWrapper& tokenizer = *shared_tokenizer;
+
+            // Buffers por thread; a saída é copiada para o documento, que mantém a
+            // própria memória (e o próprio recurso, ex.: a arena do lote)
+            thread_local std::vector<hf_tokenizers::BpeToken> pieces;
+            thread_local TokenizedDocument output;
+
+            for (size_t i = begin; i < end; ++i) {
+                TokenizedDocument& document = documents[i];
+                output.clear();
+                output.addToken("[CLS]");
+
+                // Os tokens não têm espaços; '.' e ',' ainda separam palavras para o tokenizador
+                for (size_t t = 0; t < document.size(); ++t) {
+                    TokenizerWrapper::for_each_word(document.token(t), [&tokenizer](std::string_view word) {
+                        pieces.clear();
+                        tokenizer.tokenize_pieces(word, pieces);
+                        for (const auto& piece : pieces) {
+                            if (!isSpecialToken(piece.text)) {
+                                output.addToken(piece.text);
+                            }
+                        }
+                    });
                 }
+
+                output.addToken("[SEP]");
+                document.assign(output);
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Erro durante a tokenização: " << e.what() << std::endl;
+        }
+    }
+
+    void TextProcessor::partitionTokensRange(std::vector<TokenizedDocument>& documents, size_t begin, size_t end,
+                                             size_t max_length) {
+        for (size_t i = begin; i < end; ++i) {
+            documents[i].truncate(max_length);
+        }
+    }
+
+    void TextProcessor::addSpecialTokensRange(std::vector<TokenizedDocument>& documents, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            TokenizedDocument& document = documents[i];
+            // Mesmas regras da versão em string: [EOF] no fim, [CLS] no início, [SEP] antes do [EOF]
+            if (document.findToken("[EOF]") == document.size()) {
+                document.addToken("[EOF]");
+            }
+            if (document.token(0) != "[CLS]") {
+                document.insertToken(0, "[CLS]");
+            }
+            if (document.findToken("[SEP]") == document.size()) {
+                document.insertToken(document.findToken("[EOF]"), "[SEP]");
+            }
+        }
+    }
+
+    void TextProcessor::tokensToIndicesRange(std::vector<TokenizedDocument>& documents, size_t begin, size_t end) {
+        // Assegura que o vocabulário esteja inicializado
+        initializeVocabulary();
+
+        for (size_t i = begin; i < end; ++i) {
+            TokenizedDocument& document = documents[i];
+            std::pmr::vector<int>& ids = document.mutableIds();
+            ids.resize(document.size());
+            for (size_t t = 0; t < document.size(); ++t) {
+                auto it = vocabulary.find(document.token(t));
+                ids[t] = (it != vocabulary.end()) ? it->second : UNK_TOKEN_ID;
             }
         }
-        
-        std::cout << "[Task] TokensToIndices concluído." << std::endl;
     }
 
     void TextProcessor::generateEmbeddings(std::vector<std::string>& texts) {
-        std::cout << "[Task] Executando GenerateEmbeddings (simulado - gerando placeholders de embeddings)..." << std::endl;
-        
+        PIPELINE_LOG_VERBOSE("[Task] Executando GenerateEmbeddings (simulado - gerando placeholders de embeddings)...");
+        generateEmbeddingsRange(texts, 0, texts.size());
+        PIPELINE_LOG_VERBOSE("[Task] GenerateEmbeddings concluído.");
+    }
+
+    void TextProcessor::generateEmbeddingsRange(std::vector<std::string>& texts, size_t begin, size_t end,
+                                                size_t index_offset) {
         // Em uma implementação real, receberia os IDs numéricos e passaria por um modelo
-        for (size_t i = 0; i < texts.size(); ++i) {
-            texts[i] = "EMBEDDED_DOCUMENT_" + std::to_string(i + 1);
+        const std::string_view prefix = "EMBEDDED_DOCUMENT_";
+        for (size_t i = begin; i < end; ++i) {
+            char digits[24];
+            std::to_chars_result converted = std::to_chars(digits, digits + sizeof(digits), index_offset + i + 1);
+            texts[i].assign(prefix.data(), prefix.size()).append(digits, converted.ptr);
         }
-        
-        std::cout << "[Task] GenerateEmbeddings concluído." << std::endl;
     }
 
     std::map<std::string, size_t> TextProcessor::getVocabularyStats() {
@@ -259,43 +464,27 @@ namespace pipeline {
     }
 
     void TextProcessor::setCustomVocabulary(const std::map<std::string, int>& custom_vocab) {
-        vocabulary = custom_vocab;
+        std::lock_guard<std::mutex> lock(vocabulary_mutex);
+        vocabulary = std::map<std::string, int, std::less<>>(custom_vocab.begin(), custom_vocab.end());
         vocabulary_initialized = true;
     }
 
     void TextProcessor::resetVocabulary() {
+        std::lock_guard<std::mutex> lock(vocabulary_mutex);
         vocabulary.clear();
         vocabulary_initialized = false;
     }
 
     void TextProcessor::cleanTextSequential(std::vector<std::string>& texts) {
-        std::cout << "  [Task] Executando CleanText (Sequencial Puro)..." << std::endl;
+        PIPELINE_LOG_VERBOSE("  [Task] Executando CleanText (Sequencial Puro)...");
         
         // Processa um texto por vez, sem possibilidade de paralelização
         for (size_t i = 0; i < texts.size(); ++i) {
             std::string& text = texts[i];
             
-            // Remove tags HTML
-            text = std::regex_replace(text, std::regex("<.*?>"), " ");
-            
-            // Decodifica entidades HTML comuns
-            text = std::regex_replace(text, std::regex("&amp;"), "&");
-            text = std::regex_replace(text, std::regex("&lt;"), "<");
-            text = std::regex_replace(text, std::regex("&gt;"), ">");
-            text = std::regex_replace(text, std::regex("&quot;"), "\"");
-            text = std::regex_replace(text, std::regex("&apos;"), "'");
-            text = std::regex_replace(text, std::regex("&nbsp;"), " ");
-            
-            // Mantém apenas caracteres alfanuméricos, acentuados e espaços
-            text = std::regex_replace(text, 
-                std::regex("[^a-zA-Z0-9\\sÀ-ÿ]", std::regex::ECMAScript | std::regex::collate), 
-                " ");
-            
-            // Substitui múltiplos espaços por um único espaço
-            text = std::regex_replace(text, std::regex("\\s+"), " ");
-            
-            // Remove espaços no início e fim
-            text = std::regex_replace(text, std::regex("^\\s+|\\s+$"), "");
+            // Remove tags, decodifica entidades, filtra caracteres, colapsa e apara
+            // espaços numa única passada (mesma saída da antiga cadeia de regex)
+            TextCleaner::cleanInPlace(text);
             
             // Adiciona uma pequena pausa para garantir que não há otimização agressiva
             if (i % 10000 == 0 && i > 0) {
@@ -303,20 +492,18 @@ namespace pipeline {
             }
         }
         
-        std::cout << "  [Task] CleanText (Sequencial Puro) concluído." << std::endl;
+        PIPELINE_LOG_VERBOSE("  [Task] CleanText (Sequencial Puro) concluído.");
     }
 
     void TextProcessor::normalizeTextSequential(std::vector<std::string>& texts) {
-        std::cout << "  [Task] Executando NormalizeText (Sequencial Puro)..." << std::endl;
+        PIPELINE_LOG_VERBOSE("  [Task] Executando NormalizeText (Sequencial Puro)...");
         
         // Processa um texto por vez
         for (size_t i = 0; i < texts.size(); ++i) {
             std::string& text = texts[i];
             
-            // Converte para minúsculas caractere por caractere
-            for (char& c : text) {
-                c = std::tolower(static_cast<unsigned char>(c));
-            }
+            // Converte para minúsculas (ASCII e Latin-1 em UTF-8)
+            utils::SimdText::toLowerInPlace(text);
             
             // Pequena pausa ocasional
             if (i % 10000 == 0 && i > 0) {
@@ -324,38 +511,15 @@ namespace pipeline {
             }
         }
         
-        std::cout << "  [Task] NormalizeText (Sequencial Puro) concluído." << std::endl;
+        PIPELINE_LOG_VERBOSE("  [Task] NormalizeText (Sequencial Puro) concluído.");
     }
 
     void TextProcessor::wordTokenizationSequential(std::vector<std::string>& texts) {
-        std::cout << "  [Task] Executando WordTokenization (Sequencial Puro)..." << std::endl;
+        PIPELINE_LOG_VERBOSE("  [Task] Executando WordTokenization (Sequencial Puro)...");
         
-        // Expressão regular para encontrar palavras e pontuação
-        std::regex word_punct_regex("[a-zA-Z0-9À-ÿ]+|[.,!?;:\"'()\\[\\]{}]", 
-                                   std::regex::ECMAScript | std::regex::collate);
-
         // Processa um texto por vez
         for (size_t i = 0; i < texts.size(); ++i) {
-            std::string& text = texts[i];
-            std::vector<std::string> tokens;
-            auto words_begin = std::sregex_iterator(text.begin(), text.end(), word_punct_regex);
-            auto words_end = std::sregex_iterator();
-
-            for (std::sregex_iterator iter = words_begin; iter != words_end; ++iter) {
-                std::smatch match = *iter;
-                std::string token = match.str();
-                
-                // Filtra tokens vazios ou de apenas espaço
-                if (!token.empty() && !std::all_of(token.begin(), token.end(), ::isspace)) {
-                    tokens.push_back(token);
-                }
-            }
-            
-            // Reconstrói o texto como uma string de tokens separados por espaço
-            text = std::accumulate(tokens.begin(), tokens.end(), std::string(),
-                                  [](const std::string& a, const std::string& b) {
-                                      return a.empty() ? b : a + " " + b;
-                                  });
+            tokenizeWords(texts[i]);
             
             // Pequena pausa ocasional
             if (i % 10000 == 0 && i > 0) {
@@ -363,7 +527,7 @@ namespace pipeline {
             }
         }
         
-        std::cout << "  [Task] WordTokenization (Sequencial Puro) concluído." << std::endl;
+        PIPELINE_LOG_VERBOSE("  [Task] WordTokenization (Sequencial Puro) concluído.");
     }
 } // namespace pipeline
 } // namespace legal_doc_pipeline
@@ -0,0 +1,127 @@
+#include "../../include/pipeline/tokenized_document.h"
+#include <algorithm>
+#include <cctype>
+
+namespace legal_doc_pipeline {
+namespace pipeline {
+
+    void TokenizedDocument::clear() {
+        pool.clear();
+        spans.clear();
+        ids.clear();
+    }
+
+    void TokenizedDocument::releaseMemory() {
+        std::pmr::string(pool.get_allocator()).swap(pool);
+        std::pmr::vector<TokenSpan>(spans.get_allocator()).swap(spans);
+        std::pmr::vector<int>(ids.get_allocator()).swap(ids);
+    }
+
+    void TokenizedDocument::reserve(size_t pool_bytes, size_t tokens) {
+        pool.reserve(pool_bytes);
+        spans.reserve(tokens);
+    }
+
+    void TokenizedDocument::addToken(std::string_view token) {
+        spans.push_back({static_cast<uint32_t>(pool.size()), static_cast<uint32_t>(token.size())});
+        pool.append(token.data(), token.size());
+    }
+
+    void TokenizedDocument::insertToken(size_t index, std::string_view token) {
+        // O texto vai para o fim do pool; só o vetor de intervalos é deslocado
+        TokenSpan span{static_cast<uint32_t>(pool.size()), static_cast<uint32_t>(token.size())};
+        pool.append(token.data(), token.size());
+        spans.insert(spans.begin() + static_cast<std::ptrdiff_t>(std::min(index, spans.size())), span);
+    }
+
+    void TokenizedDocument::truncate(size_t max_tokens) {
+        if (spans.size() > max_tokens) {
+            spans.resize(max_tokens);
+        }
+        if (ids.size() > max_tokens) {
+            ids.resize(max_tokens);
+        }
+    }
+
+    size_t TokenizedDocument::findToken(std::string_view text) const {
+        for (size_t i = 0; i < spans.size(); ++i) {
+            if (token(i) == text) {
+                return i;
+            }
+        }
+        return spans.size();
+    }
+
+    void TokenizedDocument::assign(const TokenizedDocument& other) {
+        if (this == &other) {
+            return;
+        }
+        pool.assign(other.pool.data(), other.pool.size());
+        spans.assign(other.spans.begin(), other.spans.end());
+        ids.assign(other.ids.begin(), other.ids.end());
+    }
+
+    void TokenizedDocument::swap(TokenizedDocument& other) {
+        if (memoryResource() == other.memoryResource()) {
+            pool.swap(other.pool);
+            spans.swap(other.spans);
+            ids.swap(other.ids);
+            return;
+        }
+        // Containers pmr com recursos diferentes não podem trocar buffers
+        TokenizedDocument previous(memoryResource());
+        previous.pool = pool;
+        previous.spans = spans;
+        previous.ids = ids;
+        pool = other.pool;
+        spans = other.spans;
+        ids = other.ids;
+        other.pool = previous.pool;
+        other.spans = previous.spans;
+        other.ids = previous.ids;
+    }
+
+    TokenizedDocument TokenizedDocument::fromString(std::string_view text) {
+        TokenizedDocument document;
+        size_t i = 0;
+        while (i < text.size()) {
+            while (i < text.size() && std::isspace(static_cast<unsigned char>(text[i]))) {
+                ++i;
+            }
+            size_t start = i;
+            while (i < text.size() && !std::isspace(static_cast<unsigned char>(text[i]))) {
+                ++i;
+            }
+            if (i > start) {
+                document.addToken(text.substr(start, i - start));
+            }
+        }
+        return document;
+    }
+
+    std::string TokenizedDocument::toString() const {
+        std::string result;
+        result.reserve(pool.size() + spans.size());
+        for (size_t i = 0; i < spans.size(); ++i) {
+            if (i > 0) {
+                result.push_back(' ');
+            }
+            result.append(token(i));
+        }
+        return result;
+    }
+
+    std::string TokenizedDocument::idsToString() const {
+        std::string result;
+        result.reserve(ids.size() * 4);
+        for (size_t i = 0; i < ids.size(); ++i) {
+            if (i > 0) {
+                result.push_back(' ');
+            }
+            result += std::to_string(ids[i]);
+        }
+        return result;
+    }
+
+} // namespace pipeline
+} // namespace legal_doc_pipeline
@@ -0,0 +1,71 @@
+#include "../../include/scheduler/work_stealing_queue.h"
+#include <algorithm>
+
+namespace legal_doc_pipeline {
+namespace scheduler {
+
+    WorkStealingQueue::WorkStealingQueue(size_t priority_window)
+        : priority_window(std::max<size_t>(1, priority_window)) {}
+
+    void WorkStealingQueue::push(const WorkItem& item) {
+        std::lock_guard<std::mutex> lock(deque_mutex);
+        items.push_back(item);
+    }
+
+    bool WorkStealingQueue::pop(WorkItem& item) {
+        std::lock_guard<std::mutex> lock(deque_mutex);
+        if (items.empty()) {
+            return false;
+        }
+
+        // Escolhe a menor 'priority' entre os itens mais recentes (fundo da deque)
+        size_t window = std::min(priority_window, items.size());
+        auto best = items.end() - 1;
+        for (auto it = items.end() - window; it != items.end(); ++it) {
+            if (it->task->priority < best->task->priority) {
+                best = it;
+            }
+        }
+
+        item = *best;
+        items.erase(best);
+        return true;
+    }
+
+    bool WorkStealingQueue::steal(WorkItem& item) {
+        std::lock_guard<std::mutex> lock(deque_mutex);
+        if (items.empty()) {
+            return false;
+        }
+
+        // Escolhe a menor 'priority' entre os itens mais antigos (topo da deque)
+        size_t window = std::min(priority_window, items.size());
+        auto best = items.begin();
+        for (auto it = items.begin(); it != items.begin() + window; ++it) {
+            if (it->task->priority < best->task->priority) {
+                best = it;
+            }
+        }
+
+        item = *best;
+        items.erase(best);
+        return true;
+    }
+
+    size_t WorkStealingQueue::size() const {
+        std::lock_guard<std::mutex> lock(deque_mutex);
+        return items.size();
+    }
+
+    bool WorkStealingQueue::empty() const {
+        std::lock_guard<std::mutex> lock(deque_mutex);
+        return items.empty();
+    }
+
+    void WorkStealingQueue::clear() {
+        std::lock_guard<std::mutex> lock(deque_mutex);
+        items.clear();
+    }
+
+} // namespace scheduler
+} // namespace legal_doc_pipeline
@@ -1,62 +1,257 @@
 #include "../../include/scheduler/workflow_scheduler.h"
+#include "../../include/utils/logger.h"
+#include "../../include/utils/thread_pool.h"
+#include "../../include/utils/trace_recorder.h"
 #include <iostream>
 #include <algorithm>
-#include <set>
 
 namespace legal_doc_pipeline {
 namespace scheduler {
 
-    WorkflowScheduler::WorkflowScheduler() 
-        : completed_task_count(0), shutdown_requested(false), has_dependency_errors(false) {}
+    namespace {
+        /**
+         * @brief Descrição de um item para log (inclui o intervalo em tarefas data-parallel)
+         */
+        std::string describeWorkItem(const WorkItem& item) {
+            if (!item.task->isDataParallel()) {
+                return item.task->id;
+            }
+            return item.task->id + " [" + std::to_string(item.begin) + ", " + std::to_string(item.end) + ")";
+        }
+
+        /**
+         * @brief Monta a lista de sucessores em CSR (ordenação por contagem das arestas)
+         * @param task_count Número de tarefas
+         * @param edges Arestas (dependência, dependente)
+         * @param offsets Recebe task_count + 1 deslocamentos
+         * @param targets Recebe os sucessores concatenados, na ordem de inserção das arestas
+         * @param in_degrees Recebe o número de predecessores de cada tarefa
+         */
+        void buildAdjacency(size_t task_count, const std::vector<std::pair<TaskId, TaskId>>& edges,
+                            std::vector<uint32_t>& offsets, std::vector<TaskId>& targets,
+                            std::vector<int>& in_degrees) {
+            offsets.assign(task_count + 1, 0);
+            in_degrees.assign(task_count, 0);
+            for (const auto& edge : edges) {
+                offsets[edge.first + 1]++;
+                in_degrees[edge.second]++;
+            }
+            for (size_t i = 0; i < task_count; ++i) {
+                offsets[i + 1] += offsets[i];
+            }
+
+            targets.resize(edges.size());
+            std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+            for (const auto& edge : edges) {
+                targets[cursor[edge.first]++] = edge.second;
+            }
+        }
+
+        /**
+         * @brief Ordenação topológica pelo algoritmo de Kahn (iterativo, sem recursão)
+         * @param offsets Deslocamentos CSR dos sucessores
+         * @param targets Sucessores concatenados
+         * @param in_degrees Graus de entrada (consumidos)
+         * @param order Recebe as tarefas em ordem topológica
+         * @return true se todas as tarefas foram ordenadas (grafo acíclico)
+         */
+        bool topologicalSort(const std::vector<uint32_t>& offsets, const std::vector<TaskId>& targets,
+                             std::vector<int> in_degrees, std::vector<TaskId>& order) {
+            const size_t task_count = in_degrees.size();
+            order.clear();
+            order.reserve(task_count);
+            for (size_t i = 0; i < task_count; ++i) {
+                if (in_degrees[i] == 0) {
+                    order.push_back(static_cast<TaskId>(i));
+                }
+            }
+
+            // order funciona como fila: [0, head) já processado, [head, size) pronto
+            for (size_t head = 0; head < order.size(); ++head) {
+                TaskId current = order[head];
+                for (uint32_t e = offsets[current]; e < offsets[current + 1]; ++e) {
+                    TaskId dependent = targets[e];
+                    if (--in_degrees[dependent] == 0) {
+                        order.push_back(dependent);
+                    }
+                }
+            }
+            return order.size() == task_count;
+        }
+    } // namespace
+
+    WorkflowScheduler::WorkflowScheduler(SchedulingMode mode) 
+        : graph_compiled(false), completed_task_count(0), shutdown_requested(false), has_dependency_errors(false),
+          mode(mode), pending_ready_items(0), sleeping_workers(0), stolen_task_count(0),
+          active_worker_count(1), thread_pool(nullptr), pool_run_active(false),
+          run_start(std::chrono::steady_clock::now()), trace_recorder(nullptr), trace_offset_ns(0) {}
 
     WorkflowScheduler::~WorkflowScheduler() {
         shutdown();
     }
 
-    void WorkflowScheduler::addTask(const Task& task) {
+    TaskId WorkflowScheduler::addTask(const Task& task) {
         std::unique_lock<std::mutex> lock(queue_mutex);
-        tasks.emplace(task.id, task);
+        auto inserted = task_ids.emplace(task.id, static_cast<TaskId>(tasks.size()));
+        if (inserted.second) {
+            tasks.push_back(task);
+            graph_compiled = false;
+        }
+        return inserted.first->second;
     }
 
     bool WorkflowScheduler::addDependency(const std::string& task_id, const std::string& dependency_id) {
         std::unique_lock<std::mutex> lock(queue_mutex);
         
         // Garante que as tarefas existem
-        if (tasks.find(task_id) == tasks.end() || tasks.find(dependency_id) == tasks.end()) {
+        auto task_it = task_ids.find(task_id);
+        auto dependency_it = task_ids.find(dependency_id);
+        if (task_it == task_ids.end() || dependency_it == task_ids.end()) {
             std::cerr << "Erro: Tarefa '" << task_id << "' ou '" << dependency_id 
                       << "' não encontrada ao adicionar dependência." << std::endl;
             has_dependency_errors = true;
             return false;
         }
         
-        tasks.at(task_id).dependencies.push_back(dependency_id);
-        tasks.at(dependency_id).dependents.push_back(task_id);
-        tasks.at(task_id).remaining_dependencies++;
+        edges.emplace_back(dependency_it->second, task_it->second);
+        graph_compiled = false;
         return true;
     }
 
-    bool WorkflowScheduler::run(const std::vector<std::string>& input_data, int num_workers) {
-        // Verifica se há erros de dependência
+    bool WorkflowScheduler::addDependency(TaskId task_id, TaskId dependency_id) {
+        std::unique_lock<std::mutex> lock(queue_mutex);
+
+        if (task_id >= tasks.size() || dependency_id >= tasks.size()) {
+            std::cerr << "Erro: Tarefa " << task_id << " ou " << dependency_id
+                      << " não encontrada ao adicionar dependência." << std::endl;
+            has_dependency_errors = true;
+            return false;
+        }
+
+        edges.emplace_back(dependency_id, task_id);
+        graph_compiled = false;
+        return true;
+    }
+
+    TaskId WorkflowScheduler::getTaskId(const std::string& name) const {
+        auto it = task_ids.find(name);
+        return it == task_ids.end() ? INVALID_TASK_ID : it->second;
+    }
+
+    size_t WorkflowScheduler::getTaskCount() const {
+        return tasks.size();
+    }
+
+    size_t WorkflowScheduler::getCompletedTaskCount() const {
+        return completed_task_count.load();
+    }
+
+    bool WorkflowScheduler::compile() {
+        if (graph_compiled) {
+            return true;
+        }
         if (has_dependency_errors) {
             std::cerr << "Erro: Há dependências inválidas no grafo!" << std::endl;
             return false;
         }
-        
-        // Valida o grafo antes de executar
-        if (!validateDependencyGraph()) {
+
+        buildAdjacency(tasks.size(), edges, dependent_offsets, dependent_targets, dependency_counts);
+        if (!topologicalSort(dependent_offsets, dependent_targets, dependency_counts, topological_order)) {
             std::cerr << "Erro: Grafo de dependências contém ciclos!" << std::endl;
+            topological_order.clear();
             return false;
         }
 
+        root_tasks.clear();
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            if (dependency_counts[i] == 0) {
+                root_tasks.push_back(static_cast<TaskId>(i));
+            }
+        }
+        graph_compiled = true;
+        return true;
+    }
+
+    bool WorkflowScheduler::isCompiled() const {
+        return graph_compiled;
+    }
+
+    const std::vector<TaskId>& WorkflowScheduler::getTopologicalOrder() const {
+        return topological_order;
+    }
+
+    void WorkflowScheduler::resetRunState() {
+        // Os contadores partem do grau de entrada a cada execução
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            tasks[i].remaining_dependencies = dependency_counts[i];
+            tasks[i].remaining_subtasks = 0;
+            tasks[i].is_completed = false;
+        }
+    }
+
+    bool WorkflowScheduler::run(const std::vector<std::string>& input_data, int num_workers) {
+        // Compila e valida o grafo só se ele mudou desde a última execução
+        if (!compile()) {
+            return false;
+        }
+        resetRunState();
+
+        // Reserva o heap de prontos para que as conclusões não precisem realocá-lo
+        std::vector<WorkItem> queue_storage;
+        queue_storage.reserve(tasks.size());
+        ready_queue = std::priority_queue<WorkItem, std::vector<WorkItem>, WorkItemCompare>(
+            WorkItemCompare(), std::move(queue_storage));
+
         processed_texts = input_data;
         completed_task_count = 0;
         shutdown_requested = false;
+        pending_ready_items = 0;
+        sleeping_workers = 0;
+        stolen_task_count = 0;
+        active_worker_count = static_cast<size_t>(std::max(num_workers, 1));
+
+        // Um vetor de registros por worker; a capacidade das execuções anteriores é mantida
+        worker_records.resize(active_worker_count);
+        for (auto& records : worker_records) {
+            records.clear();
+        }
+        run_start = std::chrono::steady_clock::now();
+        trace_offset_ns = trace_recorder ? trace_recorder->toTraceTime(run_start) : 0;
+
+        // No modo WORK_STEALING cada worker recebe sua própria deque (num_workers < 1 conta como 1)
+        worker_queues.clear();
+        if (mode == SchedulingMode::WORK_STEALING) {
+            for (size_t i = 0; i < active_worker_count; ++i) {
+                worker_queues.push_back(std::make_unique<WorkStealingQueue>());
+            }
+        }
+
+        // Com um pool persistente, os workers são jobs do pool: nenhuma thread é criada por execução
+        if (thread_pool != nullptr) {
+            initializeReadyQueue();
+            pool_run_active = true;
+            thread_pool->runBatch(active_worker_count, [this](size_t worker_index) {
+                if (mode == SchedulingMode::WORK_STEALING) {
+                    workStealingWorkerThread(worker_index);
+                } else {
+                    workerThread(worker_index);
+                }
+            });
+            pool_run_active = false;
+            worker_queues.clear();
+            PIPELINE_LOG_VERBOSE("Todos os workers terminaram a execução.");
+            return allTasksCompleted();
+        }
 
         // Inicia os workers
         workers.clear();
-        workers.reserve(num_workers);
-        for (int i = 0; i < num_workers; ++i) {
-            workers.emplace_back(&WorkflowScheduler::workerThread, this);
+        workers.reserve(active_worker_count);
+        for (size_t i = 0; i < active_worker_count; ++i) {
+            if (mode == SchedulingMode::WORK_STEALING) {
+                workers.emplace_back(&WorkflowScheduler::workStealingWorkerThread, this, i);
+            } else {
+                workers.emplace_back(&WorkflowScheduler::workerThread, this, i);
+            }
         }
 
         // Inicializa a fila de tarefas prontas
@@ -70,10 +265,27 @@ namespace scheduler {
         }
 
         workers.clear();
-        std::cout << "Todos os workers terminaram a execução." << std::endl;
+        worker_queues.clear();
+        PIPELINE_LOG_VERBOSE("Todos os workers terminaram a execução.");
         return allTasksCompleted();
     }
 
+    void WorkflowScheduler::setThreadPool(utils::ThreadPool* pool) {
+        thread_pool = pool;
+    }
+
+    void WorkflowScheduler::setTraceRecorder(utils::TraceRecorder* recorder) {
+        trace_recorder = recorder;
+    }
+
+    void WorkflowScheduler::setSchedulingMode(SchedulingMode new_mode) {
+        mode = new_mode;
+    }
+
+    SchedulingMode WorkflowScheduler::getSchedulingMode() const {
+        return mode;
+    }
+
     void WorkflowScheduler::shutdown() {
         shutdown_requested = true;
         cv_tasks_ready.notify_all();
@@ -86,42 +298,99 @@ namespace scheduler {
         workers.clear();
     }
 
-    void WorkflowScheduler::workerThread() {
-        while (!shutdown_requested) {
-            Task* current_task_ptr = nullptr;
-            bool task_found = false;
+    size_t WorkflowScheduler::splitIntoWorkItems(Task& task, std::vector<WorkItem>& items) {
+        const size_t first = items.size();
+        size_t total = processed_texts.size();
+        const int64_t ready_ns = elapsedNanoseconds();
+
+        if (!task.isDataParallel() || total == 0) {
+            items.push_back({&task, 0, total, ready_ns});
+        } else {
+            // Granularidade automática: ~4 intervalos por worker para balancear a carga
+            size_t grain = task.grain_size;
+            if (grain == 0) {
+                grain = std::max<size_t>(1, (total + active_worker_count * 4 - 1) / (active_worker_count * 4));
+            }
+            for (size_t begin = 0; begin < total; begin += grain) {
+                items.push_back({&task, begin, std::min(begin + grain, total), ready_ns});
+            }
+        }
 
-            {
+        const size_t count = items.size() - first;
+        task.remaining_subtasks = count;
+        return count;
+    }
+
+    void WorkflowScheduler::executeWorkItem(const WorkItem& item, size_t worker_index) {
+        const int64_t start_ns = elapsedNanoseconds();
+        if (item.task->isDataParallel()) {
+            item.task->range_operation(processed_texts, item.begin, item.end);
+        } else {
+            item.task->operation(processed_texts);
+        }
+
+        // Cada worker só escreve no próprio vetor: o registro não precisa de lock
+        const int64_t end_ns = elapsedNanoseconds();
+        worker_records[worker_index].push_back({idOf(*item.task), item.task->type, item.begin, item.end,
+                                                worker_index, item.ready_ns, start_ns, end_ns});
+        if (trace_recorder) {
+            trace_recorder->record("scheduler", item.task->id, trace_offset_ns + start_ns, trace_offset_ns + end_ns,
+                                   item.begin, item.end);
+        }
+    }
+
+    bool WorkflowScheduler::finishWorkItem(const WorkItem& item) {
+        // A tarefa só termina quando o último intervalo é concluído (join)
+        return item.task->remaining_subtasks.fetch_sub(1) == 1;
+    }
+
+    void WorkflowScheduler::workerThread(size_t worker_index) {
+        WorkItem current_item;
+        bool task_found = false;   // true quando o item foi repassado por markTaskCompleted
+
+        while (!shutdown_requested) {
+            if (!task_found) {
                 std::unique_lock<std::mutex> lock(queue_mutex);
+                sleeping_workers++;
                 cv_tasks_ready.wait(lock, [this]{
                     return !ready_queue.empty() || 
                            allTasksCompleted() || 
                            shutdown_requested;
                 });
+                sleeping_workers--;
 
                 if (shutdown_requested || (allTasksCompleted() && ready_queue.empty())) {
-                    std::cout << "Worker encerrando: todas as tarefas concluídas. (ID thread: " 
-                              << std::this_thread::get_id() << ")" << std::endl;
+                    PIPELINE_LOG_VERBOSE("Worker encerrando: todas as tarefas concluídas. (ID thread: " 
+                                         << std::this_thread::get_id() << ")");
                     break;
                 }
 
                 if (!ready_queue.empty()) {
-                    current_task_ptr = ready_queue.top();
+                    current_item = ready_queue.top();
                     ready_queue.pop();
                     task_found = true;
-                    std::cout << "Worker (ID: " << std::this_thread::get_id()
-                              << ") pegou a tarefa: " << current_task_ptr->id << std::endl;
+                    PIPELINE_LOG_TRACE("Worker (ID: " << std::this_thread::get_id()
+                                       << ") pegou a tarefa: " << describeWorkItem(current_item));
                 }
             }
 
-            if (task_found && current_task_ptr) {
+            if (task_found && current_item.task) {
+                task_found = false;
                 try {
-                    current_task_ptr->operation(processed_texts);
-                    markTaskCompleted(current_task_ptr->id);
+                    executeWorkItem(current_item, worker_index);
+                    if (finishWorkItem(current_item)) {
+                        // Se algum sucessor ficou pronto, o primeiro item da fila vem direto para este worker
+                        task_found = markTaskCompleted(*current_item.task, current_item);
+                        if (task_found) {
+                            PIPELINE_LOG_TRACE("Worker (ID: " << std::this_thread::get_id()
+                                               << ") recebeu a tarefa: " << describeWorkItem(current_item));
+                        }
+                    }
                 } catch (const std::exception& e) {
-                    std::cerr << "Erro ao executar tarefa " << current_task_ptr->id 
+                    std::cerr << "Erro ao executar tarefa " << describeWorkItem(current_item) 
                               << ": " << e.what() << std::endl;
                     shutdown_requested = true;
+                    std::lock_guard<std::mutex> lock(queue_mutex);
                     cv_tasks_ready.notify_all();
                     break;
                 }
@@ -129,39 +398,204 @@ namespace scheduler {
         }
     }
 
-    void WorkflowScheduler::markTaskCompleted(const std::string& task_id) {
-        std::unique_lock<std::mutex> lock(queue_mutex);
-        
-        Task& completed_task = tasks.at(task_id);
+    void WorkflowScheduler::workStealingWorkerThread(size_t worker_index) {
+        while (!shutdown_requested) {
+            WorkItem current_item;
+
+            if (acquireWorkItem(worker_index, current_item)) {
+                PIPELINE_LOG_TRACE("Worker " << worker_index << " (ID: " << std::this_thread::get_id()
+                                   << ") pegou a tarefa: " << describeWorkItem(current_item));
+                try {
+                    executeWorkItem(current_item, worker_index);
+                    if (finishWorkItem(current_item)) {
+                        markTaskCompletedLocal(*current_item.task, worker_index);
+                    }
+                } catch (const std::exception& e) {
+                    std::cerr << "Erro ao executar tarefa " << describeWorkItem(current_item) 
+                              << ": " << e.what() << std::endl;
+                    shutdown_requested = true;
+                    std::lock_guard<std::mutex> lock(queue_mutex);
+                    cv_tasks_ready.notify_all();
+                    break;
+                }
+                continue;
+            }
+
+            // Nenhuma tarefa local nem para roubar: dorme até haver trabalho ou fim da execução.
+            // O incremento de sleeping_workers antes do teste do predicado pareia com
+            // pushReadyTask (incrementa pending_ready_items e depois lê sleeping_workers).
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            sleeping_workers++;
+            cv_tasks_ready.wait(lock, [this]{
+                return pending_ready_items.load() > 0 ||
+                       allTasksCompleted() ||
+                       shutdown_requested;
+            });
+            sleeping_workers--;
+
+            if (shutdown_requested || allTasksCompleted()) {
+                PIPELINE_LOG_VERBOSE("Worker encerrando: todas as tarefas concluídas. (ID thread: " 
+                                     << std::this_thread::get_id() << ")");
+                break;
+            }
+        }
+    }
+
+    bool WorkflowScheduler::acquireWorkItem(size_t worker_index, WorkItem& item) {
+        if (worker_queues[worker_index]->pop(item)) {
+            pending_ready_items--;
+            return true;
+        }
+
+        // Percorre as demais deques a partir do vizinho para espalhar os roubos
+        size_t num_queues = worker_queues.size();
+        for (size_t offset = 1; offset < num_queues; ++offset) {
+            size_t victim = (worker_index + offset) % num_queues;
+            if (worker_queues[victim]->steal(item)) {
+                pending_ready_items--;
+                stolen_task_count++;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void WorkflowScheduler::pushReadyTask(Task* task, size_t worker_index) {
+        // Vetor de rascunho por thread: a conclusão de tarefas não aloca em regime
+        thread_local std::vector<WorkItem> items;
+        items.clear();
+        splitIntoWorkItems(*task, items);
+        for (const WorkItem& item : items) {
+            worker_queues[worker_index]->push(item);
+        }
+        pending_ready_items += items.size();
+
+        // Só toca no mutex global quando há alguém dormindo
+        if (sleeping_workers.load() > 0) {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            if (items.size() > 1) {
+                cv_tasks_ready.notify_all();
+            } else {
+                cv_tasks_ready.notify_one();
+            }
+        }
+    }
+
+    void WorkflowScheduler::markTaskCompletedLocal(Task& completed_task, size_t worker_index) {
         completed_task.is_completed = true;
-        completed_task_count++;
-        
-        std::cout << "Tarefa '" << task_id << "' finalizada! Total concluídas: " 
-                  << completed_task_count.load() << std::endl;
+        size_t completed_now = ++completed_task_count;
 
-        // Atualiza dependências das tarefas sucessoras
-        for (const std::string& dependent_id : completed_task.dependents) {
-            Task& dependent_task = tasks.at(dependent_id);
-            dependent_task.remaining_dependencies--;
-            
-            if (dependent_task.remaining_dependencies == 0 && !dependent_task.is_completed) {
-                ready_queue.push(&dependent_task);
-                std::cout << "Tarefa '" << dependent_id << "' está pronta e adicionada à fila." << std::endl;
+        PIPELINE_LOG_VERBOSE("Tarefa '" << completed_task.id << "' finalizada! Total concluídas: " 
+                             << completed_now);
+
+        // O grafo não é alterado durante a execução, então a leitura é segura sem lock
+        const TaskId id = idOf(completed_task);
+        for (uint32_t e = dependent_offsets[id]; e < dependent_offsets[id + 1]; ++e) {
+            Task& dependent_task = tasks[dependent_targets[e]];
+            if (dependent_task.remaining_dependencies.fetch_sub(1) == 1) {
+                pushReadyTask(&dependent_task, worker_index);
+                PIPELINE_LOG_VERBOSE("Tarefa '" << dependent_task.id << "' está pronta e adicionada à deque do worker "
+                                     << worker_index << ".");
             }
         }
-        
-        cv_tasks_ready.notify_all();
+
+        if (completed_now == tasks.size()) {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            cv_tasks_ready.notify_all();
+        }
+    }
+
+    bool WorkflowScheduler::markTaskCompleted(Task& completed_task, WorkItem& next_item) {
+        completed_task.is_completed = true;
+        size_t completed_now = ++completed_task_count;
+
+        PIPELINE_LOG_VERBOSE("Tarefa '" << completed_task.id << "' finalizada! Total concluídas: " 
+                             << completed_now);
+
+        if (completed_now == tasks.size()) {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            cv_tasks_ready.notify_all();
+            return false;
+        }
+
+        // O fetch_sub elege exatamente um predecessor para liberar cada sucessor; o grafo
+        // não é alterado durante a execução, então a leitura dispensa o lock. O vetor de
+        // rascunho por thread evita alocações em regime
+        thread_local std::vector<WorkItem> ready_items;
+        ready_items.clear();
+        const TaskId id = idOf(completed_task);
+        for (uint32_t e = dependent_offsets[id]; e < dependent_offsets[id + 1]; ++e) {
+            Task& dependent_task = tasks[dependent_targets[e]];
+            if (dependent_task.remaining_dependencies.fetch_sub(1) == 1) {
+                splitIntoWorkItems(dependent_task, ready_items);
+                PIPELINE_LOG_VERBOSE("Tarefa '" << dependent_task.id << "' está pronta e adicionada à fila.");
+            }
+        }
+        if (ready_items.empty()) {
+            return false;
+        }
+
+        // Seção crítica curta: só as operações no heap. O item de maior prioridade fica
+        // com este worker, que não precisa esperar nem ser acordado
+        size_t to_wake = 0;
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            for (const WorkItem& item : ready_items) {
+                ready_queue.push(item);
+            }
+            next_item = ready_queue.top();
+            ready_queue.pop();
+            to_wake = std::min(ready_items.size() - 1, sleeping_workers.load());
+        }
+
+        // Um único worker acordado por item novo (sem manada com notify_all)
+        for (size_t i = 0; i < to_wake; ++i) {
+            cv_tasks_ready.notify_one();
+        }
+        return true;
     }
 
     void WorkflowScheduler::initializeReadyQueue() {
+        if (mode == SchedulingMode::WORK_STEALING) {
+            if (worker_queues.empty()) {
+                return;
+            }
+
+            // Distribui as tarefas iniciais entre as deques em round-robin. A lista de
+            // raízes vem da compilação: os contadores já podem estar mudando nos workers
+            size_t next_queue = 0;
+            std::vector<WorkItem> items;
+            for (TaskId root : root_tasks) {
+                Task& task = tasks[root];
+                // Intervalos de uma tarefa inicial data-parallel são espalhados entre as deques
+                items.clear();
+                splitIntoWorkItems(task, items);
+                for (const WorkItem& item : items) {
+                    worker_queues[next_queue]->push(item);
+                    pending_ready_items++;
+                    next_queue = (next_queue + 1) % worker_queues.size();
+                }
+                PIPELINE_LOG_VERBOSE("Tarefa inicial '" << task.id 
+                                     << "' distribuída entre as deques dos workers.");
+            }
+
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            cv_tasks_ready.notify_all();
+            return;
+        }
+
         std::unique_lock<std::mutex> lock(queue_mutex);
         
-        for (auto& pair : tasks) {
-            if (pair.second.remaining_dependencies == 0) {
-                ready_queue.push(&pair.second);
-                std::cout << "Tarefa inicial '" << pair.second.id 
-                          << "' adicionada à fila de prontos." << std::endl;
+        std::vector<WorkItem> items;
+        for (TaskId root : root_tasks) {
+            Task& task = tasks[root];
+            items.clear();
+            splitIntoWorkItems(task, items);
+            for (const WorkItem& item : items) {
+                ready_queue.push(item);
             }
+            PIPELINE_LOG_VERBOSE("Tarefa inicial '" << task.id 
+                                 << "' adicionada à fila de prontos.");
         }
         
         cv_tasks_ready.notify_all();
@@ -181,12 +615,48 @@ namespace scheduler {
         stats["completed_tasks"] = completed_task_count.load();
         stats["pending_tasks"] = tasks.size() - completed_task_count.load();
         stats["workers_count"] = workers.size();
-        
+        stats["stolen_tasks"] = stolen_task_count.load();
+
+        for (const auto& entry : getTaskLatencyStats()) {
+            const std::string prefix = std::string("latency.") + taskTypeName(entry.first) + ".";
+            const TaskLatencyStats& latency = entry.second;
+            stats[prefix + "items"] = latency.run_time.count();
+            stats[prefix + "queue_wait_p50_ns"] = latency.queue_wait.percentile(50.0);
+            stats[prefix + "queue_wait_p95_ns"] = latency.queue_wait.percentile(95.0);
+            stats[prefix + "queue_wait_p99_ns"] = latency.queue_wait.percentile(99.0);
+            stats[prefix + "run_p50_ns"] = latency.run_time.percentile(50.0);
+            stats[prefix + "run_p95_ns"] = latency.run_time.percentile(95.0);
+            stats[prefix + "run_p99_ns"] = latency.run_time.percentile(99.0);
+        }
+
         return stats;
     }
 
+    std::vector<TaskExecutionRecord> WorkflowScheduler::getExecutionRecords() const {
+        std::vector<TaskExecutionRecord> records;
+        for (const auto& worker : worker_records) {
+            records.insert(records.end(), worker.begin(), worker.end());
+        }
+        std::sort(records.begin(), records.end(), [](const TaskExecutionRecord& a, const TaskExecutionRecord& b) {
+            return a.start_ns < b.start_ns;
+        });
+        return records;
+    }
+
+    std::map<TaskType, TaskLatencyStats> WorkflowScheduler::getTaskLatencyStats() const {
+        std::map<TaskType, TaskLatencyStats> latencies;
+        for (const auto& worker : worker_records) {
+            for (const TaskExecutionRecord& record : worker) {
+                TaskLatencyStats& latency = latencies[record.type];
+                latency.queue_wait.record(static_cast<uint64_t>(std::max<int64_t>(0, record.queueWaitNs())));
+                latency.run_time.record(static_cast<uint64_t>(std::max<int64_t>(0, record.runNs())));
+            }
+        }
+        return latencies;
+    }
+
     bool WorkflowScheduler::isRunning() const {
-        return !workers.empty() && !shutdown_requested;
+        return (!workers.empty() || pool_run_active) && !shutdown_requested;
     }
 
     void WorkflowScheduler::clear() {
@@ -194,75 +664,76 @@ namespace scheduler {
         
         std::unique_lock<std::mutex> lock(queue_mutex);
         tasks.clear();
+        task_ids.clear();
+        edges.clear();
+        dependent_offsets.clear();
+        dependent_targets.clear();
+        dependency_counts.clear();
+        topological_order.clear();
+        root_tasks.clear();
+        graph_compiled = false;
         
         // Limpa a fila de prontos
         while (!ready_queue.empty()) {
             ready_queue.pop();
         }
         
+        for (auto& queue : worker_queues) {
+            queue->clear();
+        }
+        pending_ready_items = 0;
+        stolen_task_count = 0;
+        
         processed_texts.clear();
         completed_task_count = 0;
         shutdown_requested = false;
         has_dependency_errors = false;
+        worker_records.clear();
     }
 
     bool WorkflowScheduler::validateDependencyGraph() const {
-        // Implementa algoritmo de detecção de ciclos usando DFS
-        std::set<std::string> visited;
-        std::set<std::string> rec_stack;
-        
-        std::function<bool(const std::string&)> has_cycle = [&](const std::string& task_id) -> bool {
-            visited.insert(task_id);
-            rec_stack.insert(task_id);
-            
-            auto it = tasks.find(task_id);
-            if (it != tasks.end()) {
-                for (const std::string& dependent : it->second.dependents) {
-                    if (rec_stack.count(dependent) || 
-                        (!visited.count(dependent) && has_cycle(dependent))) {
-                        return true;
-                    }
-                }
-            }
-            
-            rec_stack.erase(task_id);
-            return false;
-        };
-        
-        for (const auto& pair : tasks) {
-            if (!visited.count(pair.first)) {
-                if (has_cycle(pair.first)) {
-                    return false;
-                }
-            }
+        // Um grafo congelado já passou pela validação em compile()
+        if (graph_compiled) {
+            return true;
         }
-        
-        return true;
+
+        std::vector<uint32_t> offsets;
+        std::vector<TaskId> targets;
+        std::vector<int> in_degrees;
+        std::vector<TaskId> order;
+        buildAdjacency(tasks.size(), edges, offsets, targets, in_degrees);
+        return topologicalSort(offsets, targets, std::move(in_degrees), order);
     }
 
     std::string WorkflowScheduler::getDependencyGraphString() const {
+        std::vector<std::vector<TaskId>> dependencies(tasks.size());
+        std::vector<std::vector<TaskId>> dependents(tasks.size());
+        for (const auto& edge : edges) {
+            dependencies[edge.second].push_back(edge.first);
+            dependents[edge.first].push_back(edge.second);
+        }
+
+        auto joinNames = [this](const std::vector<TaskId>& ids) {
+            std::string names;
+            for (size_t i = 0; i < ids.size(); ++i) {
+                names += tasks[ids[i]].id;
+                if (i < ids.size() - 1) names += ", ";
+            }
+            return names;
+        };
+
         std::string result = "Grafo de Dependências:\n";
         
-        for (const auto& pair : tasks) {
-            const Task& task = pair.second;
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            const Task& task = tasks[i];
             result += "Tarefa: " + task.id + " (Prioridade: " + std::to_string(task.priority) + ")\n";
             
-            if (!task.dependencies.empty()) {
-                result += "  Dependências: ";
-                for (size_t i = 0; i < task.dependencies.size(); ++i) {
-                    result += task.dependencies[i];
-                    if (i < task.dependencies.size() - 1) result += ", ";
-                }
-                result += "\n";
+            if (!dependencies[i].empty()) {
+                result += "  Dependências: " + joinNames(dependencies[i]) + "\n";
             }
             
-            if (!task.dependents.empty()) {
-                result += "  Sucessores: ";
-                for (size_t i = 0; i < task.dependents.size(); ++i) {
-                    result += task.dependents[i];
-                    if (i < task.dependents.size() - 1) result += ", ";
-                }
-                result += "\n";
+            if (!dependents[i].empty()) {
+                result += "  Sucessores: " + joinNames(dependents[i]) + "\n";
             }
             result += "\n";
         }
@@ -0,0 +1,440 @@
+#include "../../include/tokenizer/bpe_model.h"
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <queue>
+#include <unordered_set>
+
+namespace hf_tokenizers {
+
+    namespace {
+
+        /**
+         * @brief Codifica um code point em UTF-8
+         */
+        std::string encodeUtf8(unsigned int code_point) {
+            std::string result;
+            if (code_point < 0x80) {
+                result.push_back(static_cast<char>(code_point));
+            } else if (code_point < 0x800) {
+                result.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+                result.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+            } else {
+                result.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+                result.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+                result.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+            }
+            return result;
+        }
+
+        /**
+         * @brief Alfabeto de bytes do GPT-2 (bytes_to_unicode)
+         *
+         * Bytes imprimíveis de Latin-1 representam a si mesmos; os demais são
+         * deslocados para os code points a partir de 256.
+         */
+        const std::array<std::string, 256>& byteAlphabet() {
+            static const std::array<std::string, 256> alphabet = [] {
+                std::array<std::string, 256> table;
+                unsigned int shifted = 0;
+                for (unsigned int b = 0; b < 256; ++b) {
+                    bool printable = (b >= '!' && b <= '~') || (b >= 0xA1 && b <= 0xAC) || (b >= 0xAE);
+                    table[b] = encodeUtf8(printable ? b : 256 + shifted++);
+                }
+                return table;
+            }();
+            return alphabet;
+        }
+
+        /**
+         * @brief Converte um token do alfabeto de bytes para os bytes originais
+         *
+         * Tokens com caracteres fora do alfabeto (ex.: especiais como "[UNK]"
+         * são ASCII e portanto já estão no alfabeto) são mantidos como estão.
+         */
+        std::string decodeByteAlphabet(const std::string& token) {
+            static const std::unordered_map<std::string, char> decoder = [] {
+                std::unordered_map<std::string, char> table;
+                const auto& alphabet = byteAlphabet();
+                for (unsigned int b = 0; b < 256; ++b) {
+                    table.emplace(alphabet[b], static_cast<char>(b));
+                }
+                return table;
+            }();
+
+            std::string bytes;
+            bytes.reserve(token.size());
+            size_t pos = 0;
+            while (pos < token.size()) {
+                unsigned char lead = static_cast<unsigned char>(token[pos]);
+                size_t length = lead < 0x80 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+                auto it = decoder.find(token.substr(pos, length));
+                if (it == decoder.end()) {
+                    return token;
+                }
+                bytes.push_back(it->second);
+                pos += length;
+            }
+            return bytes;
+        }
+
+        inline uint64_t pairKey(unsigned int left, unsigned int right) {
+            return (static_cast<uint64_t>(left) << 32) | right;
+        }
+
+        /**
+         * @brief Merge candidato na fila: menor rank primeiro, depois o mais à esquerda
+         */
+        struct MergeCandidate {
+            uint32_t rank;
+            int32_t left;
+            unsigned int left_id;
+            unsigned int right_id;
+
+            bool operator>(const MergeCandidate& other) const {
+                return rank != other.rank ? rank > other.rank : left > other.left;
+            }
+        };
+
+        /**
+         * @brief Símbolo da lista ligada de uma palavra
+         */
+        struct Symbol {
+            unsigned int id;
+            int32_t prev;
+            int32_t next;
+        };
+
+        constexpr unsigned int REMOVED = 0xFFFFFFFFu;
+
+    } // namespace
+
+    std::string BpeModel::toByteAlphabet(std::string_view bytes) {
+        const auto& alphabet = byteAlphabet();
+        std::string result;
+        result.reserve(bytes.size() * 2);
+        for (char c : bytes) {
+            result += alphabet[static_cast<unsigned char>(c)];
+        }
+        return result;
+    }
+
+    bool BpeModel::load(const std::string& vocab_path, const std::string& merges_path) {
+        std::ifstream vocab_file(vocab_path);
+        std::ifstream merges_file(merges_path);
+        if (!vocab_file.is_open() || !merges_file.is_open()) {
+            return false;
+        }
+
+        std::vector<std::string> vocab;
+        std::string line;
+        while (std::getline(vocab_file, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            vocab.push_back(line);
+        }
+
+        std::vector<std::pair<std::string, std::string>> merges;
+        while (std::getline(merges_file, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.empty() || line.rfind("#version", 0) == 0) continue;
+            size_t space = line.find(' ');
+            if (space == std::string::npos || space == 0 || space + 1 == line.size()) continue;
+            merges.emplace_back(line.substr(0, space), line.substr(space + 1));
+        }
+
+        if (vocab.empty()) {
+            return false;
+        }
+        load(vocab, merges);
+        return true;
+    }
+
+    void BpeModel::load(const std::vector<std::string>& vocab,
+                        const std::vector<std::pair<std::string, std::string>>& merges) {
+        token_to_id.clear();
+        id_to_bytes.clear();
+        merge_ranks.clear();
+        merge_count = 0;
+
+        id_to_bytes.reserve(vocab.size());
+        for (size_t id = 0; id < vocab.size(); ++id) {
+            token_to_id.emplace(vocab[id], static_cast<unsigned int>(id));
+            id_to_bytes.push_back(decodeByteAlphabet(vocab[id]));
+        }
+
+        unknown_id = 0;
+        for (const char* candidate : {"[UNK]", "<unk>"}) {
+            auto it = token_to_id.find(candidate);
+            if (it != token_to_id.end()) {
+                unknown_id = it->second;
+                break;
+            }
+        }
+
+        const auto& alphabet = byteAlphabet();
+        for (unsigned int b = 0; b < 256; ++b) {
+            auto it = token_to_id.find(alphabet[b]);
+            byte_ids[b] = it != token_to_id.end() ? it->second : unknown_id;
+        }
+
+        // Merges cujo resultado não está no vocabulário nunca podem ser aplicados
+        for (size_t rank = 0; rank < merges.size(); ++rank) {
+            auto left = token_to_id.find(merges[rank].first);
+            auto right = token_to_id.find(merges[rank].second);
+            auto merged = token_to_id.find(merges[rank].first + merges[rank].second);
+            if (left == token_to_id.end() || right == token_to_id.end() || merged == token_to_id.end()) {
+                continue;
+            }
+            if (merge_ranks.emplace(pairKey(left->second, right->second),
+                                    std::make_pair(static_cast<uint32_t>(rank), merged->second)).second) {
+                ++merge_count;
+            }
+        }
+
+        for (auto& shard : cache) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.words.clear();
+        }
+    }
+
+    void BpeModel::mergeWord(std::string_view word, std::vector<unsigned int>& ids) const {
+        thread_local std::vector<Symbol> symbols;
+        thread_local std::vector<MergeCandidate> queue;   // heap mínimo por (rank, posição)
+
+        const int32_t size = static_cast<int32_t>(word.size());
+        symbols.resize(word.size());
+        for (int32_t i = 0; i < size; ++i) {
+            symbols[i] = {byte_ids[static_cast<unsigned char>(word[i])], i - 1, i + 1 < size ? i + 1 : -1};
+        }
+
+        queue.clear();
+        auto pushPair = [&](int32_t left) {
+            int32_t right = symbols[left].next;
+            if (right < 0) return;
+            auto it = merge_ranks.find(pairKey(symbols[left].id, symbols[right].id));
+            if (it != merge_ranks.end()) {
+                queue.push_back({it->second.first, left, symbols[left].id, symbols[right].id});
+                std::push_heap(queue.begin(), queue.end(), std::greater<MergeCandidate>());
+            }
+        };
+
+        for (int32_t i = 0; i + 1 < size; ++i) {
+            pushPair(i);
+        }
+
+        while (!queue.empty()) {
+            std::pop_heap(queue.begin(), queue.end(), std::greater<MergeCandidate>());
+            MergeCandidate candidate = queue.back();
+            queue.pop_back();
+
+            // Candidatos obsoletos: um dos lados já foi fundido com outro vizinho
+            Symbol& left = symbols[candidate.left];
+            if (left.id != candidate.left_id || left.next < 0 || symbols[left.next].id != candidate.right_id) {
+                continue;
+            }
+
+            Symbol& right = symbols[left.next];
+            left.id = merge_ranks.at(pairKey(candidate.left_id, candidate.right_id)).second;
+            right.id = REMOVED;
+            left.next = right.next;
+            if (left.next >= 0) {
+                symbols[left.next].prev = candidate.left;
+            }
+
+            if (left.prev >= 0) {
+                pushPair(left.prev);
+            }
+            pushPair(candidate.left);
+        }
+
+        ids.clear();
+        for (int32_t i = size > 0 ? 0 : -1; i >= 0; i = symbols[i].next) {
+            ids.push_back(symbols[i].id);
+        }
+    }
+
+    void BpeModel::encodeWord(std::string_view word, std::vector<BpeToken>& tokens) const {
+        if (word.empty()) {
+            return;
+        }
+
+        // A chave da busca reaproveita o buffer da thread: palavras longas não alocam a cada acerto
+        thread_local std::vector<unsigned int> ids;
+        thread_local std::string key;
+        key.assign(word.data(), word.size());
+        CacheShard& shard = cache[std::hash<std::string_view>()(word) % CACHE_SHARDS];
+
+        bool cached = false;
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.words.find(key);
+            if (it != shard.words.end()) {
+                ids = it->second;
+                cached = true;
+            }
+        }
+
+        if (!cached) {
+            mergeWord(word, ids);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            if (shard.words.size() >= CACHE_ENTRIES_PER_SHARD) {
+                shard.words.clear();   // Limita a memória do cache em corpora com muitas palavras raras
+            }
+            shard.words.emplace(key, ids);
+        }
+
+        for (unsigned int id : ids) {
+            tokens.push_back({id, id_to_bytes[id]});
+        }
+    }
+
+    size_t BpeModel::cachedWords() const {
+        size_t total = 0;
+        for (auto& shard : cache) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            total += shard.words.size();
+        }
+        return total;
+    }
+
+    void BpeModel::train(const std::map<std::string, size_t>& word_counts, size_t vocab_size,
+                         const std::vector<std::string>& special_tokens,
+                         std::vector<std::string>& vocab,
+                         std::vector<std::pair<std::string, std::string>>& merges) {
+        vocab = special_tokens;
+        merges.clear();
+
+        std::unordered_map<std::string, unsigned int> ids;
+        for (size_t i = 0; i < vocab.size(); ++i) {
+            ids.emplace(vocab[i], static_cast<unsigned int>(i));
+        }
+        const auto& alphabet = byteAlphabet();
+        std::array<unsigned int, 256> byte_token{};
+        for (unsigned int b = 0; b < 256; ++b) {
+            auto inserted = ids.emplace(alphabet[b], static_cast<unsigned int>(vocab.size()));
+            if (inserted.second) {
+                vocab.push_back(alphabet[b]);
+            }
+            byte_token[b] = inserted.first->second;
+        }
+
+        // Palavras como sequências de IDs, com a frequência de cada uma
+        std::vector<std::vector<unsigned int>> words;
+        std::vector<long long> frequencies;
+        for (const auto& entry : word_counts) {
+            if (entry.first.empty() || entry.second == 0) continue;
+            std::vector<unsigned int> sequence;
+            for (char c : entry.first) {
+                sequence.push_back(byte_token[static_cast<unsigned char>(c)]);
+            }
+            words.push_back(std::move(sequence));
+            frequencies.push_back(static_cast<long long>(entry.second));
+        }
+
+        std::unordered_map<uint64_t, long long> pair_counts;
+        std::unordered_map<uint64_t, std::vector<size_t>> pair_words;
+        for (size_t w = 0; w < words.size(); ++w) {
+            for (size_t i = 0; i + 1 < words[w].size(); ++i) {
+                uint64_t key = pairKey(words[w][i], words[w][i + 1]);
+                pair_counts[key] += frequencies[w];
+                pair_words[key].push_back(w);
+            }
+        }
+
+        // Fila com avaliação preguiçosa: entradas cuja contagem mudou são descartadas ao sair
+        using HeapEntry = std::pair<long long, uint64_t>;
+        auto heap_order = [](const HeapEntry& a, const HeapEntry& b) {
+            return a.first != b.first ? a.first < b.first : a.second > b.second;
+        };
+        std::priority_queue<HeapEntry, std::vector<HeapEntry>, decltype(heap_order)> heap(heap_order);
+        for (const auto& entry : pair_counts) {
+            heap.push({entry.second, entry.first});
+        }
+
+        std::vector<size_t> visited(words.size(), 0);
+        size_t step = 0;
+        while (vocab.size() < vocab_size && !heap.empty()) {
+            HeapEntry top = heap.top();
+            heap.pop();
+            auto count_it = pair_counts.find(top.second);
+            if (count_it == pair_counts.end() || count_it->second != top.first || top.first <= 0) {
+                continue;
+            }
+
+            ++step;
+            unsigned int left = static_cast<unsigned int>(top.second >> 32);
+            unsigned int right = static_cast<unsigned int>(top.second & 0xFFFFFFFFu);
+            std::string merged_token = vocab[left] + vocab[right];
+            auto inserted = ids.emplace(merged_token, static_cast<unsigned int>(vocab.size()));
+            if (inserted.second) {
+                vocab.push_back(merged_token);
+            }
+            unsigned int merged = inserted.first->second;
+            merges.emplace_back(vocab[left], vocab[right]);
+
+            std::vector<size_t> affected = std::move(pair_words[top.second]);
+            pair_words.erase(top.second);
+            std::unordered_set<uint64_t> changed;
+
+            for (size_t w : affected) {
+                if (visited[w] == step) continue;
+                visited[w] = step;
+
+                std::vector<unsigned int>& sequence = words[w];
+                const long long frequency = frequencies[w];
+                for (size_t i = 0; i + 1 < sequence.size(); ++i) {
+                    uint64_t key = pairKey(sequence[i], sequence[i + 1]);
+                    pair_counts[key] -= frequency;
+                    changed.insert(key);
+                }
+
+                std::vector<unsigned int> rewritten;
+                rewritten.reserve(sequence.size());
+                for (size_t i = 0; i < sequence.size(); ++i) {
+                    if (i + 1 < sequence.size() && sequence[i] == left && sequence[i + 1] == right) {
+                        rewritten.push_back(merged);
+                        ++i;
+                    } else {
+                        rewritten.push_back(sequence[i]);
+                    }
+                }
+                sequence.swap(rewritten);
+
+                for (size_t i = 0; i + 1 < sequence.size(); ++i) {
+                    uint64_t key = pairKey(sequence[i], sequence[i + 1]);
+                    pair_counts[key] += frequency;
+                    pair_words[key].push_back(w);
+                    changed.insert(key);
+                }
+            }
+
+            for (uint64_t key : changed) {
+                auto it = pair_counts.find(key);
+                if (it->second > 0) {
+                    heap.push({it->second, key});
+                } else {
+                    pair_counts.erase(it);
+                }
+            }
+        }
+    }
+
+    bool BpeModel::save(const std::string& vocab_path, const std::string& merges_path,
+                        const std::vector<std::string>& vocab,
+                        const std::vector<std::pair<std::string, std::string>>& merges) {
+        std::ofstream vocab_file(vocab_path, std::ios::binary);
+        std::ofstream merges_file(merges_path, std::ios::binary);
+        if (!vocab_file.is_open() || !merges_file.is_open()) {
+            return false;
+        }
+        for (const auto& token : vocab) {
+            vocab_file << token << '\n';
+        }
+        merges_file << "#version: 0.2\n";
+        for (const auto& merge : merges) {
+            merges_file << merge.first << ' ' << merge.second << '\n';
+        }
+        return static_cast<bool>(vocab_file) && static_cast<bool>(merges_file);
+    }
+
+} // namespace hf_tokenizers
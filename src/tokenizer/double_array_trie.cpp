@@ -0,0 +1,157 @@
+#include "../../include/tokenizer/double_array_trie.h"
+#include <algorithm>
+
+namespace hf_tokenizers {
+
+    void DoubleArrayTrie::build(std::vector<std::pair<std::string, unsigned int>> entries) {
+        units.clear();
+        values.clear();
+        key_count = 0;
+        free_next.clear();
+        free_prev.clear();
+        free_head = -1;
+        free_tail = -1;
+
+        entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                     [](const auto& entry) { return entry.first.empty(); }),
+                      entries.end());
+        // Ordenação estável: entre chaves repetidas, a primeira ocorrência fica na frente
+        std::stable_sort(entries.begin(), entries.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
+        entries.erase(std::unique(entries.begin(), entries.end(),
+                                  [](const auto& a, const auto& b) { return a.first == b.first; }),
+                      entries.end());
+        if (entries.empty()) {
+            return;
+        }
+
+        ensureSize(256);
+        occupy(0, 0);   // A raiz nunca é uma posição livre
+        key_count = entries.size();
+        buildNode(entries, 0, entries.size(), 0, 0);
+
+        free_next.clear();
+        free_next.shrink_to_fit();
+        free_prev.clear();
+        free_prev.shrink_to_fit();
+
+        // Remove a folga final deixada pela busca de bases
+        size_t used = units.size();
+        while (used > 1 && units[used - 1].check == -1) {
+            --used;
+        }
+        units.resize(used);
+        values.resize(used);
+        units.shrink_to_fit();
+        values.shrink_to_fit();
+    }
+
+    void DoubleArrayTrie::buildNode(const std::vector<std::pair<std::string, unsigned int>>& entries,
+                                    size_t begin, size_t end, size_t depth, int32_t state) {
+        // Como as chaves estão ordenadas, a que termina neste estado vem primeiro
+        if (entries[begin].first.size() == depth) {
+            values[state] = entries[begin].second;
+            ++begin;
+        }
+        if (begin == end) {
+            return;
+        }
+
+        // Agrupa as chaves restantes pelo byte na posição depth
+        std::vector<unsigned char> labels;
+        std::vector<size_t> group_starts;
+        for (size_t i = begin; i < end; ++i) {
+            unsigned char label = static_cast<unsigned char>(entries[i].first[depth]);
+            if (labels.empty() || labels.back() != label) {
+                labels.push_back(label);
+                group_starts.push_back(i);
+            }
+        }
+        group_starts.push_back(end);
+
+        int32_t base = findBase(labels);
+        units[state].base = base;
+        // Reserva todos os filhos antes de descer, para que não sejam reutilizados
+        for (unsigned char label : labels) {
+            occupy(base + label, state);
+        }
+
+        for (size_t g = 0; g < labels.size(); ++g) {
+            buildNode(entries, group_starts[g], group_starts[g + 1], depth + 1, base + labels[g]);
+        }
+    }
+
+    int32_t DoubleArrayTrie::findBase(const std::vector<unsigned char>& labels) {
+        // Percorre só as posições livres, candidatas para o primeiro rótulo
+        int32_t position = free_head;
+        while (true) {
+            if (position < 0) {
+                // Sem espaço: cresce o vetor; as novas posições entram no fim da lista
+                size_t old_size = units.size();
+                ensureSize(old_size + 256);
+                position = static_cast<int32_t>(old_size);
+            }
+            if (position >= static_cast<int32_t>(labels.front()) + 1) {
+                size_t base = static_cast<size_t>(position) - labels.front();
+                ensureSize(base + labels.back() + 1);
+                bool fits = true;
+                for (size_t i = 1; i < labels.size(); ++i) {
+                    if (units[base + labels[i]].check != -1) {
+                        fits = false;
+                        break;
+                    }
+                }
+                if (fits) {
+                    return static_cast<int32_t>(base);
+                }
+            }
+            position = free_next[position];
+        }
+    }
+
+    void DoubleArrayTrie::occupy(int32_t position, int32_t parent) {
+        units[position].check = parent;
+        int32_t prev = free_prev[position];
+        int32_t next = free_next[position];
+        if (prev >= 0) free_next[prev] = next; else free_head = next;
+        if (next >= 0) free_prev[next] = prev; else free_tail = prev;
+    }
+
+    void DoubleArrayTrie::ensureSize(size_t size) {
+        if (units.size() < size) {
+            size_t old_size = units.size();
+            size_t grown = std::max(size, units.size() * 2);
+            units.resize(grown);
+            values.resize(grown, -1);
+            free_next.resize(grown, -1);
+            free_prev.resize(grown, -1);
+            for (size_t i = old_size; i < grown; ++i) {
+                int32_t position = static_cast<int32_t>(i);
+                free_prev[i] = free_tail;
+                if (free_tail >= 0) free_next[free_tail] = position; else free_head = position;
+                free_tail = position;
+            }
+        }
+    }
+
+    bool DoubleArrayTrie::find(std::string_view key, unsigned int& id) const {
+        if (units.empty() || key.empty()) {
+            return false;
+        }
+        int32_t state = 0;
+        const int32_t limit = static_cast<int32_t>(units.size());
+        for (char c : key) {
+            int32_t next = units[state].base + static_cast<unsigned char>(c);
+            if (next >= limit || units[next].check != state) {
+                return false;
+            }
+            state = next;
+        }
+        if (values[state] < 0) {
+            return false;
+        }
+        id = static_cast<unsigned int>(values[state]);
+        return true;
+    }
+
+} // namespace hf_tokenizers
@@ -0,0 +1,33 @@
+#include "../../include/tokenizer/tokenizer_registry.h"
+
+std::mutex TokenizerRegistry::registry_mutex;
+std::map<std::pair<std::string, std::string>, std::shared_ptr<TokenizerRegistry::Entry>> TokenizerRegistry::entries;
+
+std::shared_ptr<const TokenizerWrapper> TokenizerRegistry::get(const std::string& vocab_path,
+                                                               const std::string& merges_path) {
+    std::shared_ptr<Entry> entry;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        auto& slot = entries[{vocab_path, merges_path}];
+        if (!slot) {
+            slot = std::make_shared<Entry>();
+        }
+        entry = slot;
+    }
+
+    // O carregamento fica fora do mutex do mapa para não bloquear os outros pares
+    std::call_once(entry->loaded, [&]() {
+        entry->tokenizer = std::make_shared<TokenizerWrapper>(vocab_path, merges_path);
+    });
+    return entry->tokenizer;
+}
+
+size_t TokenizerRegistry::size() {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    return entries.size();
+}
+
+void TokenizerRegistry::clear() {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    entries.clear();
+}
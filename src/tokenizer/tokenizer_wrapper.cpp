@@ -1,4 +1,5 @@
 #include "../../include/tokenizer/tokenizer_wrapper.h"
+#include "../../include/utils/logger.h"
 
 // Implementações do namespace hf_tokenizers
 namespace hf_tokenizers {
@@ -33,10 +34,16 @@ namespace hf_tokenizers {
 
     // Implementação do construtor do Tokenizer
     Tokenizer::Tokenizer(const std::string& vocab_path, const std::string& merges_path) {
-        std::cout << "  [TokenizerWrapper] Carregando o modelo de tokenizador BPE de: " << vocab_path << " e " << merges_path << std::endl;
-        // Em uma implementação real, carregaria os arquivos do modelo SentencePiece ou BPE
-        // Exemplo: tokenizer = Tokenizer::from_file(model_path);
-        // Simulação de vocabulário e merges para exemplo
+        PIPELINE_LOG_INFO("  [TokenizerWrapper] Carregando o modelo de tokenizador BPE de: " << vocab_path << " e " << merges_path);
+        auto model = std::make_unique<BpeModel>();
+        if (model->load(vocab_path, merges_path)) {
+            bpe_model = std::move(model);
+            PIPELINE_LOG_INFO("  [TokenizerWrapper] Modelo BPE carregado: " << bpe_model->vocabularySize()
+                              << " tokens, " << bpe_model->mergeCount() << " merges.");
+            return;
+        }
+
+        // Sem os arquivos do modelo, usa um vocabulário simulado para exemplo
         vocabulary = {
             {"[CLS]", 101}, {"[SEP]", 102}, {"[EOF]", 103},
             {"o", 1}, {"e", 2}, {"a", 3}, {" ", 4}, {"do", 5},
@@ -45,56 +52,66 @@ namespace hf_tokenizers {
             {"texto", 14}, {"documentos", 15}, {"jurídicos", 16}
             // ... e muitos outros tokens/subtokens
         };
-        std::cout << "  [TokenizerWrapper] Modelo de tokenizador carregado com sucesso (simulado)." << std::endl;
+        compile_vocabulary();
+        PIPELINE_LOG_WARNING("  [TokenizerWrapper] Arquivos do modelo não encontrados; usando vocabulário simulado.");
+    }
+
+    Tokenizer::Tokenizer(std::map<std::string, unsigned int> vocab) : vocabulary(std::move(vocab)) {
+        compile_vocabulary();
+    }
+
+    void Tokenizer::compile_vocabulary() {
+        vocabulary_trie.build(std::vector<std::pair<std::string, unsigned int>>(vocabulary.begin(), vocabulary.end()));
     }
 
     // Implementação do método encode
     Encoding Tokenizer::encode(const std::string& text) const {
         Encoding encoding;
-        std::string current_token_str;
-        for (char c : text) {
-            if (c == ' ' || c == '.' || c == ',' || c == '\n') { // Simples separador
-                if (!current_token_str.empty()) {
-                    process_token(current_token_str, encoding);
-                    current_token_str.clear();
-                }
-                if (c == ' ') { // Adiciona espaço como token se relevante
-                    process_token(" ", encoding);
-                }
-            } else {
-                current_token_str += c;
-            }
-        }
-        if (!current_token_str.empty()) {
-            process_token(current_token_str, encoding);
-        }
+        for_each_word(text, [this, &encoding](std::string_view word) {
+            process_token(word, encoding);
+        });
         return encoding;
     }
 
+    // Implementação do método encode_word
+    void Tokenizer::encode_word(const std::string& word, Encoding& encoding) const {
+        process_token(word, encoding);
+    }
+
     // Implementação do método process_token
-    void Tokenizer::process_token(const std::string& token_str, Encoding& encoding) const {
-        // Simula o BPE: para cada "palavra", tentamos dividi-la em subtokens do vocabulário
-        // Esta é uma simulação muito simplificada; um BPE real é mais complexo.
-        std::string temp_str = token_str;
-        while (!temp_str.empty()) {
-            bool found = false;
-            for (int len = temp_str.length(); len > 0; --len) {
-                std::string sub_token = temp_str.substr(0, len);
-                if (vocabulary.count(sub_token)) {
-                    encoding.tokens.push_back({sub_token, vocabulary.at(sub_token), {}});
-                    encoding.ids.push_back(vocabulary.at(sub_token));
-                    encoding.type_ids.push_back(0); // Exemplo
-                    temp_str = temp_str.substr(len);
-                    found = true;
-                    break;
-                }
-            }
-            if (!found) {
-                // Se não encontrar, trata como token desconhecido (simulação)
-                encoding.tokens.push_back({temp_str, 0, {}}); // ID 0 para desconhecido
-                encoding.ids.push_back(0);
-                encoding.type_ids.push_back(0);
-                temp_str.clear();
+    void Tokenizer::process_token(std::string_view token_str, Encoding& encoding) const {
+        thread_local std::vector<BpeToken> pieces;
+        pieces.clear();
+        encode_pieces(token_str, pieces);
+        for (const BpeToken& piece : pieces) {
+            encoding.tokens.push_back({std::string(piece.text), piece.id, {}});
+            encoding.ids.push_back(piece.id);
+            encoding.type_ids.push_back(0); // Exemplo
+        }
+    }
+
+    // Implementação do método encode_pieces
+    void Tokenizer::encode_pieces(std::string_view word, std::vector<BpeToken>& pieces) const {
+        if (bpe_model) {
+            bpe_model->encodeWord(word, pieces);
+            return;
+        }
+
+        // Simula o BPE: para cada "palavra", consome repetidamente o maior prefixo presente no
+        // vocabulário; a busca é uma única varredura do trie a partir da posição atual.
+        const char* data = word.data();
+        const size_t size = word.size();
+        size_t pos = 0;
+        while (pos < size) {
+            size_t length = 0;
+            unsigned int id = 0;
+            if (vocabulary_trie.longestPrefix(data + pos, size - pos, length, id)) {
+                pieces.push_back({id, word.substr(pos, length)});
+                pos += length;
+            } else {
+                // Se não encontrar, trata o restante como token desconhecido (simulação)
+                pieces.push_back({0, word.substr(pos)}); // ID 0 para desconhecido
+                pos = size;
             }
         }
     }
@@ -110,7 +127,7 @@ TokenizerWrapper::~TokenizerWrapper() {
     delete tokenizer;
 }
 
-hf_tokenizers::Encoding TokenizerWrapper::tokenize_and_add_special_tokens(const std::string& text) {
+hf_tokenizers::Encoding TokenizerWrapper::tokenize_and_add_special_tokens(const std::string& text) const {
     if (!tokenizer) {
         throw std::runtime_error("Tokenizer não inicializado.");
     }
@@ -119,11 +136,25 @@ hf_tokenizers::Encoding TokenizerWrapper::tokenize_and_add_special_tokens(const
     return encoding;
 }
 
-std::vector<unsigned int> TokenizerWrapper::text_to_ids(const std::string& text) {
+std::vector<unsigned int> TokenizerWrapper::text_to_ids(const std::string& text) const {
     hf_tokenizers::Encoding encoding = tokenize_and_add_special_tokens(text);
     return encoding.get_ids();
 }
 
+void TokenizerWrapper::tokenize_word(const std::string& word, hf_tokenizers::Encoding& encoding) const {
+    if (!tokenizer) {
+        throw std::runtime_error("Tokenizer não inicializado.");
+    }
+    tokenizer->encode_word(word, encoding);
+}
+
+void TokenizerWrapper::tokenize_pieces(std::string_view word, std::vector<hf_tokenizers::BpeToken>& pieces) const {
+    if (!tokenizer) {
+        throw std::runtime_error("Tokenizer não inicializado.");
+    }
+    tokenizer->encode_pieces(word, pieces);
+}
+
 // Implementação dos construtores/operadores de movimento
 TokenizerWrapper::TokenizerWrapper(TokenizerWrapper&& other) noexcept 
     : tokenizer(other.tokenizer) {
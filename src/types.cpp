@@ -2,16 +2,42 @@
 
 namespace legal_doc_pipeline {
 
+    const char* taskTypeName(TaskType type) {
+        switch (type) {
+            case TaskType::TEXT_CLEANING: return "TEXT_CLEANING";
+            case TaskType::NORMALIZATION: return "NORMALIZATION";
+            case TaskType::WORD_TOKENIZATION: return "WORD_TOKENIZATION";
+            case TaskType::BPE_TOKENIZATION: return "BPE_TOKENIZATION";
+            case TaskType::PARTITION_TOKENS: return "PARTITION_TOKENS";
+            case TaskType::ADD_SPECIAL_TOKENS: return "ADD_SPECIAL_TOKENS";
+            case TaskType::TOKENS_TO_INDICES: return "TOKENS_TO_INDICES";
+            case TaskType::GENERATE_EMBEDDINGS: return "GENERATE_EMBEDDINGS";
+        }
+        return "UNKNOWN";
+    }
+
     Task::Task(std::string id, TaskType type, int priority, std::function<void(std::vector<std::string>&)> op)
         : id(std::move(id)), type(type), priority(priority), operation(std::move(op)),
-          remaining_dependencies(0), is_completed(false) {}
+          grain_size(0), remaining_dependencies(0), remaining_subtasks(0), is_completed(false) {}
+
+    Task::Task(std::string id, TaskType type, int priority, RangeOperation range_op, size_t grain_size)
+        : id(std::move(id)), type(type), priority(priority), range_operation(std::move(range_op)),
+          grain_size(grain_size), remaining_dependencies(0), remaining_subtasks(0), is_completed(false) {
+        RangeOperation whole = range_operation;
+        operation = [whole](std::vector<std::string>& texts) { whole(texts, 0, texts.size()); };
+    }
 
     Task::Task(const Task& other)
-        : id(other.id), type(other.type), priority(other.priority), dependencies(other.dependencies),
-          dependents(other.dependents), operation(other.operation),
+        : id(other.id), type(other.type), priority(other.priority), operation(other.operation),
+          range_operation(other.range_operation), grain_size(other.grain_size),
           remaining_dependencies(other.remaining_dependencies.load()),
+          remaining_subtasks(other.remaining_subtasks.load()),
           is_completed(other.is_completed) {}
 
+    bool Task::isDataParallel() const {
+        return static_cast<bool>(range_operation);
+    }
+
     bool Task::operator<(const Task& other) const {
         return priority > other.priority; // Min-heap por padrão, queremos Max-heap para prioridade
     }
@@ -23,4 +49,12 @@ namespace legal_doc_pipeline {
         return a->priority > b->priority;
     }
 
+    bool WorkItemCompare::operator()(const WorkItem& a, const WorkItem& b) const {
+        // Mesma ordenação de TaskPtrCompare; intervalos da mesma tarefa saem em ordem crescente
+        if (a.task->priority != b.task->priority) {
+            return a.task->priority > b.task->priority;
+        }
+        return a.begin > b.begin;
+    }
+
 } // namespace legal_doc_pipeline
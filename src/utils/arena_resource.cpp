@@ -0,0 +1,81 @@
+#include "../../include/utils/arena_resource.h"
+#include <algorithm>
+
+namespace legal_doc_pipeline {
+namespace utils {
+
+    namespace {
+
+        const size_t BLOCK_ALIGNMENT = alignof(std::max_align_t);
+
+        /**
+         * @brief Posição no bloco do primeiro endereço alinhado a partir de offset
+         */
+        size_t alignedOffset(const std::byte* data, size_t offset, size_t alignment) {
+            uintptr_t address = reinterpret_cast<uintptr_t>(data) + offset;
+            uintptr_t aligned = (address + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+            return offset + static_cast<size_t>(aligned - address);
+        }
+
+    } // namespace
+
+    ArenaResource::ArenaResource(size_t initial_block_bytes, std::pmr::memory_resource* upstream)
+        : upstream(upstream), next_block_size(std::max<size_t>(initial_block_bytes, 256)) {}
+
+    ArenaResource::~ArenaResource() {
+        for (const Block& block : blocks) {
+            upstream->deallocate(block.data, block.size, BLOCK_ALIGNMENT);
+        }
+    }
+
+    void* ArenaResource::do_allocate(size_t bytes, size_t alignment) {
+        ++allocation_count;
+        allocated_bytes += bytes;
+
+        // Procura espaço no bloco atual e, depois, nos blocos já reservados por lotes anteriores
+        while (current_block < blocks.size()) {
+            const Block& block = blocks[current_block];
+            size_t aligned = alignedOffset(block.data, offset, alignment);
+            if (aligned + bytes <= block.size) {
+                offset = aligned + bytes;
+                return block.data + aligned;
+            }
+            ++current_block;
+            offset = 0;
+        }
+
+        size_t size = std::max(next_block_size, bytes + alignment);
+        std::byte* data = static_cast<std::byte*>(upstream->allocate(size, BLOCK_ALIGNMENT));
+        blocks.push_back({data, size});
+        ++upstream_count;
+        next_block_size = size * 2;
+
+        current_block = blocks.size() - 1;
+        size_t aligned = alignedOffset(data, 0, alignment);
+        offset = aligned + bytes;
+        return data + aligned;
+    }
+
+    void ArenaResource::do_deallocate(void*, size_t, size_t) {
+        // A memória só volta em release() ou na destruição da arena
+    }
+
+    bool ArenaResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+        return this == &other;
+    }
+
+    void ArenaResource::release() {
+        current_block = 0;
+        offset = 0;
+    }
+
+    size_t ArenaResource::capacity() const {
+        size_t total = 0;
+        for (const Block& block : blocks) {
+            total += block.size;
+        }
+        return total;
+    }
+
+} // namespace utils
+} // namespace legal_doc_pipeline
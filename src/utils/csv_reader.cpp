@@ -1,8 +1,10 @@
 #include "../../include/utils/csv_reader.h"
+#include "../../include/utils/csv_record_iterator.h"
 #include <fstream>
-#include <sstream>
 #include <iostream>
+#include <sstream>
 #include <map>
+#include <utility>
 
 namespace legal_doc_pipeline {
 namespace utils {
@@ -13,26 +15,34 @@ namespace utils {
         char delimiter) {
         
         std::vector<std::string> column_data;
-        std::ifstream file(filename);
-        
-        if (!file.is_open()) {
+        forEachValue(filename, column_name,
+                     [&column_data](std::string& value) { column_data.push_back(std::move(value)); },
+                     delimiter);
+        return column_data;
+    }
+
+    size_t CsvReader::forEachValue(
+        const std::string& filename,
+        const std::string& column_name,
+        const std::function<void(std::string&)>& consumer,
+        char delimiter) {
+
+        CsvRecordIterator records(filename, delimiter);
+        if (!records.isOpen()) {
             std::cerr << "Erro ao abrir o arquivo CSV: " << filename << std::endl;
-            return column_data;
+            return 0;
         }
 
-        std::string line;
-        if (!std::getline(file, line)) {
+        std::vector<std::string> cells;
+        if (!records.next(cells)) {
             std::cerr << "Erro ao ler o cabeçalho do arquivo CSV" << std::endl;
-            return column_data;
+            return 0;
         }
 
         // Parse do cabeçalho
-        line = removeBOM(line); // Remove BOM UTF-8 se presente
-        std::vector<std::string> headers = parseLine(line, delimiter);
         int column_index = -1;
-        
-        for (size_t i = 0; i < headers.size(); ++i) {
-            if (removeQuotes(headers[i]) == column_name) {
+        for (size_t i = 0; i < cells.size(); ++i) {
+            if (removeQuotes(cells[i]) == column_name) {
                 column_index = static_cast<int>(i);
                 break;
             }
@@ -40,21 +50,27 @@ namespace utils {
 
         if (column_index == -1) {
             std::cerr << "Coluna '" << column_name << "' não encontrada no CSV." << std::endl;
-            return column_data;
+            return 0;
         }
 
-        // Lê os dados da coluna
-        while (std::getline(file, line)) {
-            std::vector<std::string> cells = parseLine(line, delimiter);
+        // Lê os dados da coluna, um registro lógico por vez
+        size_t count = 0;
+        std::string value;
+        while (records.next(cells)) {
             if (column_index < static_cast<int>(cells.size())) {
-                column_data.push_back(removeQuotes(cells[column_index]));
+                value = removeQuotes(cells[column_index]);
             } else {
-                column_data.push_back(""); // Célula vazia se a linha não tem colunas suficientes
+                value.clear(); // Célula vazia se o registro não tem colunas suficientes
             }
+            consumer(value);
+            ++count;
         }
-        
-        file.close();
-        return column_data;
+
+        if (records.hasUnterminatedQuote()) {
+            std::cerr << "Aviso: aspas não fechadas no registro " << records.getRecordsRead()
+                      << " de " << filename << std::endl;
+        }
+        return count;
     }
 
     std::map<std::string, std::vector<std::string>> CsvReader::readAllColumns(
@@ -62,40 +78,34 @@ namespace utils {
         char delimiter) {
         
         std::map<std::string, std::vector<std::string>> data;
-        std::ifstream file(filename);
+        CsvRecordIterator records(filename, delimiter);
         
-        if (!file.is_open()) {
+        if (!records.isOpen()) {
             std::cerr << "Erro ao abrir o arquivo CSV: " << filename << std::endl;
             return data;
         }
 
-        std::string line;
-        if (!std::getline(file, line)) {
+        std::vector<std::string> headers;
+        if (!records.next(headers)) {
             std::cerr << "Erro ao ler o cabeçalho do arquivo CSV" << std::endl;
             return data;
         }
 
-        // Parse do cabeçalho
-        line = removeBOM(line); // Remove BOM UTF-8 se presente
-        std::vector<std::string> headers = parseLine(line, delimiter);
-        
         // Inicializa os vetores para cada coluna
-        for (const auto& header : headers) {
-            data[removeQuotes(header)] = std::vector<std::string>();
+        for (auto& header : headers) {
+            header = removeQuotes(header);
+            data[header] = std::vector<std::string>();
         }
 
         // Lê os dados
-        while (std::getline(file, line)) {
-            std::vector<std::string> cells = parseLine(line, delimiter);
-            
+        std::vector<std::string> cells;
+        while (records.next(cells)) {
             for (size_t i = 0; i < headers.size(); ++i) {
-                std::string header_name = removeQuotes(headers[i]);
                 std::string cell_value = (i < cells.size()) ? removeQuotes(cells[i]) : "";
-                data[header_name].push_back(cell_value);
+                data[headers[i]].push_back(cell_value);
             }
         }
         
-        file.close();
         return data;
     }
 
@@ -109,23 +119,20 @@ namespace utils {
         char delimiter) {
         
         std::vector<std::string> column_names;
-        std::ifstream file(filename);
+        CsvRecordIterator records(filename, delimiter);
         
-        if (!file.is_open()) {
+        if (!records.isOpen()) {
             std::cerr << "Erro ao abrir o arquivo CSV: " << filename << std::endl;
             return column_names;
         }
 
-        std::string line;
-        if (std::getline(file, line)) {
-            line = removeBOM(line); // Remove BOM UTF-8 se presente
-            std::vector<std::string> headers = parseLine(line, delimiter);
+        std::vector<std::string> headers;
+        if (records.next(headers)) {
             for (const auto& header : headers) {
                 column_names.push_back(removeQuotes(header));
             }
         }
         
-        file.close();
         return column_names;
     }
 
@@ -145,40 +152,15 @@ namespace utils {
     }
 
     std::vector<std::string> CsvReader::parseLine(const std::string& line, char delimiter) {
+        // Mesmo parser dos arquivos: aspas são removidas e "" vira uma aspa literal
+        std::istringstream stream(line);
+        CsvRecordIterator records(stream, delimiter);
         std::vector<std::string> cells;
-        std::string current_cell;
-        bool in_quotes = false;
-        
-        for (size_t i = 0; i < line.length(); ++i) {
-            char c = line[i];
-            
-            if (c == '"') {
-                in_quotes = !in_quotes;
-                // Não adiciona as aspas ao conteúdo da célula
-            } else if (c == delimiter && !in_quotes) {
-                cells.push_back(current_cell);
-                current_cell.clear();
-            } else {
-                current_cell += c;
-            }
+        if (!records.next(cells)) {
+            cells.assign(1, std::string()); // Linha vazia tem uma célula vazia
         }
-        
-        // Adiciona a última célula
-        cells.push_back(current_cell);
-        
         return cells;
     }
 
-    std::string CsvReader::removeBOM(const std::string& str) {
-        // BOM UTF-8 são os bytes: 0xEF 0xBB 0xBF
-        if (str.size() >= 3 && 
-            static_cast<unsigned char>(str[0]) == 0xEF &&
-            static_cast<unsigned char>(str[1]) == 0xBB &&
-            static_cast<unsigned char>(str[2]) == 0xBF) {
-            return str.substr(3);
-        }
-        return str;
-    }
-
 } // namespace utils
 } // namespace legal_doc_pipeline
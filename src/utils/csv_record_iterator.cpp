@@ -0,0 +1,121 @@
+#include "../../include/utils/csv_record_iterator.h"
+#include <algorithm>
+#include <cstring>
+
+namespace legal_doc_pipeline {
+namespace utils {
+
+    namespace {
+        // O BOM UTF-8 precisa caber no primeiro bloco
+        constexpr size_t MIN_BUFFER_SIZE = 4;
+    }
+
+    CsvRecordIterator::CsvRecordIterator(const std::string& filename, char delimiter, size_t buffer_size)
+        : file(filename, std::ios::binary), input(&file), delimiter(delimiter),
+          buffer(std::max(buffer_size, MIN_BUFFER_SIZE)) {}
+
+    CsvRecordIterator::CsvRecordIterator(std::istream& stream, char delimiter, size_t buffer_size)
+        : input(&stream), delimiter(delimiter), buffer(std::max(buffer_size, MIN_BUFFER_SIZE)) {}
+
+    bool CsvRecordIterator::isOpen() const {
+        return input == &file ? file.is_open() : static_cast<bool>(*input);
+    }
+
+    bool CsvRecordIterator::fill() {
+        position = 0;
+        available = 0;
+        if (!*input) {
+            return false;
+        }
+
+        input->read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        available = static_cast<size_t>(input->gcount());
+
+        if (!started) {
+            started = true;
+            // Remove BOM UTF-8 se presente
+            if (available >= 3 &&
+                static_cast<unsigned char>(buffer[0]) == 0xEF &&
+                static_cast<unsigned char>(buffer[1]) == 0xBB &&
+                static_cast<unsigned char>(buffer[2]) == 0xBF) {
+                position = 3;
+            }
+        }
+        return position < available;
+    }
+
+    bool CsvRecordIterator::next(std::vector<std::string>& fields) {
+        if (position == available && !fill()) {
+            return false;
+        }
+
+        size_t count = 0;
+        auto startField = [&]() -> std::string* {
+            if (fields.size() <= count) {
+                fields.emplace_back();
+            } else {
+                fields[count].clear();
+            }
+            return &fields[count];
+        };
+
+        std::string* field = startField();
+        bool in_quotes = false;
+        unterminated_quote = false;
+
+        while (position < available || fill()) {
+            const char* data = buffer.data();
+
+            // Copia de uma vez o trecho sem aspas, delimitadores ou quebras de linha
+            size_t run = position;
+            if (in_quotes) {
+                const void* quote = std::memchr(data + run, '"', available - run);
+                run = quote ? static_cast<size_t>(static_cast<const char*>(quote) - data) : available;
+            } else {
+                while (run < available && data[run] != '"' && data[run] != delimiter && data[run] != '\n') {
+                    ++run;
+                }
+            }
+            field->append(data + position, run - position);
+            position = run;
+            if (position == available) {
+                continue;
+            }
+
+            char c = data[position++];
+            if (c == '"') {
+                if (!in_quotes) {
+                    in_quotes = true;
+                } else {
+                    if (position == available) {
+                        fill();
+                    }
+                    if (position < available && buffer[position] == '"') {
+                        field->push_back('"');   // "" dentro de aspas é uma aspa literal
+                        ++position;
+                    } else {
+                        in_quotes = false;
+                    }
+                }
+            } else if (c == delimiter) {
+                ++count;
+                field = startField();
+            } else {
+                if (!field->empty() && field->back() == '\r') {
+                    field->pop_back();
+                }
+                fields.resize(count + 1);
+                ++records_read;
+                return true;
+            }
+        }
+
+        // Fim da entrada sem quebra de linha final
+        unterminated_quote = in_quotes;
+        fields.resize(count + 1);
+        ++records_read;
+        return true;
+    }
+
+} // namespace utils
+} // namespace legal_doc_pipeline
@@ -0,0 +1,80 @@
+#include "../../include/utils/latency_histogram.h"
+#include <algorithm>
+#include <cmath>
+
+namespace legal_doc_pipeline {
+namespace utils {
+
+    size_t LatencyHistogram::bucketIndex(uint64_t value) {
+        if (value < SUB_BUCKETS) {
+            return static_cast<size_t>(value);
+        }
+        unsigned exponent = 63u - static_cast<unsigned>(__builtin_clzll(value));
+        if (exponent > MAX_EXPONENT) {
+            return BUCKET_COUNT - 1;
+        }
+        // Os SUB_BUCKET_BITS bits abaixo do mais significativo escolhem o bucket na potência de dois
+        uint64_t sub_bucket = (value >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+        return static_cast<size_t>((exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + sub_bucket);
+    }
+
+    uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+        if (index < SUB_BUCKETS) {
+            return index;
+        }
+        unsigned shift = static_cast<unsigned>(index / SUB_BUCKETS) - 1;
+        uint64_t lower = (SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+        return lower + (uint64_t(1) << shift) - 1;
+    }
+
+    void LatencyHistogram::record(uint64_t nanoseconds) {
+        ++counts[bucketIndex(nanoseconds)];
+        if (sample_count == 0 || nanoseconds < min_value) min_value = nanoseconds;
+        if (nanoseconds > max_value) max_value = nanoseconds;
+        ++sample_count;
+        total += nanoseconds;
+    }
+
+    void LatencyHistogram::merge(const LatencyHistogram& other) {
+        if (other.sample_count == 0) {
+            return;
+        }
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            counts[i] += other.counts[i];
+        }
+        min_value = sample_count == 0 ? other.min_value : std::min(min_value, other.min_value);
+        max_value = std::max(max_value, other.max_value);
+        sample_count += other.sample_count;
+        total += other.total;
+    }
+
+    void LatencyHistogram::reset() {
+        counts.fill(0);
+        sample_count = 0;
+        total = 0;
+        min_value = 0;
+        max_value = 0;
+    }
+
+    uint64_t LatencyHistogram::percentile(double p) const {
+        if (sample_count == 0) {
+            return 0;
+        }
+        // Posição (1..n) da amostra procurada na ordem crescente
+        double clamped = std::min(100.0, std::max(0.0, p));
+        uint64_t rank = static_cast<uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(sample_count)));
+        rank = std::max<uint64_t>(rank, 1);
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                // O último bucket não tem limite superior: acumula tudo acima de 2^48 ns
+                return i == BUCKET_COUNT - 1 ? max_value : std::min(bucketUpperBound(i), max_value);
+            }
+        }
+        return max_value;
+    }
+
+} // namespace utils
+} // namespace legal_doc_pipeline
@@ -0,0 +1,236 @@
+#include "../../include/utils/logger.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace legal_doc_pipeline {
+namespace utils {
+
+    std::atomic<int> Logger::runtime_level(static_cast<int>(LogLevel::INFO));
+
+    namespace {
+
+        constexpr size_t ENTRY_TEXT_SIZE = 232;     ///< Bytes de texto por entrada
+        constexpr size_t BUFFER_CAPACITY = 512;     ///< Entradas por thread (potência de 2)
+
+        /**
+         * @brief Mensagem já formatada, guardada sem alocação no buffer
+         */
+        struct LogEntry {
+            std::chrono::steady_clock::time_point time;
+            LogLevel level;
+            uint32_t thread_number;
+            uint32_t length;
+            char text[ENTRY_TEXT_SIZE];
+        };
+
+        /**
+         * @brief Buffer circular de uma thread: a thread produz, o flusher consome
+         */
+        class ThreadLogBuffer {
+        private:
+            std::array<LogEntry, BUFFER_CAPACITY> entries;
+            std::atomic<size_t> head{0};   ///< Próxima posição a escrever (só o produtor altera)
+            std::atomic<size_t> tail{0};   ///< Próxima posição a ler (só o consumidor altera)
+
+        public:
+            const uint32_t thread_number;
+
+            explicit ThreadLogBuffer(uint32_t number) : thread_number(number) {}
+
+            /**
+             * @brief Insere uma mensagem
+             * @return false se o buffer está cheio (mensagem descartada)
+             */
+            bool push(LogLevel level, const std::string& message, bool& half_full) {
+                size_t current = head.load(std::memory_order_relaxed);
+                size_t used = current - tail.load(std::memory_order_acquire);
+                if (used >= BUFFER_CAPACITY) {
+                    return false;
+                }
+                LogEntry& entry = entries[current & (BUFFER_CAPACITY - 1)];
+                entry.time = std::chrono::steady_clock::now();
+                entry.level = level;
+                entry.thread_number = thread_number;
+                entry.length = static_cast<uint32_t>(std::min(message.size(), ENTRY_TEXT_SIZE));
+                std::memcpy(entry.text, message.data(), entry.length);
+                head.store(current + 1, std::memory_order_release);
+                half_full = used + 1 == BUFFER_CAPACITY / 2;
+                return true;
+            }
+
+            /**
+             * @brief Move as mensagens pendentes para out
+             */
+            void drain(std::vector<LogEntry>& out) {
+                size_t current = tail.load(std::memory_order_relaxed);
+                size_t last = head.load(std::memory_order_acquire);
+                for (; current != last; ++current) {
+                    out.push_back(entries[current & (BUFFER_CAPACITY - 1)]);
+                }
+                tail.store(current, std::memory_order_release);
+            }
+        };
+
+        /**
+         * @brief Registro dos buffers e thread de escrita em segundo plano
+         */
+        class LoggerBackend {
+        private:
+            std::mutex buffers_mutex;                               ///< Protege buffers e a thread de escrita
+            std::vector<std::shared_ptr<ThreadLogBuffer>> buffers;  ///< Buffers das threads (vivos ou não drenados)
+            std::mutex drain_mutex;                                 ///< Serializa drenagens e a saída
+            std::ostream* sink = nullptr;                           ///< Saída (nullptr = std::cout)
+            std::vector<LogEntry> pending;                          ///< Área de trabalho da drenagem
+            std::thread flusher;                                    ///< Thread de escrita assíncrona
+            std::mutex wake_mutex;
+            std::condition_variable wake;
+            bool stopping = false;
+            uint32_t next_thread_number = 0;                        ///< Número da próxima thread registrada
+            size_t total_dropped = 0;                               ///< Descartes já reportados (protegido por drain_mutex)
+
+            void flusherLoop() {
+                std::unique_lock<std::mutex> lock(wake_mutex);
+                while (!stopping) {
+                    wake.wait_for(lock, std::chrono::milliseconds(10));
+                    lock.unlock();
+                    drainAll();
+                    lock.lock();
+                }
+            }
+
+        public:
+            std::atomic<size_t> dropped{0};
+
+            ~LoggerBackend() {
+                {
+                    std::lock_guard<std::mutex> lock(wake_mutex);
+                    stopping = true;
+                }
+                wake.notify_one();
+                if (flusher.joinable()) {
+                    flusher.join();
+                }
+                drainAll();
+            }
+
+            std::shared_ptr<ThreadLogBuffer> registerThread() {
+                std::lock_guard<std::mutex> lock(buffers_mutex);
+                auto buffer = std::make_shared<ThreadLogBuffer>(next_thread_number++);
+                buffers.push_back(buffer);
+                if (!flusher.joinable()) {
+                    flusher = std::thread(&LoggerBackend::flusherLoop, this);
+                }
+                return buffer;
+            }
+
+            void wakeFlusher() {
+                wake.notify_one();
+            }
+
+            void setSink(std::ostream* new_sink) {
+                drainAll();
+                std::lock_guard<std::mutex> lock(drain_mutex);
+                sink = new_sink;
+            }
+
+            void drainAll() {
+                std::lock_guard<std::mutex> drain_lock(drain_mutex);
+                pending.clear();
+                {
+                    std::lock_guard<std::mutex> lock(buffers_mutex);
+                    for (auto& buffer : buffers) {
+                        buffer->drain(pending);
+                    }
+                    // Buffers de threads encerradas já drenados não são mais necessários
+                    buffers.erase(std::remove_if(buffers.begin(), buffers.end(),
+                                                 [](const auto& buffer) { return buffer.use_count() == 1; }),
+                                  buffers.end());
+                }
+
+                size_t dropped_now = dropped.exchange(0);
+                if (pending.empty() && dropped_now == 0) {
+                    return;
+                }
+
+                std::stable_sort(pending.begin(), pending.end(),
+                                 [](const LogEntry& a, const LogEntry& b) { return a.time < b.time; });
+                std::ostream& out = sink ? *sink : std::cout;
+                for (const LogEntry& entry : pending) {
+                    out << '[' << Logger::levelName(entry.level) << " t" << entry.thread_number << "] ";
+                    out.write(entry.text, entry.length);
+                    out << '\n';
+                }
+                if (dropped_now > 0) {
+                    out << "[WARNING] " << dropped_now << " mensagens de log descartadas (buffer cheio)\n";
+                }
+                out.flush();
+                total_dropped += dropped_now;
+            }
+
+            size_t droppedMessages() {
+                std::lock_guard<std::mutex> lock(drain_mutex);
+                return total_dropped + dropped.load();
+            }
+        };
+
+        LoggerBackend& backend() {
+            static LoggerBackend instance;
+            return instance;
+        }
+
+    } // namespace
+
+    void Logger::setLevel(LogLevel level) {
+        runtime_level.store(static_cast<int>(level), std::memory_order_relaxed);
+    }
+
+    LogLevel Logger::getLevel() {
+        return static_cast<LogLevel>(runtime_level.load(std::memory_order_relaxed));
+    }
+
+    void Logger::write(LogLevel level, const std::string& message) {
+        thread_local std::shared_ptr<ThreadLogBuffer> buffer = backend().registerThread();
+        bool half_full = false;
+        if (!buffer->push(level, message, half_full)) {
+            backend().dropped++;
+            backend().wakeFlusher();
+        } else if (half_full) {
+            backend().wakeFlusher();
+        }
+    }
+
+    void Logger::flush() {
+        backend().drainAll();
+    }
+
+    void Logger::setSink(std::ostream* sink) {
+        backend().setSink(sink);
+    }
+
+    size_t Logger::droppedMessages() {
+        return backend().droppedMessages();
+    }
+
+    const char* Logger::levelName(LogLevel level) {
+        switch (level) {
+            case LogLevel::TRACE: return "TRACE";
+            case LogLevel::VERBOSE: return "VERBOSE";
+            case LogLevel::INFO: return "INFO";
+            case LogLevel::WARNING: return "WARNING";
+            case LogLevel::ERROR: return "ERROR";
+            case LogLevel::OFF: return "OFF";
+        }
+        return "?";
+    }
+
+} // namespace utils
+} // namespace legal_doc_pipeline
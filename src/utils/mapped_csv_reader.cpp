@@ -0,0 +1,358 @@
+#include "../../include/utils/mapped_csv_reader.h"
+#include <algorithm>
+#include <iostream>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace legal_doc_pipeline {
+namespace utils {
+
+    namespace {
+
+        /**
+         * @brief Valor de um campo ainda não resolvido para string_view
+         *
+         * Durante o parse o buffer do bloco pode crescer e invalidar ponteiros,
+         * então o valor guarda apenas a posição (no arquivo ou no buffer).
+         */
+        struct PendingValue {
+            size_t offset = 0;
+            size_t length = 0;
+            bool owned = false;   ///< true se está no buffer do bloco
+        };
+
+        const char* const TRIM_CHARS = " \t\r\n";
+
+        inline bool isTrimChar(char c) {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+        }
+
+        /**
+         * @brief Apara [begin, end) de text com os mesmos caracteres do CsvReader
+         */
+        inline void trimRange(std::string_view text, size_t& begin, size_t& end) {
+            while (begin < end && isTrimChar(text[begin])) ++begin;
+            while (end > begin && isTrimChar(text[end - 1])) --end;
+        }
+
+        /**
+         * @brief Converte o campo bruto [begin, end) em valor sem aspas e aparado
+         *
+         * Campos sem aspas e campos inteiramente entre um único par de aspas
+         * viram intervalos do próprio arquivo; os demais são copiados para o
+         * buffer, descartando as aspas de abertura/fechamento e trocando ""
+         * dentro de aspas por uma aspa literal.
+         */
+        PendingValue extractField(std::string_view text, size_t begin, size_t end,
+                                  size_t quote_toggles, bool has_escape, std::string& buffer) {
+            PendingValue value;
+            trimRange(text, begin, end);
+
+            if (quote_toggles == 0 && !has_escape) {
+                value.offset = begin;
+                value.length = end - begin;
+                return value;
+            }
+            if (quote_toggles == 2 && !has_escape && end - begin >= 2 &&
+                text[begin] == '"' && text[end - 1] == '"') {
+                size_t inner_begin = begin + 1;
+                size_t inner_end = end - 1;
+                trimRange(text, inner_begin, inner_end);
+                value.offset = inner_begin;
+                value.length = inner_end - inner_begin;
+                return value;
+            }
+
+            size_t start = buffer.size();
+            bool in_quotes = false;
+            for (size_t i = begin; i < end; ++i) {
+                char c = text[i];
+                if (c == '"') {
+                    if (in_quotes && i + 1 < end && text[i + 1] == '"') {
+                        buffer.push_back('"');
+                        ++i;
+                    } else {
+                        in_quotes = !in_quotes;
+                    }
+                } else {
+                    buffer.push_back(c);
+                }
+            }
+
+            size_t first = buffer.find_first_not_of(TRIM_CHARS, start);
+            if (first == std::string::npos) {
+                buffer.resize(start);
+                value.offset = start;
+                value.owned = true;
+                return value;
+            }
+            size_t last = buffer.find_last_not_of(TRIM_CHARS);
+            buffer.resize(last + 1);
+            value.offset = first;
+            value.length = last + 1 - first;
+            value.owned = true;
+            return value;
+        }
+
+        /**
+         * @brief Percorre um registro a partir de pos chamando on_field para cada campo
+         * @return Posição logo após o registro ('\n' fora de aspas ou fim do texto)
+         */
+        template <typename OnField>
+        size_t scanRecord(std::string_view text, size_t pos, char delimiter, OnField on_field) {
+            const size_t size = text.size();
+            size_t field_index = 0;
+            size_t field_begin = pos;
+            size_t quote_toggles = 0;
+            bool has_escape = false;
+            bool in_quotes = false;
+
+            for (size_t i = pos; i < size; ++i) {
+                char c = text[i];
+                if (c == '"') {
+                    if (in_quotes && i + 1 < size && text[i + 1] == '"') {
+                        has_escape = true;
+                        ++i;
+                    } else {
+                        in_quotes = !in_quotes;
+                        ++quote_toggles;
+                    }
+                } else if (in_quotes) {
+                    continue;
+                } else if (c == delimiter) {
+                    on_field(field_index++, field_begin, i, quote_toggles, has_escape);
+                    field_begin = i + 1;
+                    quote_toggles = 0;
+                    has_escape = false;
+                } else if (c == '\n') {
+                    on_field(field_index, field_begin, i, quote_toggles, has_escape);
+                    return i + 1;
+                }
+            }
+
+            on_field(field_index, field_begin, size, quote_toggles, has_escape);
+            return size;
+        }
+
+        /**
+         * @brief Executa fn(chunk) para cada bloco, um bloco por thread
+         */
+        template <typename Fn>
+        void forEachChunk(size_t chunks, Fn fn) {
+            if (chunks == 1) {
+                fn(0);
+                return;
+            }
+            std::vector<std::thread> threads;
+            threads.reserve(chunks);
+            for (size_t chunk = 0; chunk < chunks; ++chunk) {
+                threads.emplace_back(fn, chunk);
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        }
+
+    } // namespace
+
+    MappedFile::~MappedFile() {
+        close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : data(other.data), length(other.length) {
+        other.data = nullptr;
+        other.length = 0;
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            data = other.data;
+            length = other.length;
+            other.data = nullptr;
+            other.length = 0;
+        }
+        return *this;
+    }
+
+    bool MappedFile::open(const std::string& filename) {
+        close();
+
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            return false;
+        }
+
+        if (info.st_size > 0) {
+            void* mapping = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                ::close(fd);
+                return false;
+            }
+            // Os blocos são lidos em paralelo: pede a leitura antecipada do arquivo todo
+            ::madvise(mapping, static_cast<size_t>(info.st_size), MADV_WILLNEED);
+            data = static_cast<const char*>(mapping);
+            length = static_cast<size_t>(info.st_size);
+        }
+
+        // O mapeamento continua válido após fechar o descritor
+        ::close(fd);
+        return true;
+    }
+
+    void MappedFile::close() {
+        if (data != nullptr) {
+            ::munmap(const_cast<char*>(data), length);
+        }
+        data = nullptr;
+        length = 0;
+    }
+
+    std::vector<std::string> CsvColumnView::toStrings() const {
+        std::vector<std::string> result;
+        result.reserve(values.size());
+        for (std::string_view value : values) {
+            result.emplace_back(value);
+        }
+        return result;
+    }
+
+    MappedCsvReader::MappedCsvReader(size_t num_threads, size_t min_chunk_bytes)
+        : num_threads(num_threads), min_chunk_bytes(std::max<size_t>(1, min_chunk_bytes)) {}
+
+    size_t MappedCsvReader::chunkCount(size_t bytes) const {
+        size_t threads = num_threads > 0 ? num_threads
+                                         : std::max(1u, std::thread::hardware_concurrency());
+        size_t by_size = std::max<size_t>(1, bytes / min_chunk_bytes);
+        return std::max<size_t>(1, std::min(threads, by_size));
+    }
+
+    CsvColumnView MappedCsvReader::readColumn(const std::string& filename,
+                                              const std::string& column_name,
+                                              char delimiter) const {
+        CsvColumnView column;
+
+        if (!column.file.open(filename)) {
+            std::cerr << "Erro ao abrir o arquivo CSV: " << filename << std::endl;
+            return column;
+        }
+
+        std::string_view text = column.file.view();
+        size_t header_begin = 0;
+        if (text.size() >= 3 &&
+            static_cast<unsigned char>(text[0]) == 0xEF &&
+            static_cast<unsigned char>(text[1]) == 0xBB &&
+            static_cast<unsigned char>(text[2]) == 0xBF) {
+            header_begin = 3;   // Remove BOM UTF-8
+        }
+        if (header_begin >= text.size()) {
+            std::cerr << "Erro ao ler o cabeçalho do arquivo CSV" << std::endl;
+            return column;
+        }
+
+        // Parse do cabeçalho
+        size_t column_index = static_cast<size_t>(-1);
+        std::string header_buffer;
+        size_t body_begin = scanRecord(text, header_begin, delimiter,
+            [&](size_t index, size_t begin, size_t end, size_t toggles, bool escaped) {
+                if (column_index != static_cast<size_t>(-1)) return;
+                header_buffer.clear();
+                PendingValue name = extractField(text, begin, end, toggles, escaped, header_buffer);
+                std::string_view name_view = name.owned
+                    ? std::string_view(header_buffer).substr(name.offset, name.length)
+                    : text.substr(name.offset, name.length);
+                if (name_view == column_name) {
+                    column_index = index;
+                }
+            });
+
+        if (column_index == static_cast<size_t>(-1)) {
+            std::cerr << "Coluna '" << column_name << "' não encontrada no CSV." << std::endl;
+            return column;
+        }
+
+        const size_t chunks = chunkCount(text.size() - body_begin);
+        std::vector<size_t> bounds(chunks + 1);
+        for (size_t chunk = 0; chunk <= chunks; ++chunk) {
+            bounds[chunk] = body_begin + (text.size() - body_begin) * chunk / chunks;
+        }
+
+        // Passada 1: paridade das aspas de cada bloco
+        std::vector<char> odd_quotes(chunks, 0);
+        forEachChunk(chunks, [&](size_t chunk) {
+            size_t quotes = std::count(text.data() + bounds[chunk], text.data() + bounds[chunk + 1], '"');
+            odd_quotes[chunk] = static_cast<char>(quotes & 1);
+        });
+
+        std::vector<char> starts_in_quotes(chunks, 0);
+        for (size_t chunk = 1; chunk < chunks; ++chunk) {
+            starts_in_quotes[chunk] = static_cast<char>(starts_in_quotes[chunk - 1] ^ odd_quotes[chunk - 1]);
+        }
+
+        // Passada 2: cada bloco parseia os registros que começam dentro dele
+        std::vector<std::vector<PendingValue>> pending(chunks);
+        column.buffers.resize(chunks);
+        forEachChunk(chunks, [&](size_t chunk) {
+            const size_t chunk_begin = bounds[chunk];
+            const size_t chunk_end = bounds[chunk + 1];
+            size_t pos = chunk_end;
+
+            if (chunk == 0) {
+                pos = chunk_begin;
+            } else if (!starts_in_quotes[chunk] && text[chunk_begin - 1] == '\n') {
+                pos = chunk_begin;
+            } else {
+                bool in_quotes = starts_in_quotes[chunk];
+                for (size_t i = chunk_begin; i < chunk_end; ++i) {
+                    if (text[i] == '"') {
+                        in_quotes = !in_quotes;
+                    } else if (text[i] == '\n' && !in_quotes) {
+                        pos = i + 1;
+                        break;
+                    }
+                }
+            }
+
+            std::vector<PendingValue>& values = pending[chunk];
+            std::string& buffer = column.buffers[chunk];
+            while (pos < chunk_end) {
+                PendingValue value;
+                pos = scanRecord(text, pos, delimiter,
+                    [&](size_t index, size_t begin, size_t end, size_t toggles, bool escaped) {
+                        if (index == column_index) {
+                            value = extractField(text, begin, end, toggles, escaped, buffer);
+                        }
+                    });
+                values.push_back(value);   // Célula vazia se o registro tem menos colunas
+            }
+        });
+
+        // Os buffers não mudam mais de endereço: resolve os valores para views
+        size_t total = 0;
+        for (const auto& values : pending) {
+            total += values.size();
+        }
+        column.values.reserve(total);
+        for (size_t chunk = 0; chunk < chunks; ++chunk) {
+            std::string_view buffer = column.buffers[chunk];
+            for (const PendingValue& value : pending[chunk]) {
+                column.values.push_back(value.owned ? buffer.substr(value.offset, value.length)
+                                                    : text.substr(value.offset, value.length));
+            }
+        }
+
+        return column;
+    }
+
+} // namespace utils
+} // namespace legal_doc_pipeline
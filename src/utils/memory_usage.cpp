@@ -0,0 +1,52 @@
+#include "../../include/utils/memory_usage.h"
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace legal_doc_pipeline {
+namespace utils {
+
+    namespace {
+
+        /**
+         * @brief Lê um campo em kB de /proc/self/status
+         * @param field Nome do campo, com os dois-pontos (ex.: "VmRSS:")
+         * @return Valor em bytes, ou 0 se o campo não existe
+         */
+        size_t readStatusField(const std::string& field) {
+            std::ifstream status("/proc/self/status");
+            std::string line;
+            while (std::getline(status, line)) {
+                if (line.compare(0, field.size(), field) == 0) {
+                    std::istringstream values(line.substr(field.size()));
+                    size_t kilobytes = 0;
+                    values >> kilobytes;
+                    return kilobytes * 1024;
+                }
+            }
+            return 0;
+        }
+
+    } // namespace
+
+    size_t MemoryUsage::currentResidentBytes() {
+        return readStatusField("VmRSS:");
+    }
+
+    size_t MemoryUsage::peakResidentBytes() {
+        return readStatusField("VmHWM:");
+    }
+
+    bool MemoryUsage::resetPeak() {
+        std::ofstream clear_refs("/proc/self/clear_refs");
+        if (!clear_refs) {
+            return false;
+        }
+        // "5" reinicia apenas o pico de memória residente
+        clear_refs << "5";
+        clear_refs.flush();
+        return static_cast<bool>(clear_refs);
+    }
+
+} // namespace utils
+} // namespace legal_doc_pipeline
@@ -0,0 +1,233 @@
+#include "../../include/utils/simd_text.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LEGAL_DOC_PIPELINE_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace legal_doc_pipeline {
+namespace utils {
+
+    namespace {
+
+        constexpr unsigned char UTF8_LATIN1_LEAD = 0xC3;   ///< Byte inicial de À-ÿ em UTF-8
+        constexpr unsigned char UTF8_MULTIPLY_SIGN = 0x97; ///< Continuação de '×' (sem minúscula)
+
+        /**
+         * @brief Versão escalar da conversão para [begin, end)
+         *
+         * Usa data[i - 1] para reconhecer a sequência C3 xx; o byte 0xC3 nunca é
+         * alterado, então o resultado não depende da ordem de processamento.
+         */
+        void toLowerScalar(char* data, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                unsigned char c = static_cast<unsigned char>(data[i]);
+                if (c >= 'A' && c <= 'Z') {
+                    data[i] = static_cast<char>(c + 0x20);
+                } else if (c >= 0x80 && c <= 0x9E && c != UTF8_MULTIPLY_SIGN && i > 0 &&
+                           static_cast<unsigned char>(data[i - 1]) == UTF8_LATIN1_LEAD) {
+                    data[i] = static_cast<char>(c + 0x20);
+                }
+            }
+        }
+
+        size_t wordRunLengthScalar(const char* data, size_t begin, size_t size) {
+            size_t i = begin;
+            while (i < size && SimdText::isWordByte(static_cast<unsigned char>(data[i]))) {
+                ++i;
+            }
+            return i;
+        }
+
+#ifdef LEGAL_DOC_PIPELINE_X86_SIMD
+        // Comparações sem sinal via comparação com sinal: x está em [lo, lo + n)
+        // se (x - lo - 128) < (n - 128) como inteiros de 8 bits com sinal.
+        // Os kernels de minúsculas retornam até onde processaram (0 se nada).
+
+        size_t toLowerSse2(char* data, size_t size) {
+            const __m128i upper_bias = _mm_set1_epi8(static_cast<char>(-128 - 'A'));
+            const __m128i upper_limit = _mm_set1_epi8(static_cast<char>(-128 + 26));
+            const __m128i cont_limit = _mm_set1_epi8(static_cast<char>(-128 + 0x1F));  // 0x80..0x9E
+            const __m128i multiply_sign = _mm_set1_epi8(static_cast<char>(UTF8_MULTIPLY_SIGN));
+            const __m128i lead = _mm_set1_epi8(static_cast<char>(UTF8_LATIN1_LEAD));
+            const __m128i case_bit = _mm_set1_epi8(0x20);
+
+            if (size <= 16) {
+                return 0;
+            }
+
+            // Começa em 1 para poder carregar o byte anterior de cada posição
+            size_t i = 1;
+            for (; i + 16 <= size; i += 16) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                __m128i prev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i - 1));
+
+                __m128i is_upper = _mm_cmplt_epi8(_mm_add_epi8(v, upper_bias), upper_limit);
+                __m128i is_latin = _mm_andnot_si128(
+                    _mm_cmpeq_epi8(v, multiply_sign),
+                    _mm_and_si128(_mm_cmplt_epi8(v, cont_limit), _mm_cmpeq_epi8(prev, lead)));
+
+                __m128i delta = _mm_and_si128(_mm_or_si128(is_upper, is_latin), case_bit);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), _mm_add_epi8(v, delta));
+            }
+            return i;
+        }
+
+        __attribute__((target("avx2")))
+        size_t toLowerAvx2(char* data, size_t size) {
+            const __m256i upper_bias = _mm256_set1_epi8(static_cast<char>(-128 - 'A'));
+            const __m256i upper_limit = _mm256_set1_epi8(static_cast<char>(-128 + 26));
+            const __m256i cont_limit = _mm256_set1_epi8(static_cast<char>(-128 + 0x1F));
+            const __m256i multiply_sign = _mm256_set1_epi8(static_cast<char>(UTF8_MULTIPLY_SIGN));
+            const __m256i lead = _mm256_set1_epi8(static_cast<char>(UTF8_LATIN1_LEAD));
+            const __m256i case_bit = _mm256_set1_epi8(0x20);
+
+            if (size <= 32) {
+                return 0;
+            }
+
+            size_t i = 1;
+            for (; i + 32 <= size; i += 32) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                __m256i prev = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i - 1));
+
+                __m256i is_upper = _mm256_cmpgt_epi8(upper_limit, _mm256_add_epi8(v, upper_bias));
+                __m256i is_latin = _mm256_andnot_si256(
+                    _mm256_cmpeq_epi8(v, multiply_sign),
+                    _mm256_and_si256(_mm256_cmpgt_epi8(cont_limit, v), _mm256_cmpeq_epi8(prev, lead)));
+
+                __m256i delta = _mm256_and_si256(_mm256_or_si256(is_upper, is_latin), case_bit);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i), _mm256_add_epi8(v, delta));
+            }
+            return i;
+        }
+
+        /**
+         * @brief Máscara de bytes de palavra em 16 bytes (bit i = byte i)
+         */
+        inline unsigned wordMaskSse2(__m128i v) {
+            const __m128i letter_bias = _mm_set1_epi8(static_cast<char>(-128 - 'a'));
+            const __m128i letter_limit = _mm_set1_epi8(static_cast<char>(-128 + 26));
+            const __m128i digit_bias = _mm_set1_epi8(static_cast<char>(-128 - '0'));
+            const __m128i digit_limit = _mm_set1_epi8(static_cast<char>(-128 + 10));
+            const __m128i high_limit = _mm_set1_epi8(static_cast<char>(0xC4));  // 0x80..0xC3
+
+            __m128i folded = _mm_or_si128(v, _mm_set1_epi8(0x20));
+            __m128i is_letter = _mm_cmplt_epi8(_mm_add_epi8(folded, letter_bias), letter_limit);
+            __m128i is_digit = _mm_cmplt_epi8(_mm_add_epi8(v, digit_bias), digit_limit);
+            __m128i is_high = _mm_cmplt_epi8(v, high_limit);
+            return static_cast<unsigned>(_mm_movemask_epi8(
+                _mm_or_si128(is_letter, _mm_or_si128(is_digit, is_high))));
+        }
+
+        size_t wordRunLengthSse2(const char* data, size_t size) {
+            size_t i = 0;
+            for (; i + 16 <= size; i += 16) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                unsigned mask = wordMaskSse2(v);
+                if (mask != 0xFFFFu) {
+                    return i + static_cast<size_t>(__builtin_ctz(~mask));
+                }
+            }
+            return wordRunLengthScalar(data, i, size);
+        }
+
+        __attribute__((target("avx2")))
+        size_t wordRunLengthAvx2(const char* data, size_t size) {
+            const __m256i letter_bias = _mm256_set1_epi8(static_cast<char>(-128 - 'a'));
+            const __m256i letter_limit = _mm256_set1_epi8(static_cast<char>(-128 + 26));
+            const __m256i digit_bias = _mm256_set1_epi8(static_cast<char>(-128 - '0'));
+            const __m256i digit_limit = _mm256_set1_epi8(static_cast<char>(-128 + 10));
+            const __m256i high_limit = _mm256_set1_epi8(static_cast<char>(0xC4));
+            const __m256i case_bit = _mm256_set1_epi8(0x20);
+
+            size_t i = 0;
+            for (; i + 32 <= size; i += 32) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                __m256i folded = _mm256_or_si256(v, case_bit);
+                __m256i is_letter = _mm256_cmpgt_epi8(letter_limit, _mm256_add_epi8(folded, letter_bias));
+                __m256i is_digit = _mm256_cmpgt_epi8(digit_limit, _mm256_add_epi8(v, digit_bias));
+                __m256i is_high = _mm256_cmpgt_epi8(high_limit, v);
+                unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+                    _mm256_or_si256(is_letter, _mm256_or_si256(is_digit, is_high))));
+                if (mask != 0xFFFFFFFFu) {
+                    return i + static_cast<size_t>(__builtin_ctz(~mask));
+                }
+            }
+            return wordRunLengthScalar(data, i, size);
+        }
+#endif
+
+        /**
+         * @brief Limita o nível pedido ao suportado pela CPU
+         */
+        SimdLevel clampLevel(SimdLevel requested) {
+            SimdLevel available = SimdText::detectLevel();
+            return static_cast<int>(requested) < static_cast<int>(available) ? requested : available;
+        }
+
+    } // namespace
+
+    SimdLevel SimdText::detectLevel() {
+#ifdef LEGAL_DOC_PIPELINE_X86_SIMD
+        static const SimdLevel level = [] {
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+            if (__builtin_cpu_supports("sse2")) return SimdLevel::SSE2;
+            return SimdLevel::SCALAR;
+        }();
+        return level;
+#else
+        return SimdLevel::SCALAR;
+#endif
+    }
+
+    const char* SimdText::levelName(SimdLevel level) {
+        switch (level) {
+            case SimdLevel::AVX2: return "avx2";
+            case SimdLevel::SSE2: return "sse2";
+            default: return "scalar";
+        }
+    }
+
+    void SimdText::toLowerInPlace(char* data, size_t size, SimdLevel level) {
+        size_t done = 0;
+#ifdef LEGAL_DOC_PIPELINE_X86_SIMD
+        switch (clampLevel(level)) {
+            case SimdLevel::AVX2: done = toLowerAvx2(data, size); break;
+            case SimdLevel::SSE2: done = toLowerSse2(data, size); break;
+            default: break;
+        }
+        // O primeiro byte nunca passa pelos kernels (não tem byte anterior)
+        if (done > 0) {
+            toLowerScalar(data, 0, 1);
+        }
+#else
+        (void)level;
+#endif
+        toLowerScalar(data, done, size);
+    }
+
+    void SimdText::toLowerInPlace(std::string& text) {
+        toLowerInPlace(&text[0], text.size(), detectLevel());
+    }
+
+    size_t SimdText::wordRunLength(const char* data, size_t size, SimdLevel level) {
+#ifdef LEGAL_DOC_PIPELINE_X86_SIMD
+        switch (clampLevel(level)) {
+            case SimdLevel::AVX2: return wordRunLengthAvx2(data, size);
+            case SimdLevel::SSE2: return wordRunLengthSse2(data, size);
+            default: break;
+        }
+#else
+        (void)level;
+#endif
+        return wordRunLengthScalar(data, 0, size);
+    }
+
+    size_t SimdText::wordRunLength(const char* data, size_t size) {
+        return wordRunLength(data, size, detectLevel());
+    }
+
+} // namespace utils
+} // namespace legal_doc_pipeline
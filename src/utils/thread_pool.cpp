@@ -0,0 +1,172 @@
+#include "../../include/utils/thread_pool.h"
+#include <algorithm>
+#include <exception>
+#include <memory>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#endif
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace legal_doc_pipeline {
+namespace utils {
+
+    namespace {
+
+        /**
+         * @brief Pausa curta dentro do laço de espera ativa
+         */
+        inline void cpuRelax() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+            _mm_pause();
+#else
+            std::this_thread::yield();
+#endif
+        }
+
+        /**
+         * @brief Fixa a thread atual em uma das CPUs permitidas ao processo
+         * @param index Índice da thread; escolhe a CPU permitida de posição index % quantidade
+         * @return true se a afinidade foi aplicada
+         */
+        bool pinCurrentThread(size_t index) {
+#ifdef __linux__
+            cpu_set_t allowed;
+            CPU_ZERO(&allowed);
+            if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0 || CPU_COUNT(&allowed) == 0) {
+                return false;
+            }
+            size_t target = index % static_cast<size_t>(CPU_COUNT(&allowed));
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &allowed) && target-- == 0) {
+                    cpu_set_t set;
+                    CPU_ZERO(&set);
+                    CPU_SET(cpu, &set);
+                    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+                }
+            }
+            return false;
+#else
+            (void)index;
+            return false;
+#endif
+        }
+
+        /**
+         * @brief Estado compartilhado de um lote de runBatch
+         */
+        struct BatchState {
+            std::mutex mutex;
+            std::condition_variable done;
+            size_t remaining = 0;
+            std::exception_ptr error;
+        };
+
+    } // namespace
+
+    ThreadPool::ThreadPool(const ThreadPoolOptions& pool_options)
+        : options(pool_options), queued_jobs(0), parked_threads(0), pinned_threads(0), stopping(false) {
+        if (options.num_threads == 0) {
+            options.num_threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        threads.reserve(options.num_threads);
+        for (size_t i = 0; i < options.num_threads; ++i) {
+            threads.emplace_back(&ThreadPool::workerLoop, this, i);
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(jobs_mutex);
+            stopping = true;
+        }
+        jobs_available.notify_all();
+        for (auto& thread : threads) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+    }
+
+    void ThreadPool::workerLoop(size_t index) {
+        if (options.pin_threads && pinCurrentThread(index)) {
+            pinned_threads++;
+        }
+
+        while (true) {
+            // Espera ativa: um trabalho que chega agora é pego sem passar pela variável de condição
+            for (size_t spin = 0; spin < options.spin_iterations && queued_jobs.load() == 0; ++spin) {
+                cpuRelax();
+            }
+
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(jobs_mutex);
+                if (jobs.empty() && !stopping) {
+                    parked_threads++;
+                    jobs_available.wait(lock, [this] { return stopping || !jobs.empty(); });
+                    parked_threads--;
+                }
+                if (jobs.empty()) {
+                    return;  // stopping e nada mais a executar
+                }
+                job = std::move(jobs.front());
+                jobs.pop_front();
+                queued_jobs--;
+            }
+            job();
+        }
+    }
+
+    void ThreadPool::runBatch(size_t count, const std::function<void(size_t)>& job) {
+        if (count == 0) {
+            return;
+        }
+
+        auto state = std::make_shared<BatchState>();
+        state->remaining = count;
+
+        size_t to_wake = 0;
+        {
+            std::lock_guard<std::mutex> lock(jobs_mutex);
+            for (size_t i = 0; i < count; ++i) {
+                jobs.emplace_back([state, &job, i]() {
+                    try {
+                        job(i);
+                    } catch (...) {
+                        std::lock_guard<std::mutex> state_lock(state->mutex);
+                        if (!state->error) {
+                            state->error = std::current_exception();
+                        }
+                    }
+                    std::lock_guard<std::mutex> state_lock(state->mutex);
+                    if (--state->remaining == 0) {
+                        state->done.notify_all();
+                    }
+                });
+            }
+            queued_jobs += count;
+            // Threads girando não precisam de notificação; só as que dormem
+            to_wake = std::min(count, parked_threads);
+        }
+        if (to_wake == options.num_threads) {
+            jobs_available.notify_all();
+        } else {
+            for (size_t i = 0; i < to_wake; ++i) {
+                jobs_available.notify_one();
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->done.wait(lock, [&state] { return state->remaining == 0; });
+        if (state->error) {
+            std::rethrow_exception(state->error);
+        }
+    }
+
+} // namespace utils
+} // namespace legal_doc_pipeline
@@ -0,0 +1,175 @@
+#include "../../include/utils/trace_recorder.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace legal_doc_pipeline {
+namespace utils {
+
+    namespace {
+
+        std::atomic<uint64_t> next_recorder_id(1);   ///< IDs nunca reutilizados, mesmo com endereços reaproveitados
+
+        /**
+         * @brief Último buffer usado pela thread (cache de uma entrada)
+         */
+        struct ThreadBufferCache {
+            uint64_t recorder_id = 0;
+            void* buffer = nullptr;
+        };
+
+        thread_local ThreadBufferCache thread_cache;
+
+        /// Buffers da thread em todos os gravadores que ela já usou (ID do gravador -> buffer)
+        thread_local std::vector<std::pair<uint64_t, void*>> known_buffers;
+
+        /**
+         * @brief Acrescenta texto como string JSON (com aspas e escapes)
+         */
+        void appendJsonString(std::string& out, const char* text) {
+            out += '"';
+            for (const char* c = text; *c != '\0'; ++c) {
+                unsigned char byte = static_cast<unsigned char>(*c);
+                if (byte == '"' || byte == '\\') {
+                    out += '\\';
+                    out += static_cast<char>(byte);
+                } else if (byte < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", byte);
+                    out += escaped;
+                } else {
+                    out += static_cast<char>(byte);
+                }
+            }
+            out += '"';
+        }
+
+    } // namespace
+
+    TraceRecorder::TraceRecorder(size_t max_events_per_thread)
+        : recorder_id(next_recorder_id++), max_events_per_thread(max_events_per_thread),
+          origin(std::chrono::steady_clock::now()) {}
+
+    TraceRecorder::ThreadBuffer& TraceRecorder::threadBuffer() {
+        if (thread_cache.recorder_id == recorder_id) {
+            return *static_cast<ThreadBuffer*>(thread_cache.buffer);
+        }
+
+        // Primeiro evento desta thread neste gravador, ou a thread alternou entre gravadores
+        std::lock_guard<std::mutex> lock(buffers_mutex);
+        ThreadBuffer* buffer = nullptr;
+        for (const auto& known : known_buffers) {
+            if (known.first == recorder_id) {
+                buffer = static_cast<ThreadBuffer*>(known.second);
+            }
+        }
+        if (buffer == nullptr) {
+            buffers.push_back(std::make_unique<ThreadBuffer>());
+            buffer = buffers.back().get();
+            buffer->thread_number = static_cast<uint32_t>(buffers.size() - 1);
+            buffer->events.reserve(std::min<size_t>(max_events_per_thread, 4096));
+            known_buffers.emplace_back(recorder_id, buffer);
+        }
+        thread_cache.recorder_id = recorder_id;
+        thread_cache.buffer = buffer;
+        return *buffer;
+    }
+
+    void TraceRecorder::record(const char* category, std::string_view name, int64_t begin_ns, int64_t end_ns,
+                               uint64_t range_begin, uint64_t range_end) {
+        ThreadBuffer& buffer = threadBuffer();
+        if (buffer.events.size() >= max_events_per_thread) {
+            ++buffer.dropped;
+            return;
+        }
+
+        buffer.events.emplace_back();
+        TraceEvent& event = buffer.events.back();
+        size_t length = std::min(name.size(), TraceEvent::NAME_CAPACITY);
+        std::memcpy(event.name, name.data(), length);
+        event.name[length] = '\0';
+        event.category = category;
+        event.begin_ns = begin_ns;
+        event.end_ns = end_ns;
+        event.range_begin = range_begin;
+        event.range_end = range_end;
+    }
+
+    size_t TraceRecorder::eventCount() const {
+        std::lock_guard<std::mutex> lock(buffers_mutex);
+        size_t count = 0;
+        for (const auto& buffer : buffers) {
+            count += buffer->events.size();
+        }
+        return count;
+    }
+
+    size_t TraceRecorder::droppedEvents() const {
+        std::lock_guard<std::mutex> lock(buffers_mutex);
+        size_t dropped = 0;
+        for (const auto& buffer : buffers) {
+            dropped += buffer->dropped;
+        }
+        return dropped;
+    }
+
+    void TraceRecorder::clear() {
+        // Os buffers continuam registrados: as threads seguem gravando neles
+        std::lock_guard<std::mutex> lock(buffers_mutex);
+        for (auto& buffer : buffers) {
+            buffer->events.clear();
+            buffer->dropped = 0;
+        }
+    }
+
+    std::string TraceRecorder::toChromeTraceJson() const {
+        std::lock_guard<std::mutex> lock(buffers_mutex);
+        size_t event_count = 0;
+        for (const auto& buffer : buffers) {
+            event_count += buffer->events.size();
+        }
+        std::string out;
+        out.reserve(256 + event_count * 160);
+        out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        out += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"legal_doc_pipeline\"}}";
+
+        char line[256];
+        for (const auto& buffer : buffers) {
+            std::snprintf(line, sizeof(line),
+                          ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"Thread %u\"}}",
+                          buffer->thread_number, buffer->thread_number);
+            out += line;
+
+            // Eventos "X" (completos): ts e dur em microssegundos
+            for (const TraceEvent& event : buffer->events) {
+                out += ",\n{\"name\":";
+                appendJsonString(out, event.name);
+                std::snprintf(line, sizeof(line),
+                              ",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,"
+                              "\"args\":{\"begin\":%llu,\"end\":%llu}}",
+                              event.category, buffer->thread_number, event.begin_ns / 1000.0,
+                              std::max<int64_t>(0, event.end_ns - event.begin_ns) / 1000.0,
+                              static_cast<unsigned long long>(event.range_begin),
+                              static_cast<unsigned long long>(event.range_end));
+                out += line;
+            }
+        }
+        out += "\n]}\n";
+        return out;
+    }
+
+    bool TraceRecorder::writeChromeTrace(const std::string& path) const {
+        std::ofstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "Erro: não foi possível criar o arquivo de trace '" << path << "'" << std::endl;
+            return false;
+        }
+        file << toChromeTraceJson();
+        return static_cast<bool>(file);
+    }
+
+} // namespace utils
+} // namespace legal_doc_pipeline
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "../include/utils/arena_resource.h"
+#include "../include/pipeline/tokenized_document.h"
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+/**
+ * @file test_arena_resource.cpp
+ * @brief Testes unitários para a arena de memória por lote
+ */
+
+using namespace legal_doc_pipeline;
+
+namespace {
+
+    /**
+     * @brief Recurso de origem que conta os pedidos
+     */
+    class CountingResource : public std::pmr::memory_resource {
+    public:
+        size_t allocations = 0;
+        size_t deallocations = 0;
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            ++allocations;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* pointer, size_t bytes, size_t alignment) override {
+            ++deallocations;
+            std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+} // namespace
+
+TEST(ArenaResourceTest, AllocatesAlignedFromBlocks) {
+    CountingResource upstream;
+    {
+        utils::ArenaResource arena(1024, &upstream);
+        EXPECT_EQ(upstream.allocations, 0u);
+
+        void* first = arena.allocate(10, 1);
+        void* second = arena.allocate(64, 64);
+        void* third = arena.allocate(8, 8);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(second) % 64, 0u);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(third) % 8, 0u);
+        EXPECT_NE(first, second);
+        EXPECT_EQ(upstream.allocations, 1u);
+
+        // Maior que o bloco: um bloco novo do tamanho do pedido
+        void* large = arena.allocate(4096, 16);
+        EXPECT_NE(large, nullptr);
+        EXPECT_EQ(upstream.allocations, 2u);
+        EXPECT_EQ(arena.allocationCount(), 4u);
+        EXPECT_EQ(arena.allocatedBytes(), 10u + 64u + 8u + 4096u);
+        EXPECT_GE(arena.capacity(), 1024u + 4096u);
+    }
+    EXPECT_EQ(upstream.deallocations, upstream.allocations);
+}
+
+// Depois de release, os lotes seguintes reaproveitam os blocos sem pedir memória
+TEST(ArenaResourceTest, ReleaseReusesBlocks) {
+    CountingResource upstream;
+    utils::ArenaResource arena(256, &upstream);
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_NE(arena.allocate(200, 8), nullptr);
+    }
+    size_t blocks = upstream.allocations;
+    void* first_block = nullptr;
+
+    for (int batch = 0; batch < 5; ++batch) {
+        arena.release();
+        void* pointer = arena.allocate(200, 8);
+        if (batch == 0) {
+            first_block = pointer;
+        }
+        EXPECT_EQ(pointer, first_block);
+        for (int i = 1; i < 8; ++i) {
+            EXPECT_NE(arena.allocate(200, 8), nullptr);
+        }
+    }
+    EXPECT_EQ(upstream.allocations, blocks);
+    EXPECT_EQ(upstream.deallocations, 0u);
+}
+
+TEST(ArenaResourceTest, BacksTokenizedDocuments) {
+    CountingResource upstream;
+    utils::ArenaResource arena(4096, &upstream);
+
+    std::vector<pipeline::TokenizedDocument> documents;
+    for (int i = 0; i < 4; ++i) {
+        documents.emplace_back(&arena);
+    }
+    size_t blocks_after_first_batch = 0;
+    for (int batch = 0; batch < 3; ++batch) {
+        for (auto& document : documents) {
+            for (int t = 0; t < 50; ++t) {
+                document.addToken("token_" + std::to_string(t));
+            }
+            document.mutableIds().assign(document.size(), 7);
+            EXPECT_EQ(document.memoryResource(), &arena);
+        }
+        EXPECT_EQ(documents[2].token(49), "token_49");
+        for (auto& document : documents) {
+            document.releaseMemory();
+            EXPECT_TRUE(document.empty());
+        }
+        arena.release();
+        if (batch == 0) {
+            blocks_after_first_batch = upstream.allocations;
+        }
+    }
+    // Todos os lotes cabem nos blocos reservados pelo primeiro
+    EXPECT_GT(blocks_after_first_batch, 0u);
+    EXPECT_EQ(upstream.allocations, blocks_after_first_batch);
+    EXPECT_GT(arena.allocationCount(), 3u * 4u);
+
+    // Cópias saem da arena; trocas entre recursos diferentes copiam o conteúdo
+    documents[0].addToken("arena");
+    pipeline::TokenizedDocument copy(documents[0]);
+    EXPECT_EQ(copy.memoryResource(), std::pmr::get_default_resource());
+    pipeline::TokenizedDocument heap = pipeline::TokenizedDocument::fromString("a b c");
+    heap.swap(documents[0]);
+    EXPECT_EQ(heap.toString(), "arena");
+    EXPECT_EQ(documents[0].toString(), "a b c");
+    EXPECT_EQ(documents[0].memoryResource(), &arena);
+    EXPECT_EQ(upstream.allocations, blocks_after_first_batch);
+}
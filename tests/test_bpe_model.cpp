@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include "../include/tokenizer/bpe_model.h"
+#include "../include/tokenizer/tokenizer_registry.h"
+#include <cstdio>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file test_bpe_model.cpp
+ * @brief Testes unitários para o BpeModel (treino, carga e codificação) e o TokenizerRegistry
+ */
+
+using namespace hf_tokenizers;
+
+namespace {
+
+    /**
+     * @brief BPE de referência: aplica repetidamente o par adjacente de menor rank, o mais à esquerda
+     */
+    std::vector<std::string> referenceMerge(const std::string& word,
+                                            const std::vector<std::pair<std::string, std::string>>& merges) {
+        std::map<std::pair<std::string, std::string>, size_t> ranks;
+        for (size_t i = 0; i < merges.size(); ++i) {
+            ranks.emplace(merges[i], i);
+        }
+        std::vector<std::string> symbols;
+        for (char c : word) {
+            symbols.push_back(BpeModel::toByteAlphabet(std::string(1, c)));
+        }
+        while (true) {
+            size_t best = symbols.size();
+            size_t best_rank = merges.size();
+            for (size_t i = 0; i + 1 < symbols.size(); ++i) {
+                auto it = ranks.find({symbols[i], symbols[i + 1]});
+                if (it != ranks.end() && it->second < best_rank) {
+                    best_rank = it->second;
+                    best = i;
+                }
+            }
+            if (best == symbols.size()) break;
+            symbols[best] += symbols[best + 1];
+            symbols.erase(symbols.begin() + best + 1);
+        }
+        return symbols;
+    }
+
+    std::map<std::string, size_t> sampleCounts() {
+        return {{"contrato", 40}, {"contratos", 25}, {"contratação", 10}, {"processo", 30},
+                {"processos", 12}, {"aposentadoria", 8}, {"ação", 15}, {"nação", 5}, {"aaaa", 3}};
+    }
+
+} // namespace
+
+TEST(BpeModelTest, TrainAndEncode) {
+    std::vector<std::string> vocab;
+    std::vector<std::pair<std::string, std::string>> merges;
+    BpeModel::train(sampleCounts(), 320, {"[UNK]", "[CLS]"}, vocab, merges);
+
+    // Corpus pequeno: o treino para quando não há mais pares repetidos
+    ASSERT_LE(vocab.size(), 320u);
+    EXPECT_EQ(vocab.size(), 2 + 256 + merges.size());
+    EXPECT_EQ(vocab[0], "[UNK]");
+    EXPECT_FALSE(merges.empty());
+
+    BpeModel model;
+    model.load(vocab, merges);
+    EXPECT_EQ(model.vocabularySize(), vocab.size());
+
+    // Palavras frequentes do treino viram um único token, com os bytes originais
+    std::vector<BpeToken> tokens;
+    model.encodeWord("contrato", tokens);
+    ASSERT_EQ(tokens.size(), 1u);
+    EXPECT_EQ(tokens[0].text, "contrato");
+
+    tokens.clear();
+    model.encodeWord("ação", tokens);
+    std::string joined;
+    for (const auto& token : tokens) joined += std::string(token.text);
+    EXPECT_EQ(joined, "ação");
+    EXPECT_EQ(model.cachedWords(), 2u);
+}
+
+// O laço com fila de prioridade deve reproduzir o BPE ingênuo
+TEST(BpeModelTest, MatchesReferenceMerge) {
+    std::vector<std::string> vocab;
+    std::vector<std::pair<std::string, std::string>> merges;
+    BpeModel::train(sampleCounts(), 400, {"[UNK]"}, vocab, merges);
+    BpeModel model;
+    model.load(vocab, merges);
+
+    std::mt19937 rng(7);
+    const std::string alphabet = "contraçãpesx";
+    std::uniform_int_distribution<size_t> pick(0, alphabet.size() - 1);
+    std::uniform_int_distribution<size_t> length(1, 14);
+
+    for (int n = 0; n < 500; ++n) {
+        std::string word;
+        size_t len = length(rng);
+        for (size_t i = 0; i < len; ++i) word += alphabet[pick(rng)];
+
+        std::vector<BpeToken> tokens;
+        model.encodeWord(word, tokens);
+        std::vector<std::string> actual;
+        for (const auto& token : tokens) actual.push_back(BpeModel::toByteAlphabet(token.text));
+        ASSERT_EQ(actual, referenceMerge(word, merges)) << word;
+    }
+}
+
+TEST(BpeModelTest, SaveLoadAndTokenizerFallback) {
+    std::vector<std::string> vocab;
+    std::vector<std::pair<std::string, std::string>> merges;
+    BpeModel::train(sampleCounts(), 300, {"[UNK]"}, vocab, merges);
+
+    const std::string vocab_path = "test_bpe_vocab.txt";
+    const std::string merges_path = "test_bpe_merges.txt";
+    ASSERT_TRUE(BpeModel::save(vocab_path, merges_path, vocab, merges));
+
+    BpeModel loaded;
+    ASSERT_TRUE(loaded.load(vocab_path, merges_path));
+    EXPECT_EQ(loaded.vocabularySize(), vocab.size());
+    EXPECT_EQ(loaded.mergeCount(), merges.size());
+
+    Tokenizer tokenizer(vocab_path, merges_path);
+    EXPECT_TRUE(tokenizer.uses_bpe_model());
+    Encoding encoding;
+    tokenizer.encode_word("processos", encoding);
+    std::string joined;
+    for (const auto& token : encoding.tokens) joined += token.text;
+    EXPECT_EQ(joined, "processos");
+    EXPECT_EQ(encoding.ids.size(), encoding.tokens.size());
+
+    std::remove(vocab_path.c_str());
+    std::remove(merges_path.c_str());
+
+    BpeModel missing;
+    EXPECT_FALSE(missing.load("inexistente_vocab.txt", "inexistente_merges.txt"));
+    Tokenizer fallback("inexistente_vocab.txt", "inexistente_merges.txt");
+    EXPECT_FALSE(fallback.uses_bpe_model());
+}
+
+// Threads concorrentes recebem a mesma instância, carregada uma única vez
+TEST(TokenizerRegistryTest, SharesOneInstancePerFilePair) {
+    TokenizerRegistry::clear();
+
+    std::vector<std::shared_ptr<const TokenizerWrapper>> results(8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < results.size(); ++i) {
+        threads.emplace_back([&results, i]() {
+            results[i] = TokenizerRegistry::get("inexistente_vocab.txt", "inexistente_merges.txt");
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& tokenizer : results) {
+        ASSERT_NE(tokenizer, nullptr);
+        EXPECT_EQ(tokenizer.get(), results[0].get());
+    }
+    EXPECT_EQ(TokenizerRegistry::size(), 1u);
+
+    auto other = TokenizerRegistry::get("outro_vocab.txt", "inexistente_merges.txt");
+    EXPECT_NE(other.get(), results[0].get());
+    EXPECT_EQ(TokenizerRegistry::size(), 2u);
+
+    // Instâncias já obtidas sobrevivem ao clear()
+    TokenizerRegistry::clear();
+    EXPECT_EQ(TokenizerRegistry::size(), 0u);
+    EXPECT_FALSE(results[0]->text_to_ids("documento").empty());
+    EXPECT_NE(TokenizerRegistry::get("inexistente_vocab.txt", "inexistente_merges.txt").get(), results[0].get());
+    TokenizerRegistry::clear();
+}
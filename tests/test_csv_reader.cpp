@@ -1,7 +1,10 @@
 #include <gtest/gtest.h>
 #include "../include/utils/csv_reader.h"
+#include "../include/utils/csv_record_iterator.h"
+#include "../include/utils/mapped_csv_reader.h"
 #include <fstream>
 #include <filesystem>
+#include <sstream>
 
 /**
  * @file test_csv_reader.cpp
@@ -189,7 +192,7 @@ TEST_F(CsvReaderTest, ReadRealDataColumn) {
     // Ler coluna 'Texto' dos dados reais (usando delimitador correto ';')
     auto textos = reader.readColumn(real_data_file, "Texto", ';');
     
-    // Deve ter exatamente 4 entradas (5 linhas no arquivo - 1 cabeçalho)
+    // Deve ter exatamente 4 entradas (4 registros, com campos de várias linhas)
     EXPECT_EQ(textos.size(), 4);
     
     // Verificar se o primeiro texto contém conteúdo esperado
@@ -248,3 +251,77 @@ TEST_F(CsvReaderTest, RealDataAllColumns) {
         EXPECT_TRUE(found) << "Coluna '" << expected_col << "' não encontrada";
     }
 }
+
+// Campos entre aspas com quebras de linha formam um único registro
+TEST_F(CsvReaderTest, QuotedFieldsSpanLines) {
+    std::string multiline_filename = "multiline_test.csv";
+    std::ofstream file(multiline_filename);
+    file << "ID;Texto\n"
+         << "1;\"primeira linha\nsegunda linha\";\n"
+         << "2;\"ele disse \"\"sim\"\"; e saiu\"\r\n"
+         << "3;simples\n";
+    file.close();
+
+    auto result = reader.readColumn(multiline_filename, "Texto");
+    ASSERT_EQ(result.size(), 3);
+    EXPECT_EQ(result[0], "primeira linha\nsegunda linha");
+    EXPECT_EQ(result[1], "ele disse \"sim\"; e saiu");
+    EXPECT_EQ(result[2], "simples");
+
+    auto ids = reader.readColumn(multiline_filename, "ID");
+    EXPECT_EQ(ids, (std::vector<std::string>{"1", "2", "3"}));
+
+    fs::remove(multiline_filename);
+}
+
+// O tamanho do bloco de leitura não pode alterar os registros
+TEST_F(CsvReaderTest, RecordIteratorBufferSizes) {
+    std::string content = "\xEF\xBB\xBF" "a;b\n\"x\"\"\ny\";2\r\n\n\"\";\"fim\"";
+    std::vector<std::vector<std::string>> expected = {
+        {"a", "b"}, {"x\"\ny", "2"}, {""}, {"", "fim"}
+    };
+
+    for (size_t buffer_size : {1u, 2u, 3u, 5u, 7u, 4096u}) {
+        std::istringstream stream(content);
+        CsvRecordIterator records(stream, ';', buffer_size);
+        std::vector<std::vector<std::string>> actual;
+        std::vector<std::string> fields;
+        while (records.next(fields)) {
+            actual.push_back(fields);
+        }
+        EXPECT_EQ(actual, expected) << "bloco de " << buffer_size << " bytes";
+        EXPECT_EQ(records.getRecordsRead(), expected.size());
+        EXPECT_FALSE(records.hasUnterminatedQuote());
+    }
+}
+
+// Leitura em streaming entrega os mesmos valores que readColumn
+TEST_F(CsvReaderTest, ForEachValueStreamsColumn) {
+    std::vector<std::string> streamed;
+    size_t count = reader.forEachValue(test_filename, "Nome",
+        [&streamed](std::string& value) { streamed.push_back(value); }, ',');
+
+    EXPECT_EQ(count, 4);
+    EXPECT_EQ(streamed, reader.readColumn(test_filename, "Nome", ','));
+    EXPECT_EQ(reader.forEachValue(test_filename, "Inexistente", [](std::string&) {}, ','), 0);
+
+    std::istringstream unterminated("1;\"aberto\n2;x\n");
+    CsvRecordIterator records(unterminated);
+    std::vector<std::string> fields;
+    ASSERT_TRUE(records.next(fields));
+    EXPECT_TRUE(records.hasUnterminatedQuote());
+    EXPECT_FALSE(records.next(fields));
+}
+
+// Leitor em streaming e leitor mapeado concordam no corpus completo
+TEST_F(CsvReaderTest, StreamingMatchesMappedReader) {
+    const std::string corpus_file = "docs.csv";
+    if (!reader.validateFile(corpus_file)) {
+        GTEST_SKIP() << "docs.csv não encontrado";
+    }
+
+    auto streamed = reader.readColumn(corpus_file, "Texto");
+    CsvColumnView mapped = MappedCsvReader(2, 4096).readColumn(corpus_file, "Texto");
+    EXPECT_EQ(streamed.size(), 999);
+    EXPECT_EQ(streamed, mapped.toStrings());
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include "../include/tokenizer/double_array_trie.h"
+#include "../include/tokenizer/tokenizer_wrapper.h"
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @file test_double_array_trie.cpp
+ * @brief Testes unitários para o DoubleArrayTrie e a busca de maior prefixo do tokenizador
+ */
+
+using namespace hf_tokenizers;
+
+namespace {
+
+    /**
+     * @brief Busca de maior prefixo de referência, como o tokenizador fazia antes do trie
+     */
+    bool referenceLongestPrefix(const std::map<std::string, unsigned int>& vocab, const std::string& text,
+                                size_t& length, unsigned int& id) {
+        for (size_t len = text.size(); len > 0; --len) {
+            auto it = vocab.find(text.substr(0, len));
+            if (it != vocab.end()) {
+                length = len;
+                id = it->second;
+                return true;
+            }
+        }
+        return false;
+    }
+
+} // namespace
+
+TEST(DoubleArrayTrieTest, FindAndLongestPrefix) {
+    DoubleArrayTrie trie;
+    trie.build({{"do", 5}, {"documento", 7}, {"documentos", 15}, {"o", 1}, {"", 99}, {"do", 42}});
+
+    EXPECT_EQ(trie.size(), 4u);   // chave vazia ignorada, "do" repetido mantém o primeiro ID
+    unsigned int id = 0;
+    EXPECT_TRUE(trie.find("do", id));
+    EXPECT_EQ(id, 5u);
+    EXPECT_TRUE(trie.find("documentos", id));
+    EXPECT_EQ(id, 15u);
+    EXPECT_FALSE(trie.find("doc", id));
+    EXPECT_FALSE(trie.find("", id));
+
+    size_t length = 0;
+    std::string text = "documentação";
+    ASSERT_TRUE(trie.longestPrefix(text.data(), text.size(), length, id));
+    EXPECT_EQ(length, 2u);
+    EXPECT_EQ(id, 5u);
+
+    text = "documentos legais";
+    ASSERT_TRUE(trie.longestPrefix(text.data(), text.size(), length, id));
+    EXPECT_EQ(length, 10u);
+    EXPECT_EQ(id, 15u);
+
+    text = "xyz";
+    EXPECT_FALSE(trie.longestPrefix(text.data(), text.size(), length, id));
+
+    DoubleArrayTrie empty;
+    EXPECT_FALSE(empty.longestPrefix(text.data(), text.size(), length, id));
+}
+
+// Vocabulário aleatório com bytes UTF-8 e prefixos compartilhados, comparado com a busca por map
+TEST(DoubleArrayTrieTest, MatchesMapLookupOnRandomVocabulary) {
+    std::mt19937 rng(1234);
+    const std::string alphabet = "abcdeçãé\xff\x01";
+    std::uniform_int_distribution<size_t> pick(0, alphabet.size() - 1);
+    std::uniform_int_distribution<size_t> key_length(1, 8);
+
+    std::map<std::string, unsigned int> vocab;
+    while (vocab.size() < 5000) {
+        std::string key;
+        size_t len = key_length(rng);
+        for (size_t i = 0; i < len; ++i) key += alphabet[pick(rng)];
+        vocab.emplace(key, static_cast<unsigned int>(vocab.size() + 1));
+    }
+
+    DoubleArrayTrie trie;
+    trie.build(std::vector<std::pair<std::string, unsigned int>>(vocab.begin(), vocab.end()));
+    ASSERT_EQ(trie.size(), vocab.size());
+
+    for (int n = 0; n < 5000; ++n) {
+        std::string text;
+        size_t len = key_length(rng) + 4;
+        for (size_t i = 0; i < len; ++i) text += alphabet[pick(rng)];
+
+        size_t expected_length = 0, actual_length = 0;
+        unsigned int expected_id = 0, actual_id = 0;
+        bool expected = referenceLongestPrefix(vocab, text, expected_length, expected_id);
+        bool actual = trie.longestPrefix(text.data(), text.size(), actual_length, actual_id);
+        ASSERT_EQ(actual, expected) << text;
+        if (expected) {
+            EXPECT_EQ(actual_length, expected_length) << text;
+            EXPECT_EQ(actual_id, expected_id) << text;
+        }
+    }
+}
+
+// O tokenizador consome o maior prefixo e trata o restante sem correspondência como desconhecido
+TEST(DoubleArrayTrieTest, TokenizerUsesLongestMatch) {
+    Tokenizer tokenizer(std::map<std::string, unsigned int>{{"do", 5}, {"cumento", 20}, {"documento", 7}, {"s", 30}});
+    EXPECT_EQ(tokenizer.vocabulary_size(), 4u);
+
+    Encoding encoding;
+    tokenizer.encode_word("documentos", encoding);
+    ASSERT_EQ(encoding.tokens.size(), 2u);
+    EXPECT_EQ(encoding.tokens[0].text, "documento");
+    EXPECT_EQ(encoding.ids, (std::vector<unsigned int>{7, 30}));
+
+    Encoding unknown;
+    tokenizer.encode_word("docxyz", unknown);
+    ASSERT_EQ(unknown.tokens.size(), 2u);
+    EXPECT_EQ(unknown.tokens[1].text, "cxyz");
+    EXPECT_EQ(unknown.ids, (std::vector<unsigned int>{5, 0}));
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include "../include/utils/latency_histogram.h"
+#include <cstdint>
+
+/**
+ * @file test_latency_histogram.cpp
+ * @brief Testes unitários para o histograma de latências
+ */
+
+using namespace legal_doc_pipeline::utils;
+
+TEST(LatencyHistogramTest, EmptyHistogram) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.count(), 0u);
+    EXPECT_EQ(histogram.percentile(50.0), 0u);
+    EXPECT_EQ(histogram.mean(), 0.0);
+}
+
+// Valores pequenos têm bucket exato
+TEST(LatencyHistogramTest, SmallValuesAreExact) {
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 10; ++value) {
+        histogram.record(value);
+    }
+    EXPECT_EQ(histogram.count(), 10u);
+    EXPECT_EQ(histogram.min(), 1u);
+    EXPECT_EQ(histogram.max(), 10u);
+    EXPECT_EQ(histogram.sum(), 55u);
+    EXPECT_EQ(histogram.percentile(50.0), 5u);
+    EXPECT_EQ(histogram.percentile(100.0), 10u);
+}
+
+// Percentis de uma distribuição uniforme dentro do erro relativo de 1/16
+TEST(LatencyHistogramTest, PercentilesWithinRelativeError) {
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 100000; ++value) {
+        histogram.record(value * 1000);
+    }
+    for (double p : {50.0, 95.0, 99.0}) {
+        double expected = p / 100.0 * 100000.0 * 1000.0;
+        double actual = static_cast<double>(histogram.percentile(p));
+        EXPECT_GE(actual, expected) << "p" << p;
+        EXPECT_LE(actual, expected * (1.0 + 1.0 / 16.0)) << "p" << p;
+    }
+    EXPECT_EQ(histogram.percentile(100.0), histogram.max());
+}
+
+TEST(LatencyHistogramTest, MergeAndReset) {
+    LatencyHistogram fast;
+    LatencyHistogram slow;
+    for (int i = 0; i < 90; ++i) fast.record(1000);
+    for (int i = 0; i < 10; ++i) slow.record(1000000);
+
+    fast.merge(slow);
+    EXPECT_EQ(fast.count(), 100u);
+    EXPECT_EQ(fast.min(), 1000u);
+    EXPECT_EQ(fast.max(), 1000000u);
+    EXPECT_LE(fast.percentile(90.0), 1000u + 1000u / 16);
+    EXPECT_EQ(fast.percentile(95.0), 1000000u);
+
+    fast.reset();
+    EXPECT_EQ(fast.count(), 0u);
+    EXPECT_EQ(fast.max(), 0u);
+}
+
+// Valores enormes caem no último bucket sem estourar
+TEST(LatencyHistogramTest, ClampsHugeValues) {
+    LatencyHistogram histogram;
+    histogram.record(UINT64_MAX / 2);
+    histogram.record(1);
+    EXPECT_EQ(histogram.percentile(100.0), UINT64_MAX / 2);
+    EXPECT_EQ(histogram.percentile(50.0), 1u);
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "../include/utils/logger.h"
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file test_logger.cpp
+ * @brief Testes unitários para o log assíncrono com níveis
+ */
+
+using namespace legal_doc_pipeline::utils;
+
+class LoggerTest : public ::testing::Test {
+protected:
+    std::ostringstream output;
+
+    void SetUp() override {
+        Logger::flush();
+        Logger::setSink(&output);
+    }
+
+    void TearDown() override {
+        Logger::setSink(nullptr);
+        Logger::setLevel(LogLevel::INFO);
+    }
+
+    static size_t countOccurrences(const std::string& text, const std::string& pattern) {
+        size_t count = 0;
+        for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+            ++count;
+        }
+        return count;
+    }
+};
+
+TEST_F(LoggerTest, LevelRoundTrip) {
+    EXPECT_EQ(Logger::getLevel(), LogLevel::INFO);
+    Logger::setLevel(LogLevel::WARNING);
+    EXPECT_EQ(Logger::getLevel(), LogLevel::WARNING);
+    EXPECT_FALSE(Logger::isEnabled(LogLevel::INFO));
+    EXPECT_TRUE(Logger::isEnabled(LogLevel::ERROR));
+    EXPECT_STREQ(Logger::levelName(LogLevel::VERBOSE), "VERBOSE");
+}
+
+// Mensagens de várias threads chegam todas à saída, uma por linha
+TEST_F(LoggerTest, CollectsMessagesFromAllThreads) {
+    const int threads = 4;
+    const int per_thread = 100;
+    std::vector<std::thread> writers;
+    for (int t = 0; t < threads; ++t) {
+        writers.emplace_back([t]() {
+            for (int i = 0; i < per_thread; ++i) {
+                PIPELINE_LOG_INFO("mensagem " << t << "-" << i);
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    Logger::flush();
+
+    std::string text = output.str();
+    EXPECT_EQ(countOccurrences(text, "[INFO t"), static_cast<size_t>(threads * per_thread));
+    EXPECT_NE(text.find("] mensagem 3-99\n"), std::string::npos);
+}
+
+// Uma mensagem desabilitada não é formatada
+TEST_F(LoggerTest, DisabledLevelSkipsFormatting) {
+    int evaluations = 0;
+    auto expensive = [&evaluations]() { return ++evaluations; };
+
+    PIPELINE_LOG_VERBOSE("valor " << expensive());
+    EXPECT_EQ(evaluations, 0);
+
+    Logger::setLevel(LogLevel::VERBOSE);
+    PIPELINE_LOG_VERBOSE("valor " << expensive());
+    EXPECT_EQ(evaluations, 1);
+
+    Logger::flush();
+    EXPECT_NE(output.str().find("[VERBOSE t"), std::string::npos);
+}
+
+// Abaixo de PIPELINE_LOG_MIN_LEVEL o nível de execução não tem efeito
+TEST_F(LoggerTest, CompiledOutLevelIgnoresRuntimeLevel) {
+    int evaluations = 0;
+    auto expensive = [&evaluations]() { return ++evaluations; };
+
+    Logger::setLevel(LogLevel::TRACE);
+    PIPELINE_LOG_TRACE("evento " << expensive());
+    Logger::flush();
+
+    if (PIPELINE_LOG_MIN_LEVEL > 0) {
+        EXPECT_EQ(evaluations, 0);
+        EXPECT_EQ(output.str().find("[TRACE"), std::string::npos);
+    } else {
+        EXPECT_EQ(evaluations, 1);
+    }
+}
+
+// Mensagens longas são truncadas no tamanho da entrada
+TEST_F(LoggerTest, TruncatesLongMessages) {
+    PIPELINE_LOG_WARNING(std::string(1000, 'x'));
+    Logger::flush();
+
+    std::string text = output.str();
+    EXPECT_NE(text.find("[WARNING t"), std::string::npos);
+    EXPECT_LT(countOccurrences(text, "x"), 1000u);
+    EXPECT_EQ(text.back(), '\n');
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "../include/utils/mapped_csv_reader.h"
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+
+/**
+ * @file test_mapped_csv_reader.cpp
+ * @brief Testes unitários para o MappedCsvReader
+ *
+ * Blocos mínimos de poucos bytes forçam fronteiras de bloco dentro de campos
+ * entre aspas, de aspas escapadas e de quebras de linha CRLF.
+ */
+
+using namespace legal_doc_pipeline::utils;
+
+class MappedCsvReaderTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        test_filename = "test_mapped.csv";
+    }
+
+    void TearDown() override {
+        std::remove(test_filename.c_str());
+    }
+
+    void writeFile(const std::string& content) {
+        std::ofstream file(test_filename, std::ios::binary);
+        file << content;
+    }
+
+    std::string test_filename;
+};
+
+TEST_F(MappedCsvReaderTest, QuotedMultilineFields) {
+    writeFile("\xEF\xBB\xBFid;Texto;Resumo\n"
+              "1;\"primeira linha\nsegunda; com delimitador\";r1\n"
+              "2;  sem aspas  ;r2\r\n"
+              "3;\"diz \"\"olá\"\"\";r3\n"
+              "4\n"
+              "5;\"\";r5\n");
+
+    for (size_t threads : {1u, 2u, 3u, 8u}) {
+        MappedCsvReader reader(threads, 1);
+        CsvColumnView column = reader.readColumn(test_filename, "Texto");
+        ASSERT_EQ(column.size(), 5u) << threads << " threads";
+        EXPECT_EQ(column[0], "primeira linha\nsegunda; com delimitador");
+        EXPECT_EQ(column[1], "sem aspas");
+        EXPECT_EQ(column[2], "diz \"olá\"");
+        EXPECT_EQ(column[3], "");
+        EXPECT_EQ(column[4], "");
+    }
+}
+
+TEST_F(MappedCsvReaderTest, ChunkingDoesNotChangeResult) {
+    std::string content = "Processo;Texto\n";
+    for (int i = 0; i < 200; ++i) {
+        content += std::to_string(i) + ";\"documento " + std::to_string(i);
+        if (i % 3 == 0) content += "\ncom \"\"citação\"\"\n\ne linhas";
+        content += "\"\n";
+    }
+    writeFile(content);
+
+    CsvColumnView expected = MappedCsvReader(1).readColumn(test_filename, "Texto");
+    ASSERT_EQ(expected.size(), 200u);
+    EXPECT_EQ(expected[3], "documento 3\ncom \"citação\"\n\ne linhas");
+
+    for (size_t min_chunk : {1u, 7u, 64u, 1000u}) {
+        MappedCsvReader reader(4, min_chunk);
+        CsvColumnView column = reader.readColumn(test_filename, "Texto");
+        EXPECT_EQ(column.toStrings(), expected.toStrings()) << "bloco mínimo " << min_chunk;
+    }
+}
+
+TEST_F(MappedCsvReaderTest, MissingFileAndColumn) {
+    MappedCsvReader reader;
+    EXPECT_TRUE(reader.readColumn("arquivo_inexistente.csv", "Texto").empty());
+
+    writeFile("a;b\n1;2\n");
+    EXPECT_TRUE(reader.readColumn(test_filename, "Texto").empty());
+
+    CsvColumnView column = reader.readColumn(test_filename, "b");
+    ASSERT_EQ(column.size(), 1u);
+    EXPECT_EQ(column[0], "2");
+}
+
+TEST_F(MappedCsvReaderTest, ReadDocsCsvInParallel) {
+    const std::string path = "docs.csv";
+    if (!std::ifstream(path).good()) {
+        GTEST_SKIP() << "docs.csv não encontrado";
+    }
+
+    CsvColumnView sequential = MappedCsvReader(1).readColumn(path, "Texto");
+    CsvColumnView parallel = MappedCsvReader(4, 4096).readColumn(path, "Texto");
+    EXPECT_EQ(sequential.size(), 999u);
+    EXPECT_EQ(parallel.toStrings(), sequential.toStrings());
+}
@@ -0,0 +1,31 @@
+#include <gtest/gtest.h>
+#include "../include/utils/memory_usage.h"
+#include <cstring>
+#include <vector>
+
+/**
+ * @file test_memory_usage.cpp
+ * @brief Testes unitários para a consulta de memória residente
+ */
+
+using namespace legal_doc_pipeline::utils;
+
+// O pico acompanha uma alocação tocada página a página
+TEST(MemoryUsageTest, PeakTracksTouchedAllocation) {
+    size_t current = MemoryUsage::currentResidentBytes();
+#ifndef __linux__
+    GTEST_SKIP() << "memória residente só é lida no Linux";
+#endif
+    ASSERT_GT(current, 0u);
+    MemoryUsage::resetPeak();
+    size_t peak_before = MemoryUsage::peakResidentBytes();
+    EXPECT_GE(peak_before, current / 2);
+
+    const size_t size = 64 * 1024 * 1024;
+    {
+        std::vector<char> block(size);
+        std::memset(block.data(), 1, block.size());
+        EXPECT_GE(MemoryUsage::currentResidentBytes(), current + size / 2);
+    }
+    EXPECT_GE(MemoryUsage::peakResidentBytes(), peak_before + size / 2);
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include "../include/pipeline/pipeline_manager.h"
 #include "../include/utils/csv_reader.h"
+#include "../include/utils/trace_recorder.h"
 #include "../include/types.h"
 #include <vector>
 #include <string>
@@ -392,3 +393,216 @@ TEST_F(PipelineManagerTest, RealDataSpecialCharacters) {
     auto stats = manager.getExecutionStats();
     EXPECT_GT(stats.at("parallel_time"), 0.0);
 }
+
+// Teste do modo streaming: lotes pequenos e filas curtas forçam back-pressure
+TEST_F(PipelineManagerTest, RunStreamingMatchesSequential) {
+    std::vector<std::string> many_docs;
+    for (int i = 0; i < 40; ++i) {
+        many_docs.push_back(test_data[i % test_data.size()] + " " + std::to_string(i));
+    }
+
+    config.stream_batch_size = 3;
+    config.stream_queue_capacity = 1;
+    PipelineManager manager(config);
+
+    auto streaming_result = manager.runStreaming(many_docs);
+    auto sequential_result = manager.runSequential(many_docs, true);
+
+    ASSERT_TRUE(streaming_result.success) << streaming_result.error_message;
+    ASSERT_TRUE(sequential_result.success);
+    EXPECT_EQ(streaming_result.processed_data, sequential_result.processed_data);
+    EXPECT_EQ(streaming_result.tasks_completed, 8u);
+
+    // Uma entrada de estatísticas por etapa, cada uma vendo todos os documentos
+    ASSERT_EQ(streaming_result.stage_stats.size(), 8u);
+    EXPECT_EQ(streaming_result.stage_stats.front().name, "CleanText");
+    EXPECT_EQ(streaming_result.stage_stats.back().name, "GenerateEmbeddings");
+    for (const auto& stage : streaming_result.stage_stats) {
+        EXPECT_EQ(stage.documents, many_docs.size());
+        EXPECT_EQ(stage.batches, 14u);  // ceil(40 / 3)
+    }
+    EXPECT_GT(manager.getExecutionStats().at("streaming_time"), 0.0);
+}
+
+// Teste do modo streaming com entrada inválida
+TEST_F(PipelineManagerTest, RunStreamingRejectsEmptyData) {
+    PipelineManager manager(config);
+    auto result = manager.runStreaming({});
+    EXPECT_FALSE(result.success);
+    EXPECT_FALSE(result.error_message.empty());
+}
+
+// O workflow compilado é reutilizado entre execuções, inclusive com lotes de tamanhos diferentes
+TEST_F(PipelineManagerTest, RunParallelReusesCompiledWorkflow) {
+    PipelineManager manager(config);
+    std::vector<std::string> small_batch(test_data.begin(), test_data.begin() + 2);
+
+    for (const auto& batch : {test_data, small_batch, test_data}) {
+        auto parallel_result = manager.runParallel(batch);
+        auto sequential_result = manager.runSequential(batch, true);
+        ASSERT_TRUE(parallel_result.success) << parallel_result.error_message;
+        EXPECT_EQ(parallel_result.processed_data, sequential_result.processed_data);
+        EXPECT_EQ(parallel_result.tasks_completed, 8u);
+    }
+
+    // Após updateConfig o workflow é remontado com a nova granularidade
+    config.task_grain_size = 1;
+    manager.updateConfig(config);
+    auto result = manager.runParallel(test_data);
+    ASSERT_TRUE(result.success);
+    EXPECT_EQ(result.processed_data, manager.runSequential(test_data, true).processed_data);
+}
+
+// Os modos paralelos compartilham o mesmo pool entre execuções, inclusive após mudar o número de workers
+TEST_F(PipelineManagerTest, ParallelModesShareThreadPool) {
+    config.worker_spin_iterations = 1000;
+    PipelineManager manager(config);
+    auto expected = manager.runSequential(test_data, true).processed_data;
+
+    for (int round = 0; round < 3; ++round) {
+        auto parallel_result = manager.runParallel(test_data);
+        auto partitioned_result = manager.runParallelPartitioned(test_data);
+        ASSERT_TRUE(parallel_result.success) << parallel_result.error_message;
+        ASSERT_TRUE(partitioned_result.success) << partitioned_result.error_message;
+        EXPECT_EQ(parallel_result.processed_data, expected);
+        EXPECT_EQ(partitioned_result.processed_data, expected);
+    }
+
+    config.num_workers = 3;
+    config.pin_worker_threads = true;
+    manager.updateConfig(config);
+    auto result = manager.runParallelPartitioned(test_data);
+    ASSERT_TRUE(result.success);
+    EXPECT_EQ(result.processed_data, expected);
+    EXPECT_EQ(manager.runSequential(test_data).processed_data, expected);
+}
+
+// Percentis por etapa do scheduler expostos nas estatísticas do gerenciador
+TEST_F(PipelineManagerTest, ExposesStageLatencyPercentiles) {
+    PipelineManager manager(config);
+    auto result = manager.runParallel(test_data);
+    ASSERT_TRUE(result.success) << result.error_message;
+
+    auto stats = manager.getExecutionStats();
+    for (const char* stage : {"TEXT_CLEANING", "NORMALIZATION", "WORD_TOKENIZATION", "BPE_TOKENIZATION",
+                              "PARTITION_TOKENS", "ADD_SPECIAL_TOKENS", "TOKENS_TO_INDICES", "GENERATE_EMBEDDINGS"}) {
+        const std::string prefix = std::string("latency.") + stage + ".";
+        ASSERT_EQ(stats.count(prefix + "items"), 1u) << stage;
+        EXPECT_GE(stats[prefix + "items"], 1.0);
+        EXPECT_LE(stats[prefix + "run_p50_ns"], stats[prefix + "run_p95_ns"]);
+        EXPECT_LE(stats[prefix + "run_p95_ns"], stats[prefix + "run_p99_ns"]);
+        EXPECT_LE(stats[prefix + "queue_wait_p50_ns"], stats[prefix + "queue_wait_p99_ns"]);
+    }
+}
+
+// Linha do tempo de tarefas do scheduler e de chunks, só com enable_tracing
+TEST_F(PipelineManagerTest, RecordsTraceWhenEnabled) {
+    PipelineManager untraced(config);
+    ASSERT_TRUE(untraced.runParallel(test_data).success);
+    EXPECT_EQ(untraced.getTraceRecorder(), nullptr);
+    EXPECT_FALSE(untraced.writeTrace("nao_deve_existir.json"));
+
+    config.enable_tracing = true;
+    PipelineManager manager(config);
+    ASSERT_NE(manager.getTraceRecorder(), nullptr);
+    ASSERT_TRUE(manager.runParallel(test_data).success);
+    size_t scheduler_events = manager.getTraceRecorder()->eventCount();
+    EXPECT_GE(scheduler_events, 8u);   // Pelo menos um item por etapa
+
+    ASSERT_TRUE(manager.runParallelPartitioned(test_data).success);
+    std::string json = manager.getTraceRecorder()->toChromeTraceJson();
+    EXPECT_NE(json.find("\"name\":\"CleanText\",\"cat\":\"scheduler\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"Chunk\",\"cat\":\"partitioned\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"GenerateEmbeddings\",\"cat\":\"partitioned\""), std::string::npos);
+    EXPECT_GT(manager.getTraceRecorder()->eventCount(), scheduler_events);
+
+    // Desligar o tracing para de gravar, mas preserva o que já foi gravado
+    config.enable_tracing = false;
+    manager.updateConfig(config);
+    size_t recorded = manager.getTraceRecorder()->eventCount();
+    ASSERT_TRUE(manager.runParallel(test_data).success);
+    EXPECT_EQ(manager.getTraceRecorder()->eventCount(), recorded);
+
+    const std::string path = "test_pipeline_trace.json";
+    EXPECT_TRUE(manager.writeTrace(path));
+    EXPECT_TRUE(std::filesystem::exists(path));
+    std::filesystem::remove(path);
+}
+
+// A arena por lote não muda o resultado dos modos particionado e streaming
+TEST_F(PipelineManagerTest, BatchArenaKeepsResults) {
+    std::vector<std::string> corpus;
+    for (int copy = 0; copy < 40; ++copy) {
+        corpus.insert(corpus.end(), test_data.begin(), test_data.end());
+    }
+    config.stream_batch_size = 16;
+
+    config.use_batch_arena = false;
+    PipelineManager heap_manager(config);
+    PipelineResult heap_partitioned = heap_manager.runParallelPartitioned(corpus);
+    PipelineResult heap_streaming = heap_manager.runStreaming(corpus);
+
+    config.use_batch_arena = true;
+    PipelineManager arena_manager(config);
+    PipelineResult arena_partitioned = arena_manager.runParallelPartitioned(corpus);
+    PipelineResult arena_streaming = arena_manager.runStreaming(corpus);
+
+    ASSERT_TRUE(heap_partitioned.success);
+    ASSERT_TRUE(arena_partitioned.success);
+    ASSERT_TRUE(arena_streaming.success);
+    EXPECT_EQ(arena_partitioned.processed_data, heap_partitioned.processed_data);
+    EXPECT_EQ(arena_streaming.processed_data, heap_streaming.processed_data);
+    EXPECT_EQ(arena_partitioned.processed_data, arena_streaming.processed_data);
+}
+
+// Custo adaptativo: guiado pelo custo restante e elevado pela latência observada
+TEST_F(PipelineManagerTest, AdaptiveChunkCost) {
+    PipelineManager manager(config);
+
+    EXPECT_EQ(manager.calculateAdaptiveChunkCost(0, 4, 0.0), 0u);
+    EXPECT_EQ(manager.calculateAdaptiveChunkCost(800, 4, 0.0), 100u);
+    EXPECT_EQ(manager.calculateAdaptiveChunkCost(3, 4, 0.0), 1u);
+
+    // 10 µs por unidade: chunks de pelo menos 100 unidades (~1 ms)
+    EXPECT_EQ(manager.calculateAdaptiveChunkCost(200, 4, 10e-6), 100u);
+    EXPECT_EQ(manager.calculateAdaptiveChunkCost(60, 4, 10e-6), 60u);
+    // Trabalho lento não altera o custo guiado
+    EXPECT_EQ(manager.calculateAdaptiveChunkCost(800, 4, 0.1), 100u);
+}
+
+// Chunks balanceados por bytes: um documento grande fica sozinho, os pequenos se agrupam
+TEST_F(PipelineManagerTest, CostBasedChunkBoundaries) {
+    PipelineManager manager(config);
+    std::vector<std::string> data = {std::string(100000, 'a'), "b", "c", "d", std::string(744, 'e'), "f"};
+
+    std::vector<uint64_t> prefix = manager.calculateCostPrefix(data);
+    ASSERT_EQ(prefix.size(), data.size() + 1);
+    EXPECT_EQ(prefix[0], 0u);
+    EXPECT_EQ(prefix[1], 100000u + 256u);
+    EXPECT_EQ(prefix[2] - prefix[1], 257u);
+
+    EXPECT_EQ(manager.findChunkEnd(prefix, 0, 1000, 100), 1u);   // documento maior que o alvo
+    EXPECT_EQ(manager.findChunkEnd(prefix, 1, 1000, 100), 5u);   // 3 x 257 + 1000 >= 1000
+    EXPECT_EQ(manager.findChunkEnd(prefix, 1, 1000, 2), 3u);     // limite de documentos
+    EXPECT_EQ(manager.findChunkEnd(prefix, 5, 1000, 100), 6u);   // fim do corpus
+}
+
+// Com muitos documentos, o modo particionado usa num_workers threads e preserva a ordem
+TEST_F(PipelineManagerTest, PartitionedClaimsChunksDynamically) {
+    config.num_workers = 3;
+    PipelineManager manager(config);
+
+    std::vector<std::string> corpus;
+    for (int i = 0; i < 400; ++i) {
+        corpus.push_back(test_data[i % test_data.size()] + " número " + std::to_string(i));
+    }
+
+    auto result = manager.runParallelPartitioned(corpus);
+    ASSERT_TRUE(result.success) << result.error_message;
+    EXPECT_EQ(result.processed_data, manager.runSequential(corpus, true).processed_data);
+    EXPECT_EQ(result.tasks_completed % 8, 0u);
+    EXPECT_GE(result.tasks_completed, 8u * 3u);
+    EXPECT_GE(result.load_imbalance, 1.0);
+    EXPECT_LE(result.load_imbalance, 3.0);
+    EXPECT_EQ(manager.getExecutionStats().at("partitioned_load_imbalance"), result.load_imbalance);
+}
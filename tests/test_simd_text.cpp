@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include "../include/utils/simd_text.h"
+#include <vector>
+#include <string>
+#include <random>
+
+/**
+ * @file test_simd_text.cpp
+ * @brief Testes unitários para os kernels de SimdText
+ *
+ * Cada nível suportado pela CPU é comparado com a versão escalar.
+ */
+
+using namespace legal_doc_pipeline::utils;
+
+namespace {
+
+    std::vector<SimdLevel> supportedLevels() {
+        std::vector<SimdLevel> levels = {SimdLevel::SCALAR};
+        if (SimdText::detectLevel() != SimdLevel::SCALAR) levels.push_back(SimdLevel::SSE2);
+        if (SimdText::detectLevel() == SimdLevel::AVX2) levels.push_back(SimdLevel::AVX2);
+        return levels;
+    }
+
+    /**
+     * @brief Gera texto aleatório rico em maiúsculas ASCII/Latin-1 e bytes limítrofes
+     */
+    std::string randomText(std::mt19937& rng, size_t length) {
+        const std::vector<std::string> pieces = {
+            "A", "Z", "a", "@", "[", "`", "{", " ", "\xC3", "\xC3\x80", "\xC3\x87", "\xC3\x97",
+            "\xC3\x9E", "\xC3\x9F", "\xC3\xA0", "\x80", "\x9E", "\xC2\x80", "\xC4\x80", "0", "9"
+        };
+        std::uniform_int_distribution<size_t> pick(0, pieces.size() - 1);
+        std::string text;
+        while (text.size() < length) {
+            text += pieces[pick(rng)];
+        }
+        text.resize(length);
+        return text;
+    }
+
+} // namespace
+
+// Teste de conversão de maiúsculas acentuadas
+TEST(SimdTextTest, LowercasesAsciiAndLatin1) {
+    std::string text = "PROCESSO Nº 123 - AÇÃO CÍVEL ÀÉÎÕÜ ÇÑ Þ × ß ÿ Ā";
+    SimdText::toLowerInPlace(text);
+    EXPECT_EQ(text, "processo nº 123 - ação cível àéîõü çñ þ × ß ÿ Ā");
+
+    std::string empty;
+    SimdText::toLowerInPlace(empty);
+    EXPECT_TRUE(empty.empty());
+}
+
+// Teste de equivalência dos níveis de SIMD na conversão para minúsculas
+TEST(SimdTextTest, LowercaseLevelsMatchScalar) {
+    std::mt19937 rng(7);
+    for (size_t length = 0; length < 300; length += 7) {
+        std::string original = randomText(rng, length);
+        std::string expected = original;
+        SimdText::toLowerInPlace(&expected[0], expected.size(), SimdLevel::SCALAR);
+
+        for (SimdLevel level : supportedLevels()) {
+            std::string actual = original;
+            SimdText::toLowerInPlace(&actual[0], actual.size(), level);
+            EXPECT_EQ(actual, expected) << "nível " << SimdText::levelName(level)
+                                        << ", tamanho " << length;
+        }
+    }
+}
+
+// Teste do classificador de bytes de palavra
+TEST(SimdTextTest, WordByteClassification) {
+    for (int c = 0; c < 256; ++c) {
+        bool expected = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                        (c >= '0' && c <= '9') || (c >= 0x80 && c <= 0xC3);
+        EXPECT_EQ(SimdText::isWordByte(static_cast<unsigned char>(c)), expected) << "byte " << c;
+    }
+}
+
+// Teste de equivalência dos níveis de SIMD na contagem de bytes de palavra
+TEST(SimdTextTest, WordRunLengthLevelsMatchScalar) {
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> byte(0, 255);
+    for (size_t run = 0; run < 80; ++run) {
+        // Palavra de tamanho 'run' seguida de um byte qualquer
+        std::string text = randomText(rng, run);
+        for (char& c : text) {
+            if (!SimdText::isWordByte(static_cast<unsigned char>(c))) c = 'x';
+        }
+        text += static_cast<char>(byte(rng));
+        text += "resto";
+
+        size_t expected = SimdText::wordRunLength(text.data(), text.size(), SimdLevel::SCALAR);
+        EXPECT_GE(expected, run);
+        for (SimdLevel level : supportedLevels()) {
+            EXPECT_EQ(SimdText::wordRunLength(text.data(), text.size(), level), expected)
+                << "nível " << SimdText::levelName(level) << ", palavra de " << run;
+        }
+    }
+    EXPECT_EQ(SimdText::wordRunLength("", 0), 0u);
+}
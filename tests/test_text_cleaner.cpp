@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "../include/pipeline/text_cleaner.h"
+#include "../include/utils/csv_reader.h"
+#include <vector>
+#include <string>
+#include <random>
+
+/**
+ * @file test_text_cleaner.cpp
+ * @brief Testes unitários para a classe TextCleaner
+ *
+ * O scanner de passada única deve produzir exatamente a mesma saída que a
+ * cadeia de regex original (TextCleaner::cleanWithRegex).
+ */
+
+using namespace legal_doc_pipeline::pipeline;
+
+namespace {
+
+    void expectSameAsRegex(const std::string& input) {
+        std::string expected = input;
+        TextCleaner::cleanWithRegex(expected);
+        EXPECT_EQ(TextCleaner::clean(input), expected) << "Entrada: \"" << input << "\"";
+    }
+
+} // namespace
+
+// Teste de casos básicos
+TEST(TextCleanerTest, BasicCleaning) {
+    EXPECT_EQ(TextCleaner::clean("<p>Olá, mundo!</p>"), "Olá mundo");
+    EXPECT_EQ(TextCleaner::clean("  várias    palavras\t\n aqui  "), "várias palavras aqui");
+    EXPECT_EQ(TextCleaner::clean(""), "");
+    EXPECT_EQ(TextCleaner::clean("   "), "");
+}
+
+// Teste de casos de borda da cadeia de regex
+TEST(TextCleanerTest, EdgeCasesMatchRegex) {
+    const std::vector<std::string> cases = {
+        "<html><body>Texto com HTML &amp; caracteres especiais!</body></html>",
+        "Texto com acentos: ção, não, coração, pão, ÀÉÎÕÜ ñ ÿ",
+        "&amp;lt;b&amp;gt; encadeadas &amp;quot;x&amp;apos; &amp;nbsp;fim",
+        "&amp;amp;lt; dupla &lt;b&gt; &quot;aspas&quot; &apos;x&apos; a&nbsp;b",
+        "&amp &lt &gt; &; && &amp;&amp; &",
+        "tag aberta < sem fim e outra <b>fechada</b>",
+        "tag <quebrada\n em linhas> resto <ok\r> x <a<b>c>",
+        "<<>> <> <a>>b<<c>",
+        "\xC4\x80 \xE2\x80\x9C aspas tipográficas \xE2\x80\x9D \xF0\x9F\x98\x80 emoji",
+        "\x7F\x01\x1F\x0B\x0C\xA0\xC3\xBF\xBF\xC4",
+        "números 123 e símbolos @#$%^&*()_+-=[]{}|;:,.<>?/~`",
+        std::string("com\0nulo", 8),
+        "<",
+        "&",
+        ">texto<"
+    };
+    for (const auto& input : cases) {
+        expectSameAsRegex(input);
+    }
+}
+
+// Teste diferencial com entradas aleatórias
+TEST(TextCleanerTest, RandomInputsMatchRegex) {
+    const std::vector<std::string> fragments = {
+        "<", ">", "&", ";", "amp;", "lt;", "gt;", "quot;", "apos;", "nbsp;", "&amp;",
+        " ", "  ", "\t", "\n", "\r", "\v", "a", "Z", "9", "ç", "ÿ", "\xC4", "\x80",
+        "<b>", "</p>", "!", "-", "texto", "\xE2\x80\x94"
+    };
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> pick(0, fragments.size() - 1);
+    std::uniform_int_distribution<int> length(0, 24);
+    std::uniform_int_distribution<int> byte(0, 255);
+
+    for (int round = 0; round < 2000; ++round) {
+        std::string input;
+        int parts = length(rng);
+        for (int p = 0; p < parts; ++p) {
+            // Mistura fragmentos estruturados com bytes arbitrários
+            if (p % 5 == 4) {
+                input += static_cast<char>(byte(rng));
+            } else {
+                input += fragments[pick(rng)];
+            }
+        }
+        expectSameAsRegex(input);
+    }
+}
+
+// Teste diferencial com os documentos reais de teste
+TEST(TextCleanerTest, RealDocumentsMatchRegex) {
+    legal_doc_pipeline::utils::CsvReader csv_reader;
+    auto texts = csv_reader.readColumn("tests/test_docs.csv", "Texto", ';');
+    ASSERT_FALSE(texts.empty());
+    for (const auto& text : texts) {
+        expectSameAsRegex(text);
+    }
+}
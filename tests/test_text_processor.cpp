@@ -1,7 +1,13 @@
 #include <gtest/gtest.h>
 #include "../include/pipeline/text_processor.h"
+#include "../include/utils/arena_resource.h"
+#include <algorithm>
+#include <cstdlib>
+#include <stdlib.h>
+#include <new>
 #include <vector>
 #include <string>
+#include <regex>
 
 /**
  * @file test_text_processor.cpp
@@ -10,6 +16,85 @@
 
 using namespace legal_doc_pipeline::pipeline;
 
+namespace {
+
+    thread_local bool counting_allocations = false;  ///< Liga a contagem na thread atual
+    thread_local size_t counted_allocations = 0;     ///< Chamadas ao operator new contadas
+
+    void* countedAllocate(std::size_t size, std::size_t alignment) {
+        if (counting_allocations) {
+            ++counted_allocations;
+        }
+        void* pointer = nullptr;
+        if (posix_memalign(&pointer, std::max(alignment, sizeof(void*)), size == 0 ? 1 : size) == 0) {
+            return pointer;
+        }
+        throw std::bad_alloc();
+    }
+
+    /**
+     * @brief Conta as alocações do heap feitas pela thread atual durante fn
+     */
+    template <typename Function>
+    size_t countAllocations(Function fn) {
+        counted_allocations = 0;
+        counting_allocations = true;
+        fn();
+        counting_allocations = false;
+        return counted_allocations;
+    }
+
+} // namespace
+
+// Alocador global contador: só registra chamadas dentro de countAllocations
+void* operator new(std::size_t size) {
+    return countedAllocate(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size) {
+    return countedAllocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return countedAllocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return countedAllocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept {
+    std::free(pointer);
+}
+
 class TextProcessorTest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -66,6 +151,19 @@ TEST_F(TextProcessorTest, NormalizeTextConvertsToLowercase) {
     EXPECT_TRUE(test_texts[4].find("ção") != std::string::npos);
 }
 
+// Teste de minúsculas em maiúsculas acentuadas (UTF-8 Latin-1)
+TEST_F(TextProcessorTest, NormalizeTextLowercasesAccentedCapitals) {
+    std::vector<std::string> texts = {"AÇÃO CÍVEL PÚBLICA", "ÉTICA E JURISPRUDÊNCIA × ÔNUS"};
+    std::vector<std::string> sequential = texts;
+
+    TextProcessor::normalizeText(texts);
+    TextProcessor::normalizeTextSequential(sequential);
+
+    EXPECT_EQ(texts[0], "ação cível pública");
+    EXPECT_EQ(texts[1], "ética e jurisprudência × ônus");
+    EXPECT_EQ(texts, sequential);
+}
+
 // Teste da função wordTokenization
 TEST_F(TextProcessorTest, WordTokenizationSeparatesWords) {
     TextProcessor::wordTokenization(test_texts);
@@ -78,6 +176,27 @@ TEST_F(TextProcessorTest, WordTokenizationSeparatesWords) {
     EXPECT_TRUE(test_texts[5].empty());
 }
 
+// Teste de equivalência do tokenizador com a expressão regular original
+TEST_F(TextProcessorTest, WordTokenizationMatchesRegex) {
+    std::regex word_punct_regex("[a-zA-Z0-9À-ÿ]+|[.,!?;:\"'()\\[\\]{}]",
+                                std::regex::ECMAScript | std::regex::collate);
+    std::vector<std::string> inputs = test_texts;
+    inputs.push_back("art. 5º, §2º (LEI nº 8.078/90) {x} [y] \"z\" 'w' ... ?!;:");
+    inputs.push_back("\xC4\x80" "palavra\xC3\xBF\xE2\x80\x94" "fim \t\n-- a_b c-d");
+
+    std::vector<std::string> tokenized = inputs;
+    TextProcessor::wordTokenization(tokenized);
+
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        std::string expected;
+        for (std::sregex_iterator it(inputs[i].begin(), inputs[i].end(), word_punct_regex), last;
+             it != last; ++it) {
+            expected += (expected.empty() ? "" : " ") + it->str();
+        }
+        EXPECT_EQ(tokenized[i], expected) << "Entrada: \"" << inputs[i] << "\"";
+    }
+}
+
 // Teste sequencial das três primeiras funções
 TEST_F(TextProcessorTest, SequentialProcessing) {
     std::vector<std::string> sequential_texts = test_texts;
@@ -256,3 +375,152 @@ TEST_F(TextProcessorTest, GenerateEmbeddings) {
                    !text.empty());
     }
 }
+
+// Teste de equivalência entre as variantes por intervalo e as versões completas
+TEST_F(TextProcessorTest, RangeVariantsMatchWholeVector) {
+    std::vector<std::string> whole = test_texts;
+    std::vector<std::string> ranged = test_texts;
+
+    TextProcessor::cleanText(whole);
+    TextProcessor::normalizeText(whole);
+    TextProcessor::wordTokenization(whole);
+    TextProcessor::partitionTokens(whole, 4);
+    TextProcessor::addSpecialTokens(whole);
+
+    // Processa em intervalos de tamanhos diferentes, como o scheduler faria
+    const size_t split = ranged.size() / 3;
+    for (size_t begin : {size_t{0}, split}) {
+        size_t end = (begin == 0) ? split : ranged.size();
+        TextProcessor::cleanTextRange(ranged, begin, end);
+        TextProcessor::normalizeTextRange(ranged, begin, end);
+        TextProcessor::wordTokenizationRange(ranged, begin, end);
+        TextProcessor::partitionTokensRange(ranged, begin, end, 4);
+        TextProcessor::addSpecialTokensRange(ranged, begin, end);
+    }
+
+    EXPECT_EQ(whole, ranged);
+}
+
+// Saídas exatas das etapas reescritas para trabalhar no próprio buffer
+TEST_F(TextProcessorTest, PartitionAndSpecialTokensExactOutput) {
+    std::vector<std::string> token_texts = {
+        "  a   b c d  ",
+        "a b",
+        "[CLS] x y z [SEP]",
+        "",
+        "meio [EOF] fim",
+        "[CLS] com [SEP]"
+    };
+    TextProcessor::partitionTokens(token_texts, 3);
+    EXPECT_EQ(token_texts[0], "a b c");
+    EXPECT_EQ(token_texts[1], "a b");
+    EXPECT_EQ(token_texts[2], "[CLS] x y");
+    EXPECT_EQ(token_texts[3], "");
+
+    TextProcessor::addSpecialTokens(token_texts);
+    EXPECT_EQ(token_texts[0], "[CLS] a b c [SEP] [EOF]");
+    EXPECT_EQ(token_texts[1], "[CLS] a b [SEP] [EOF]");
+    EXPECT_EQ(token_texts[2], "[CLS] x y [SEP] [EOF]");
+    EXPECT_EQ(token_texts[3], "[CLS]  [SEP] [EOF]");
+    EXPECT_EQ(token_texts[4], "[CLS] meio [SEP] [EOF] fim");
+    EXPECT_EQ(token_texts[5], "[CLS] com [SEP] [EOF]");
+
+    std::vector<std::string> indices = {"[CLS] o  processo desconhecido [SEP]"};
+    TextProcessor::tokensToIndices(indices);
+    EXPECT_EQ(indices[0], "101 1 18 0 102");
+
+    TextProcessor::generateEmbeddingsRange(indices, 0, 1, 41);
+    EXPECT_EQ(indices[0], "EMBEDDED_DOCUMENT_42");
+}
+
+// Em regime, com textos e documentos reaproveitados entre lotes, as etapas não alocam
+TEST_F(TextProcessorTest, SteadyStateStagesDoNotAllocate) {
+    const std::vector<std::string> templates = {
+        "<p>O Tribunal de Justiça julgou o processo n. 1.234/2020, nos termos do artigo 5 do Código Civil.</p>",
+        "CONTRATO DE LOCAÇÃO &amp; ADITIVO: as partes acordam que o valor será R$ 1.500,00 (mil e quinhentos).",
+        "A lei penal não retroage, salvo para beneficiar o réu; inconstitucionalidade e responsabilização nos documentos jurídicos anexos.",
+        "Sumarização do documento: fluxo de tarefas para apresentar dados do processo ao tribunal."
+    };
+    std::vector<std::string> batch;
+    for (size_t i = 0; i < 32; ++i) {
+        batch.push_back(templates[i % templates.size()] + " Documento " + std::to_string(i) + ".");
+    }
+    const size_t count = batch.size();
+    const size_t max_length = 24;
+
+    auto runStringStages = [&](std::vector<std::string>& texts) {
+        TextProcessor::cleanTextRange(texts, 0, count);
+        TextProcessor::normalizeTextRange(texts, 0, count);
+        TextProcessor::wordTokenizationRange(texts, 0, count);
+        TextProcessor::bpeTokenizationRange(texts, 0, count);
+        TextProcessor::partitionTokensRange(texts, 0, count, max_length);
+        TextProcessor::addSpecialTokensRange(texts, 0, count);
+        TextProcessor::tokensToIndicesRange(texts, 0, count);
+        TextProcessor::generateEmbeddingsRange(texts, 0, count);
+    };
+    auto runTypedStages = [&](std::vector<std::string>& texts, std::vector<TokenizedDocument>& documents) {
+        TextProcessor::cleanTextRange(texts, 0, count);
+        TextProcessor::normalizeTextRange(texts, 0, count);
+        TextProcessor::wordTokenizationRange(texts, documents, 0, count);
+        TextProcessor::bpeTokenizationRange(documents, 0, count);
+        TextProcessor::partitionTokensRange(documents, 0, count, max_length);
+        TextProcessor::addSpecialTokensRange(documents, 0, count);
+        TextProcessor::tokensToIndicesRange(documents, 0, count);
+        TextProcessor::generateEmbeddingsRange(texts, 0, count);
+    };
+    // Novo lote nos mesmos textos: assign reaproveita a capacidade de cada string
+    auto refill = [&](std::vector<std::string>& texts, size_t round) {
+        for (size_t i = 0; i < count; ++i) {
+            texts[i].assign(batch[(i + round) % count]);
+        }
+    };
+
+    // Aquecimento: buffers por thread, vocabulário, tokenizador e capacidade dos textos
+    std::vector<std::string> texts = batch;
+    std::vector<std::string> expected = batch;
+    runStringStages(expected);
+    for (size_t round = 0; round < count; ++round) {
+        refill(texts, round);
+        runStringStages(texts);
+    }
+    for (size_t round = 1; round <= 3; ++round) {
+        refill(texts, round);
+        EXPECT_EQ(countAllocations([&]() { runStringStages(texts); }), 0u) << "lote " << round;
+    }
+    refill(texts, 0);
+    runStringStages(texts);
+    EXPECT_EQ(texts, expected);
+
+    // Variante tipada com documentos reaproveitados no recurso padrão
+    std::vector<TokenizedDocument> documents(count);
+    for (size_t round = 0; round < count; ++round) {
+        refill(texts, round);
+        runTypedStages(texts, documents);
+    }
+    for (size_t round = 1; round <= 3; ++round) {
+        refill(texts, round);
+        EXPECT_EQ(countAllocations([&]() { runTypedStages(texts, documents); }), 0u) << "lote " << round;
+    }
+
+    // Variante tipada na arena por lote: documentos e arena liberados a cada lote
+    legal_doc_pipeline::utils::ArenaResource arena;
+    std::vector<TokenizedDocument> arena_documents;
+    for (size_t i = 0; i < count; ++i) {
+        arena_documents.emplace_back(&arena);
+    }
+    auto runArenaBatch = [&]() {
+        runTypedStages(texts, arena_documents);
+        for (auto& document : arena_documents) {
+            document.releaseMemory();
+        }
+        arena.release();
+    };
+    for (size_t round = 0; round < count; ++round) {
+        refill(texts, round);
+        runArenaBatch();
+    }
+    for (size_t round = 1; round <= 3; ++round) {
+        refill(texts, round);
+        EXPECT_EQ(countAllocations(runArenaBatch), 0u) << "lote " << round;
+    }
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include "../include/utils/thread_pool.h"
+#include <atomic>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @file test_thread_pool.cpp
+ * @brief Testes unitários para o ThreadPool persistente
+ */
+
+using namespace legal_doc_pipeline::utils;
+
+// Cada índice do lote é executado exatamente uma vez
+TEST(ThreadPoolTest, RunBatchCoversEveryIndex) {
+    ThreadPoolOptions options;
+    options.num_threads = 4;
+    ThreadPool pool(options);
+    EXPECT_EQ(pool.size(), 4u);
+
+    std::vector<std::atomic<int>> hits(1000);
+    pool.runBatch(hits.size(), [&hits](size_t i) { hits[i]++; });
+    for (const auto& hit : hits) {
+        EXPECT_EQ(hit.load(), 1);
+    }
+
+    pool.runBatch(0, [](size_t) { FAIL(); });
+}
+
+// As mesmas threads atendem lotes sucessivos
+TEST(ThreadPoolTest, ReusesThreadsAcrossBatches) {
+    ThreadPoolOptions options;
+    options.num_threads = 2;
+    ThreadPool pool(options);
+
+    std::mutex ids_mutex;
+    std::set<std::thread::id> ids;
+    for (int batch = 0; batch < 50; ++batch) {
+        pool.runBatch(8, [&](size_t) {
+            std::lock_guard<std::mutex> lock(ids_mutex);
+            ids.insert(std::this_thread::get_id());
+        });
+    }
+    EXPECT_LE(ids.size(), 2u);
+    EXPECT_EQ(ids.count(std::this_thread::get_id()), 0u);
+}
+
+// A primeira exceção é relançada depois que o lote inteiro termina
+TEST(ThreadPoolTest, PropagatesExceptionAfterBatch) {
+    ThreadPoolOptions options;
+    options.num_threads = 3;
+    ThreadPool pool(options);
+
+    std::atomic<int> finished(0);
+    EXPECT_THROW(pool.runBatch(20, [&finished](size_t i) {
+        if (i == 7) {
+            throw std::runtime_error("falha no job");
+        }
+        finished++;
+    }), std::runtime_error);
+    EXPECT_EQ(finished.load(), 19);
+
+    // O pool continua utilizável
+    std::atomic<int> after(0);
+    pool.runBatch(5, [&after](size_t) { after++; });
+    EXPECT_EQ(after.load(), 5);
+}
+
+// Espera ativa e fixação em CPU não alteram o resultado
+TEST(ThreadPoolTest, SpinningAndPinnedThreads) {
+    ThreadPoolOptions options;
+    options.num_threads = 2;
+    options.spin_iterations = 2000;
+    options.pin_threads = true;
+    std::atomic<size_t> sum(0);
+    {
+        ThreadPool pool(options);
+        for (int batch = 0; batch < 100; ++batch) {
+            pool.runBatch(4, [&sum](size_t i) { sum += i; });
+        }
+        EXPECT_LE(pool.pinnedThreadCount(), pool.size());
+    }
+    EXPECT_EQ(sum.load(), 100u * 6u);
+}
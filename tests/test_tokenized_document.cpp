@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include "../include/pipeline/tokenized_document.h"
+#include "../include/pipeline/text_processor.h"
+#include <vector>
+#include <string>
+
+/**
+ * @file test_tokenized_document.cpp
+ * @brief Testes unitários para TokenizedDocument e as etapas tipadas
+ */
+
+using namespace legal_doc_pipeline::pipeline;
+
+TEST(TokenizedDocumentTest, AddInsertAndTruncate) {
+    TokenizedDocument document;
+    EXPECT_TRUE(document.empty());
+
+    document.addToken("contrato");
+    document.addToken("de");
+    document.addToken("locação");
+    document.insertToken(0, "[CLS]");
+    document.insertToken(document.size(), "[SEP]");
+
+    ASSERT_EQ(document.size(), 5u);
+    EXPECT_EQ(document.token(0), "[CLS]");
+    EXPECT_EQ(document.token(3), "locação");
+    EXPECT_EQ(document.findToken("de"), 2u);
+    EXPECT_EQ(document.findToken("ausente"), document.size());
+    EXPECT_EQ(document.toString(), "[CLS] contrato de locação [SEP]");
+
+    document.truncate(2);
+    EXPECT_EQ(document.toString(), "[CLS] contrato");
+
+    document.clear();
+    EXPECT_TRUE(document.empty());
+    EXPECT_TRUE(document.getIds().empty());
+}
+
+TEST(TokenizedDocumentTest, StringRoundTrip) {
+    TokenizedDocument document = TokenizedDocument::fromString("  a  bc\td\n");
+    ASSERT_EQ(document.size(), 3u);
+    EXPECT_EQ(document.toString(), "a bc d");
+
+    document.mutableIds() = {1, 22, 333};
+    EXPECT_EQ(document.idsToString(), "1 22 333");
+
+    TokenizedDocument other;
+    other.swap(document);
+    EXPECT_TRUE(document.empty());
+    EXPECT_EQ(other.size(), 3u);
+}
+
+TEST(TokenizedDocumentTest, AssignKeepsResourceAndCapacity) {
+    std::pmr::monotonic_buffer_resource resource;
+    TokenizedDocument target(&resource);
+    TokenizedDocument source = TokenizedDocument::fromString("[CLS] contrato de locação [SEP]");
+    source.mutableIds() = {101, 1, 2, 3, 102};
+
+    target.assign(source);
+    EXPECT_EQ(target.memoryResource(), &resource);
+    EXPECT_EQ(target.toString(), source.toString());
+    EXPECT_EQ(target.idsToString(), "101 1 2 3 102");
+
+    // Conteúdo menor cabe nos buffers atuais; a origem continua intacta
+    const char* pool_before = target.token(0).data();
+    TokenizedDocument shorter = TokenizedDocument::fromString("a b");
+    target.assign(shorter);
+    EXPECT_EQ(target.toString(), "a b");
+    EXPECT_TRUE(target.getIds().empty());
+    EXPECT_EQ(target.token(0).data(), pool_before);
+    EXPECT_EQ(source.size(), 5u);
+}
+
+// As etapas tipadas devem produzir o mesmo resultado que as versões em string
+TEST(TokenizedDocumentTest, TypedStagesMatchStringStages) {
+    std::vector<std::string> texts = {
+        "<p>Contrato de locação &amp; aditivo.</p>",
+        "Art. 5º, inciso II: ninguém será obrigado!",
+        "",
+        "palavra",
+        "Valor: R$ 1.234,56 (um mil)"
+    };
+    TextProcessor::cleanText(texts);
+    TextProcessor::normalizeText(texts);
+
+    const size_t count = texts.size();
+    std::vector<TokenizedDocument> documents(count);
+    TextProcessor::wordTokenizationRange(texts, documents, 0, count);
+
+    std::vector<std::string> strings = texts;
+    TextProcessor::wordTokenization(strings);
+    for (size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(documents[i].toString(), strings[i]) << "documento " << i;
+    }
+
+    TextProcessor::bpeTokenization(strings);
+    TextProcessor::partitionTokens(strings, 8);
+    TextProcessor::addSpecialTokens(strings);
+    TextProcessor::bpeTokenizationRange(documents, 0, count);
+    TextProcessor::partitionTokensRange(documents, 0, count, 8);
+    TextProcessor::addSpecialTokensRange(documents, 0, count);
+    for (size_t i = 0; i < count; ++i) {
+        // A versão em string pode deixar espaços repetidos entre os tokens
+        EXPECT_EQ(documents[i].toString(), TokenizedDocument::fromString(strings[i]).toString())
+            << "documento " << i;
+    }
+
+    TextProcessor::tokensToIndices(strings);
+    TextProcessor::tokensToIndicesRange(documents, 0, count);
+    for (size_t i = 0; i < count; ++i) {
+        EXPECT_EQ(documents[i].idsToString(), strings[i]) << "documento " << i;
+    }
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include "../include/utils/trace_recorder.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file test_trace_recorder.cpp
+ * @brief Testes unitários para a linha do tempo em formato Chrome trace
+ */
+
+using namespace legal_doc_pipeline::utils;
+
+namespace {
+
+    size_t countOccurrences(const std::string& text, const std::string& pattern) {
+        size_t count = 0;
+        for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+            ++count;
+        }
+        return count;
+    }
+
+} // namespace
+
+// Cada thread ganha sua própria trilha (tid)
+TEST(TraceRecorderTest, RecordsPerThreadTracks) {
+    TraceRecorder recorder;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 3; ++t) {
+        threads.emplace_back([&recorder]() {
+            for (int i = 0; i < 10; ++i) {
+                int64_t begin = recorder.now();
+                recorder.record("test", "Work", begin, recorder.now(), i, i + 1);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(recorder.eventCount(), 30u);
+    std::string json = recorder.toChromeTraceJson();
+    EXPECT_EQ(json.find("{\"displayTimeUnit\""), 0u);
+    EXPECT_EQ(countOccurrences(json, "\"ph\":\"X\""), 30u);
+    EXPECT_EQ(countOccurrences(json, "\"name\":\"thread_name\""), 3u);
+    for (int tid = 0; tid < 3; ++tid) {
+        EXPECT_EQ(countOccurrences(json, "\"tid\":" + std::to_string(tid) + ",\"ts\""), 10u);
+    }
+    EXPECT_NE(json.find("\"args\":{\"begin\":9,\"end\":10}"), std::string::npos);
+}
+
+// Microssegundos com três casas, nomes escapados e truncados
+TEST(TraceRecorderTest, FormatsEvents) {
+    TraceRecorder recorder;
+    recorder.record("scheduler", "Aspas \"e\" barra \\", 1500, 4000, 2, 5);
+    recorder.record("scheduler", std::string(100, 'n'), 0, 1);
+
+    std::string json = recorder.toChromeTraceJson();
+    EXPECT_NE(json.find("\"name\":\"Aspas \\\"e\\\" barra \\\\\",\"cat\":\"scheduler\""), std::string::npos);
+    EXPECT_NE(json.find("\"ts\":1.500,\"dur\":2.500"), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"" + std::string(TraceEvent::NAME_CAPACITY, 'n') + "\""), std::string::npos);
+}
+
+// Buffer cheio descarta e conta; clear mantém os buffers registrados
+TEST(TraceRecorderTest, DropsWhenFullAndClears) {
+    TraceRecorder recorder(4);
+    for (int i = 0; i < 10; ++i) {
+        recorder.record("test", "Item", i, i + 1);
+    }
+    EXPECT_EQ(recorder.eventCount(), 4u);
+    EXPECT_EQ(recorder.droppedEvents(), 6u);
+
+    recorder.clear();
+    EXPECT_EQ(recorder.eventCount(), 0u);
+    EXPECT_EQ(recorder.droppedEvents(), 0u);
+    recorder.record("test", "Item", 0, 1);
+    EXPECT_EQ(recorder.eventCount(), 1u);
+}
+
+// A mesma thread alternando entre gravadores grava em cada um
+TEST(TraceRecorderTest, SeparatesRecorders) {
+    TraceRecorder first;
+    TraceRecorder second;
+    first.record("test", "A", 0, 1);
+    second.record("test", "B", 0, 1);
+    first.record("test", "C", 0, 1);
+    EXPECT_EQ(first.eventCount(), 2u);
+    EXPECT_EQ(second.eventCount(), 1u);
+}
+
+TEST(TraceRecorderTest, ScopeAndFileExport) {
+    TraceRecorder recorder;
+    {
+        TraceScope scope(&recorder, "test", "Scope", 3, 7);
+        TraceScope disabled(nullptr, "test", "Nada");
+    }
+    EXPECT_EQ(recorder.eventCount(), 1u);
+
+    const std::string path = "test_trace_output.json";
+    ASSERT_TRUE(recorder.writeChromeTrace(path));
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    EXPECT_EQ(contents.str(), recorder.toChromeTraceJson());
+    std::remove(path.c_str());
+
+    EXPECT_FALSE(recorder.writeChromeTrace("/diretorio_inexistente/trace.json"));
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include "../include/scheduler/workflow_scheduler.h"
 #include "../include/types.h"
+#include "../include/utils/thread_pool.h"
 #include <vector>
 #include <string>
 #include <atomic>
@@ -263,3 +264,361 @@ TEST_F(WorkflowSchedulerTest, NonExistentDependency) {
     bool success = scheduler->run(test_data, 1);
     EXPECT_FALSE(success);
 }
+
+// Teste de dependências no modo work-stealing
+TEST_F(WorkflowSchedulerTest, WorkStealingRunsTasksWithDependencies) {
+    WorkflowScheduler stealing_scheduler(SchedulingMode::WORK_STEALING);
+    EXPECT_EQ(stealing_scheduler.getSchedulingMode(), SchedulingMode::WORK_STEALING);
+
+    stealing_scheduler.addTask(Task("TaskA", TaskType::TEXT_CLEANING, 10, createTestTask(1)));
+    stealing_scheduler.addTask(Task("TaskB", TaskType::NORMALIZATION, 20, createTestTask(2)));
+    stealing_scheduler.addTask(Task("TaskC", TaskType::WORD_TOKENIZATION, 30, createTestTask(3)));
+    stealing_scheduler.addDependency("TaskB", "TaskA");
+    stealing_scheduler.addDependency("TaskC", "TaskB");
+
+    bool success = stealing_scheduler.run(test_data, 3);
+
+    EXPECT_TRUE(success);
+    EXPECT_EQ(execution_counter.load(), 3);
+    for (const auto& text : stealing_scheduler.getProcessedData()) {
+        size_t pos1 = text.find("[Processado por Task1]");
+        size_t pos2 = text.find("[Processado por Task2]");
+        size_t pos3 = text.find("[Processado por Task3]");
+        ASSERT_NE(pos1, std::string::npos);
+        ASSERT_NE(pos2, std::string::npos);
+        ASSERT_NE(pos3, std::string::npos);
+        EXPECT_LT(pos1, pos2);
+        EXPECT_LT(pos2, pos3);
+    }
+}
+
+// Teste de DAG largo (fan-out/fan-in) no modo work-stealing
+TEST_F(WorkflowSchedulerTest, WorkStealingWideDag) {
+    WorkflowScheduler stealing_scheduler(SchedulingMode::WORK_STEALING);
+    std::atomic<int> leaves_done{0};
+    std::atomic<bool> sink_saw_all_leaves{false};
+    const int width = 50;
+
+    stealing_scheduler.addTask(Task("Source", TaskType::TEXT_CLEANING, 0,
+                                    [](std::vector<std::string>&) {}));
+    stealing_scheduler.addTask(Task("Sink", TaskType::GENERATE_EMBEDDINGS, 100,
+                                    [&](std::vector<std::string>&) {
+                                        sink_saw_all_leaves = (leaves_done.load() == width);
+                                    }));
+    for (int i = 0; i < width; ++i) {
+        std::string id = "Leaf" + std::to_string(i);
+        stealing_scheduler.addTask(Task(id, TaskType::NORMALIZATION, i,
+                                        [&](std::vector<std::string>&) { leaves_done++; }));
+        stealing_scheduler.addDependency(id, "Source");
+        stealing_scheduler.addDependency("Sink", id);
+    }
+
+    EXPECT_TRUE(stealing_scheduler.run(test_data, 4));
+    EXPECT_TRUE(sink_saw_all_leaves.load());
+    EXPECT_EQ(stealing_scheduler.getExecutionStats()["completed_tasks"], static_cast<size_t>(width + 2));
+}
+
+// Fila global: cada folha roda uma vez e o sumidouro só depois de todas
+TEST_F(WorkflowSchedulerTest, GlobalQueueWideDag) {
+    std::atomic<int> leaves_done{0};
+    std::atomic<bool> sink_saw_all_leaves{false};
+    const int width = 50;
+
+    scheduler->addTask(Task("Source", TaskType::TEXT_CLEANING, 0, [](std::vector<std::string>&) {}));
+    scheduler->addTask(Task("Sink", TaskType::GENERATE_EMBEDDINGS, 100,
+                            [&](std::vector<std::string>&) {
+                                sink_saw_all_leaves = (leaves_done.load() == width);
+                            }));
+    for (int i = 0; i < width; ++i) {
+        std::string id = "Leaf" + std::to_string(i);
+        scheduler->addTask(Task(id, TaskType::NORMALIZATION, i,
+                                [&](std::vector<std::string>&) { leaves_done++; }));
+        scheduler->addDependency(id, "Source");
+        scheduler->addDependency("Sink", id);
+    }
+
+    EXPECT_TRUE(scheduler->run(test_data, 4));
+    EXPECT_EQ(leaves_done.load(), width);
+    EXPECT_TRUE(sink_saw_all_leaves.load());
+    EXPECT_EQ(scheduler->getExecutionStats()["completed_tasks"], static_cast<size_t>(width + 2));
+}
+
+// O item repassado ao worker que concluiu a tarefa é o de maior prioridade da fila
+TEST_F(WorkflowSchedulerTest, GlobalQueueHandoffKeepsPriorityOrder) {
+    std::vector<int> order;
+    scheduler->addTask(Task("Source", TaskType::TEXT_CLEANING, 0, [](std::vector<std::string>&) {}));
+    for (int priority : {50, 10, 30}) {
+        std::string id = "P" + std::to_string(priority);
+        scheduler->addTask(Task(id, TaskType::NORMALIZATION, priority,
+                                [&order, priority](std::vector<std::string>&) { order.push_back(priority); }));
+        scheduler->addDependency(id, "Source");
+    }
+
+    EXPECT_TRUE(scheduler->run(test_data, 1));
+    EXPECT_EQ(order, (std::vector<int>{10, 30, 50}));
+}
+
+// API por TaskId: IDs densos na ordem de inserção e arestas sem nomes
+TEST_F(WorkflowSchedulerTest, IntegerTaskIds) {
+    std::vector<int> order;
+    TaskId first = scheduler->addTask(Task("First", TaskType::TEXT_CLEANING, 30,
+                                           [&order](std::vector<std::string>&) { order.push_back(1); }));
+    TaskId second = scheduler->addTask(Task("Second", TaskType::NORMALIZATION, 20,
+                                            [&order](std::vector<std::string>&) { order.push_back(2); }));
+    TaskId third = scheduler->addTask(Task("Third", TaskType::WORD_TOKENIZATION, 10,
+                                           [&order](std::vector<std::string>&) { order.push_back(3); }));
+
+    EXPECT_EQ(first, 0u);
+    EXPECT_EQ(second, 1u);
+    EXPECT_EQ(third, 2u);
+    EXPECT_EQ(scheduler->getTaskId("Second"), second);
+    EXPECT_EQ(scheduler->getTaskId("Inexistente"), INVALID_TASK_ID);
+    EXPECT_EQ(scheduler->addTask(Task("Second", TaskType::NORMALIZATION, 0, createTestTask(9))), second);
+    EXPECT_EQ(scheduler->getTaskCount(), 3u);
+
+    // Prioridades invertidas em relação às dependências: a ordem vem das arestas
+    EXPECT_TRUE(scheduler->addDependency(second, first));
+    EXPECT_TRUE(scheduler->addDependency(third, second));
+    EXPECT_FALSE(scheduler->addDependency(third, static_cast<TaskId>(42)));
+}
+
+// Cadeia longa: a validação iterativa (Kahn) não depende da profundidade do grafo
+TEST_F(WorkflowSchedulerTest, ValidatesLongChainWithoutRecursion) {
+    const TaskId length = 200000;
+    auto noop = [](std::vector<std::string>&) {};
+    TaskId previous = scheduler->addTask(Task("T0", TaskType::TEXT_CLEANING, 0, noop));
+    for (TaskId i = 1; i < length; ++i) {
+        TaskId current = scheduler->addTask(Task("T" + std::to_string(i), TaskType::TEXT_CLEANING, 0, noop));
+        scheduler->addDependency(current, previous);
+        previous = current;
+    }
+    EXPECT_TRUE(scheduler->validateDependencyGraph());
+
+    // Fecha o ciclo no fim da cadeia
+    scheduler->addDependency(0, length - 1);
+    EXPECT_FALSE(scheduler->validateDependencyGraph());
+}
+
+// Um grafo compilado pode ser executado de novo: os contadores partem do grau de entrada
+TEST_F(WorkflowSchedulerTest, RunTwiceResetsDependencyCounters) {
+    std::vector<int> order;
+    TaskId a = scheduler->addTask(Task("A", TaskType::TEXT_CLEANING, 20,
+                                       [&order](std::vector<std::string>&) { order.push_back(1); }));
+    TaskId b = scheduler->addTask(Task("B", TaskType::NORMALIZATION, 10,
+                                       [&order](std::vector<std::string>&) { order.push_back(2); }));
+    scheduler->addDependency(b, a);
+
+    EXPECT_TRUE(scheduler->run(test_data, 2));
+    EXPECT_TRUE(scheduler->run(test_data, 2));
+    EXPECT_EQ(order, (std::vector<int>{1, 2, 1, 2}));
+}
+
+// Grafo congelado: compilado uma vez e executado várias vezes
+TEST_F(WorkflowSchedulerTest, CompileOnceRunMany) {
+    std::atomic<int> runs{0};
+    TaskId a = scheduler->addTask(Task("A", TaskType::TEXT_CLEANING, 10, createTestTask(1)));
+    TaskId b = scheduler->addTask(Task("B", TaskType::NORMALIZATION, 20, createTestTask(2)));
+    TaskId c = scheduler->addTask(Task("C", TaskType::WORD_TOKENIZATION, 30,
+                                       [&runs](std::vector<std::string>&) { runs++; }));
+    scheduler->addDependency(c, b);
+    scheduler->addDependency(b, a);
+
+    EXPECT_FALSE(scheduler->isCompiled());
+    ASSERT_TRUE(scheduler->compile());
+    EXPECT_TRUE(scheduler->isCompiled());
+    EXPECT_EQ(scheduler->getTopologicalOrder(), (std::vector<TaskId>{a, b, c}));
+
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(scheduler->run(test_data, 2));
+        EXPECT_TRUE(scheduler->isCompiled());
+    }
+    EXPECT_EQ(runs.load(), 5);
+
+    // Uma aresta nova descongela o grafo; com ciclo, a compilação falha
+    scheduler->addDependency(a, c);
+    EXPECT_FALSE(scheduler->isCompiled());
+    EXPECT_FALSE(scheduler->compile());
+    EXPECT_FALSE(scheduler->run(test_data, 2));
+}
+
+// Execuções sobre um pool persistente, nos dois modos e com menos threads que workers
+TEST_F(WorkflowSchedulerTest, RunsOnPersistentThreadPool) {
+    utils::ThreadPoolOptions options;
+    options.num_threads = 2;
+    utils::ThreadPool pool(options);
+
+    std::vector<int> order;
+    std::mutex order_mutex;
+    auto record = [&order, &order_mutex](int value) {
+        return [&order, &order_mutex, value](std::vector<std::string>&) {
+            std::lock_guard<std::mutex> lock(order_mutex);
+            order.push_back(value);
+        };
+    };
+    TaskId a = scheduler->addTask(Task("A", TaskType::TEXT_CLEANING, 10, record(1)));
+    TaskId b = scheduler->addTask(Task("B", TaskType::NORMALIZATION, 10, record(2)));
+    TaskId c = scheduler->addTask(Task("C", TaskType::WORD_TOKENIZATION, 10, record(3)));
+    scheduler->addDependency(b, a);
+    scheduler->addDependency(c, b);
+    scheduler->setThreadPool(&pool);
+
+    for (SchedulingMode mode : {SchedulingMode::GLOBAL_QUEUE, SchedulingMode::WORK_STEALING}) {
+        scheduler->setSchedulingMode(mode);
+        for (int workers : {1, 2, 4}) {
+            order.clear();
+            EXPECT_TRUE(scheduler->run(test_data, workers));
+            EXPECT_EQ(order, (std::vector<int>{1, 2, 3}));
+            EXPECT_FALSE(scheduler->isRunning());
+        }
+    }
+}
+
+// num_workers < 1 executa com um worker, com e sem pool, nos dois modos
+TEST_F(WorkflowSchedulerTest, NonPositiveWorkerCountRunsWithOneWorker) {
+    utils::ThreadPoolOptions options;
+    options.num_threads = 1;
+    utils::ThreadPool pool(options);
+
+    std::atomic<int> executions(0);
+    auto count = [&executions](std::vector<std::string>&) { ++executions; };
+    TaskId first = scheduler->addTask(Task("First", TaskType::TEXT_CLEANING, 10, count));
+    TaskId second = scheduler->addTask(Task("Second", TaskType::NORMALIZATION, 10, count));
+    scheduler->addDependency(second, first);
+
+    for (utils::ThreadPool* attached : {static_cast<utils::ThreadPool*>(nullptr), &pool}) {
+        scheduler->setThreadPool(attached);
+        for (SchedulingMode mode : {SchedulingMode::GLOBAL_QUEUE, SchedulingMode::WORK_STEALING}) {
+            scheduler->setSchedulingMode(mode);
+            for (int workers : {0, -3}) {
+                executions = 0;
+                EXPECT_TRUE(scheduler->run(test_data, workers));
+                EXPECT_EQ(executions.load(), 2);
+                EXPECT_EQ(scheduler->getCompletedTaskCount(), 2u);
+            }
+        }
+    }
+}
+
+// Registros por item e percentis por tipo de tarefa
+TEST_F(WorkflowSchedulerTest, RecordsTaskLatencies) {
+    auto sleep_task = [](int milliseconds) {
+        return [milliseconds](std::vector<std::string>&) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+        };
+    };
+    TaskId slow = scheduler->addTask(Task("Slow", TaskType::TEXT_CLEANING, 10, sleep_task(20)));
+    TaskId fast = scheduler->addTask(Task("Fast", TaskType::NORMALIZATION, 10, sleep_task(1)));
+    scheduler->addTask(Task("Ranged", TaskType::WORD_TOKENIZATION, 10,
+                            [](std::vector<std::string>&, size_t, size_t) {}, 1));
+    scheduler->addDependency(fast, slow);
+    scheduler->addDependency("Ranged", "Fast");
+
+    for (SchedulingMode mode : {SchedulingMode::GLOBAL_QUEUE, SchedulingMode::WORK_STEALING}) {
+        scheduler->setSchedulingMode(mode);
+        ASSERT_TRUE(scheduler->run(test_data, 2));
+
+        // Um registro por tarefa comum e um por intervalo da tarefa data-parallel
+        auto records = scheduler->getExecutionRecords();
+        ASSERT_EQ(records.size(), 2 + test_data.size());
+        EXPECT_EQ(records[0].task, slow);
+        EXPECT_EQ(records[1].task, fast);
+        for (const auto& record : records) {
+            EXPECT_LT(record.worker, 2u);
+            EXPECT_GE(record.queueWaitNs(), 0);
+            EXPECT_GE(record.runNs(), 0);
+        }
+        // Fast só fica pronta quando Slow termina
+        EXPECT_GE(records[1].ready_ns, records[0].end_ns);
+
+        auto latencies = scheduler->getTaskLatencyStats();
+        ASSERT_EQ(latencies.size(), 3u);
+        EXPECT_EQ(latencies[TaskType::WORD_TOKENIZATION].run_time.count(), test_data.size());
+        EXPECT_GE(latencies[TaskType::TEXT_CLEANING].run_time.percentile(50.0), 20000000u);
+        EXPECT_LT(latencies[TaskType::NORMALIZATION].run_time.percentile(99.0),
+                  latencies[TaskType::TEXT_CLEANING].run_time.percentile(50.0));
+
+        auto stats = scheduler->getExecutionStats();
+        EXPECT_EQ(stats["latency.WORD_TOKENIZATION.items"], test_data.size());
+        EXPECT_EQ(stats["latency.TEXT_CLEANING.run_p99_ns"], latencies[TaskType::TEXT_CLEANING].run_time.percentile(99.0));
+        EXPECT_LE(stats["latency.NORMALIZATION.queue_wait_p50_ns"], stats["latency.NORMALIZATION.queue_wait_p99_ns"]);
+    }
+}
+
+// Teste da janela de prioridade da deque de roubo
+TEST(WorkStealingQueueTest, PriorityWindowOrdering) {
+    auto noop = [](std::vector<std::string>&) {};
+    Task low("Low", TaskType::TEXT_CLEANING, 30, noop);
+    Task high("High", TaskType::TEXT_CLEANING, 10, noop);
+    Task medium("Medium", TaskType::TEXT_CLEANING, 20, noop);
+
+    WorkStealingQueue queue(8);
+    queue.push({&low, 0, 0});
+    queue.push({&high, 0, 0});
+    queue.push({&medium, 0, 0});
+    EXPECT_EQ(queue.size(), 3u);
+
+    WorkItem item;
+    ASSERT_TRUE(queue.pop(item));
+    EXPECT_EQ(item.task->id, "High");
+    ASSERT_TRUE(queue.steal(item));
+    EXPECT_EQ(item.task->id, "Medium");
+    ASSERT_TRUE(queue.pop(item));
+    EXPECT_EQ(item.task->id, "Low");
+    EXPECT_FALSE(queue.pop(item));
+    EXPECT_FALSE(queue.steal(item));
+    EXPECT_TRUE(queue.empty());
+}
+
+// Teste de tarefa data-parallel: intervalos cobrem cada documento uma única vez
+// e a tarefa dependente só executa após a junção de todos os intervalos
+TEST_F(WorkflowSchedulerTest, DataParallelTaskCoversEachDocumentOnce) {
+    for (SchedulingMode mode : {SchedulingMode::GLOBAL_QUEUE, SchedulingMode::WORK_STEALING}) {
+        WorkflowScheduler dp_scheduler(mode);
+        std::vector<std::string> docs(103, "doc");
+        std::atomic<int> ranges_executed{0};
+        std::atomic<bool> join_respected{true};
+
+        dp_scheduler.addTask(Task("Split", TaskType::TEXT_CLEANING, 10,
+            [&](std::vector<std::string>& texts, size_t begin, size_t end) {
+                ranges_executed++;
+                for (size_t i = begin; i < end; ++i) {
+                    texts[i] += "+A";
+                }
+            }, 10));
+        dp_scheduler.addTask(Task("After", TaskType::NORMALIZATION, 20,
+            [&](std::vector<std::string>& texts, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    if (texts[i] != "doc+A") {
+                        join_respected = false;
+                    }
+                    texts[i] += "+B";
+                }
+            }, 7));
+        dp_scheduler.addDependency("After", "Split");
+
+        ASSERT_TRUE(dp_scheduler.run(docs, 4));
+        EXPECT_TRUE(join_respected.load());
+        EXPECT_EQ(ranges_executed.load(), 11);  // ceil(103 / 10)
+
+        const auto& processed = dp_scheduler.getProcessedData();
+        ASSERT_EQ(processed.size(), docs.size());
+        for (const auto& text : processed) {
+            EXPECT_EQ(text, "doc+A+B");
+        }
+        EXPECT_EQ(dp_scheduler.getExecutionStats()["completed_tasks"], 2u);
+    }
+}
+
+// Teste de granularidade automática (grain_size = 0)
+TEST_F(WorkflowSchedulerTest, DataParallelAutomaticGrain) {
+    std::vector<std::string> docs(40, "x");
+    std::atomic<size_t> covered{0};
+
+    scheduler->addTask(Task("Auto", TaskType::TEXT_CLEANING, 10,
+        [&](std::vector<std::string>&, size_t begin, size_t end) {
+            covered += end - begin;
+        }));
+
+    ASSERT_TRUE(scheduler->run(docs, 2));
+    EXPECT_EQ(covered.load(), docs.size());
+}
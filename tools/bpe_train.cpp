@@ -0,0 +1,71 @@
+#include "../include/tokenizer/bpe_model.h"
+#include "../include/pipeline/text_cleaner.h"
+#include "../include/utils/csv_reader.h"
+#include "../include/utils/simd_text.h"
+#include "../include/utils/timer.h"
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+/**
+ * @file bpe_train.cpp
+ * @brief Treina o vocabulário BPE (vocab.txt e merges.txt) a partir do corpus
+ *
+ * O texto passa pela mesma limpeza e normalização do pipeline (CleanText e
+ * NormalizeText) e é separado em palavras como na WordTokenization; o BPE é
+ * treinado sobre a contagem dessas palavras.
+ *
+ * Uso: bpe_train [arquivo.csv] [coluna] [tamanho do vocabulário] [vocab.txt] [merges.txt]
+ */
+
+using namespace legal_doc_pipeline;
+
+int main(int argc, char** argv) {
+    std::string csv_file = argc > 1 ? argv[1] : "docs.csv";
+    std::string column = argc > 2 ? argv[2] : "Texto";
+    size_t vocab_size = argc > 3 ? static_cast<size_t>(std::atol(argv[3])) : 8000;
+    std::string vocab_path = argc > 4 ? argv[4] : "vocab.txt";
+    std::string merges_path = argc > 5 ? argv[5] : "merges.txt";
+
+    utils::CsvReader csv_reader;
+    std::map<std::string, size_t> word_counts;
+    size_t documents = csv_reader.forEachValue(csv_file, column, [&word_counts](std::string& text) {
+        pipeline::TextCleaner::cleanInPlace(text);
+        utils::SimdText::toLowerInPlace(text);
+        size_t pos = 0;
+        while (pos < text.size()) {
+            size_t run = utils::SimdText::wordRunLength(text.data() + pos, text.size() - pos);
+            if (run == 0) {
+                ++pos;
+                continue;
+            }
+            ++word_counts[text.substr(pos, run)];
+            pos += run;
+        }
+    });
+
+    if (word_counts.empty()) {
+        std::cerr << "Erro: nenhuma palavra lida de '" << csv_file << "'" << std::endl;
+        return 1;
+    }
+
+    utils::Timer timer;
+    timer.start();
+    std::vector<std::string> vocab;
+    std::vector<std::pair<std::string, std::string>> merges;
+    hf_tokenizers::BpeModel::train(word_counts, vocab_size, {"[UNK]", "[CLS]", "[SEP]", "[EOF]"}, vocab, merges);
+    timer.stop();
+
+    if (!hf_tokenizers::BpeModel::save(vocab_path, merges_path, vocab, merges)) {
+        std::cerr << "Erro ao gravar '" << vocab_path << "' ou '" << merges_path << "'" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Corpus: " << documents << " documentos, " << word_counts.size() << " palavras distintas" << std::endl;
+    std::cout << "Vocabulário: " << vocab.size() << " tokens, " << merges.size() << " merges ("
+              << timer.getElapsedMilliseconds() << " ms)" << std::endl;
+    std::cout << "Gravado em " << vocab_path << " e " << merges_path << std::endl;
+    return 0;
+}